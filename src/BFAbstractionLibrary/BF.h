@@ -23,6 +23,7 @@
 
 #include "BFCuddInlines.h"
 #include "BFCuddMintermEnumerator.h"
+#include "BFBitVector.h"
 
 #undef fail
 
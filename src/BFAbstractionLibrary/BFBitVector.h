@@ -0,0 +1,118 @@
+/*
+ * BFBitVector.h
+ *
+ * Unsigned integers represented as vectors of Boolean functions, one for each bit (least significant
+ * bit first). An empty vector represents the number 0. The arithmetic operations compute the exact
+ * result, so the number of bits of the result is large enough to hold every possible value.
+ */
+
+#ifndef BFBITVECTOR_H_
+#define BFBITVECTOR_H_
+
+#include <vector>
+#include <algorithm>
+
+template<class BFType> class BFBitVector {
+private:
+	BFType falseConstant;
+	std::vector<BFType> bits;
+
+public:
+	BFBitVector(const BFType &_falseConstant) : falseConstant(_falseConstant) {}
+	BFBitVector(const BFType &_falseConstant, const std::vector<BFType> &_bits) : falseConstant(_falseConstant), bits(_bits) {}
+
+	/**
+	 * Builds the bit vector of a constant, without leading zeros.
+	 */
+	template<class BFManagerType> static BFBitVector constant(const BFManagerType &mgr, unsigned long value) {
+		BFBitVector result(mgr.constantFalse());
+		for (;value!=0;value = value >> 1) {
+			result.bits.push_back((value & 1) ? mgr.constantTrue() : mgr.constantFalse());
+		}
+		return result;
+	}
+
+	size_t size() const { return bits.size(); }
+	const BFType &operator[](size_t bit) const { return bits[bit]; }
+
+	/**
+	 * The bit with the given index, where all bits beyond the end of the vector are 0.
+	 */
+	const BFType &getBit(size_t bit) const {
+		return (bit<bits.size()) ? bits[bit] : falseConstant;
+	}
+
+	/**
+	 * Ripple-carry addition. The result has one bit more than the longer operand, unless one of the operands has no bits.
+	 */
+	BFBitVector operator+(const BFBitVector &other) const {
+		if (bits.size()==0) return other;
+		if (other.bits.size()==0) return *this;
+		BFBitVector result(falseConstant);
+		BFType carry = falseConstant;
+		for (size_t i=0;i<std::max(bits.size(),other.bits.size());i++) {
+			const BFType &a = getBit(i);
+			const BFType &b = other.getBit(i);
+			result.bits.push_back(a ^ b ^ carry);
+			carry = carry.Ite(a | b, a & b);
+		}
+		result.bits.push_back(carry);
+		return result;
+	}
+
+	/**
+	 * Shift-and-add multiplication.
+	 */
+	BFBitVector operator*(const BFBitVector &other) const {
+		BFBitVector result(falseConstant);
+		for (size_t i=0;i<other.bits.size();i++) {
+			BFBitVector partialProduct(falseConstant,std::vector<BFType>(i,falseConstant));
+			for (size_t j=0;j<bits.size();j++) {
+				partialProduct.bits.push_back(bits[j] & other.bits[i]);
+			}
+			result = result + partialProduct;
+		}
+		return result;
+	}
+
+	/**
+	 * Replaces the least significant bits of "other" by the bits of this vector. This vector must have fewer bits than "other".
+	 */
+	BFBitVector overwriteLeastSignificantBits(const BFBitVector &other) const {
+		BFBitVector result(*this);
+		result.bits.insert(result.bits.end(),other.bits.begin()+std::min(bits.size(),other.bits.size()),other.bits.end());
+		return result;
+	}
+
+	BFType operator==(const BFBitVector &other) const {
+		BFType result = !falseConstant;
+		for (size_t i=0;i<std::max(bits.size(),other.bits.size());i++) {
+			result &= !(getBit(i) ^ other.getBit(i));
+		}
+		return result;
+	}
+
+	BFType operator!=(const BFBitVector &other) const {
+		return !(*this == other);
+	}
+
+	/**
+	 * Comparison starting from the least significant bit, where "equalCase" is the result if both numbers are equal.
+	 */
+	BFType compareLess(const BFBitVector &other, const BFType &equalCase) const {
+		BFType result = equalCase;
+		for (size_t i=0;i<std::max(bits.size(),other.bits.size());i++) {
+			const BFType &a = getBit(i);
+			const BFType &b = other.getBit(i);
+			result = (a ^ b).Ite(b, result);
+		}
+		return result;
+	}
+
+	BFType operator<(const BFBitVector &other) const { return compareLess(other,falseConstant); }
+	BFType operator<=(const BFBitVector &other) const { return compareLess(other,!falseConstant); }
+	BFType operator>(const BFBitVector &other) const { return other.compareLess(*this,falseConstant); }
+	BFType operator>=(const BFBitVector &other) const { return other.compareLess(*this,!falseConstant); }
+};
+
+#endif /* BFBITVECTOR_H_ */
@@ -8,7 +8,11 @@
 #include "BFCudd.h"
 #include "BFCuddVarCube.h"
 #include <map>
+#include <unordered_map>
+#include <mutex>
 #include <limits>
+#include <stdexcept>
+#include <util.h>
 #include <cuddInt.h>
 
 /**
@@ -75,3 +79,375 @@ double BFBdd::getNofSatisfyingAssignments(const BFBddVarCube &_cube) const {
 
 	return recurse_getNofSatisfyingAssignments(mgr,node,cube,buffer);
 }
+
+/**
+ * Computes the indices of the variables that this BDD depends on.
+ * @return The variable indices, in ascending order.
+ */
+std::vector<unsigned int> BFBdd::getSupportIndices() const {
+	int *indices;
+	int nofIndices = Cudd_SupportIndices(mgr, node, &indices);
+	if (nofIndices == CUDD_OUT_OF_MEM)
+		throw std::runtime_error("Error in BFBdd::getSupportIndices() - Out of memory.");
+	std::vector<unsigned int> result(indices, indices + nofIndices);
+	if (nofIndices > 0)
+		free(indices);
+	return result;
+}
+
+/**
+ * Reports that a CUDD operation has returned NULL instead of a BDD, which happens when CUDD runs out of memory
+ * or when the computation has been cancelled (see BFBddManager::setTerminationFlag()).
+ */
+void BFBdd::throwOperationFailure(DdManager *mgr) {
+	switch (Cudd_ReadErrorCode(mgr)) {
+	case CUDD_TERMINATION:
+		throw std::runtime_error("Error in a BDD operation - The computation has been terminated.");
+	case CUDD_TIMEOUT_EXPIRED:
+		throw std::runtime_error("Error in a BDD operation - Timeout expired.");
+	case CUDD_MAX_MEM_EXCEEDED:
+	case CUDD_MEMORY_OUT:
+		throw std::runtime_error("Error in a BDD operation - Out of memory.");
+	default:
+		throw std::runtime_error("Error in a BDD operation - CUDD returned no result.");
+	}
+}
+
+/**
+ * Copies this BDD into another BDD manager. Variables are identified by their indices, so the
+ * target manager must have the same variables (i.e., created in the same order) as the manager of
+ * this BDD. The variable orders of the two managers may differ.
+ *
+ * Every BDD manager may only be used by one thread at a time. BDDs may however be copied between
+ * managers in several threads at the same time, provided that the managers are not used otherwise
+ * in the meantime: the copying locks both managers.
+ * @param target The manager to copy the BDD to
+ * @return The BDD in the target manager.
+ */
+BFBdd BFBdd::transferTo(const BFBddManager &target) const {
+	std::unique_lock<std::mutex> sourceLock(bfmanager->transferMutex, std::defer_lock);
+	std::unique_lock<std::mutex> targetLock(target.transferMutex, std::defer_lock);
+	if (bfmanager == &target)
+		sourceLock.lock();
+	else
+		std::lock(sourceLock, targetLock);
+	DdNode *result = Cudd_bddTransfer(mgr, target.getMgr(), node);
+	if (result == NULL)
+		throwOperationFailure(target.getMgr());
+	return BFBdd(&target, result);
+}
+
+/**
+ * Internal function for BFBdd::transferTo(): copies the BDD with the regular node "node" and stores the
+ * referenced copies of all nodes in "copies". Returns NULL if a variable has no counterpart or CUDD runs out of memory.
+ */
+static DdNode *transferRecur(DdManager *source, DdManager *target, DdNode *node, const std::vector<int> &variableCorrespondence, std::unordered_map<DdNode*, DdNode*> &copies) {
+	if (Cudd_IsConstant(node))
+		return Cudd_ReadOne(target);
+	auto it = copies.find(node);
+	if (it != copies.end())
+		return it->second;
+
+	unsigned int index = Cudd_NodeReadIndex(node);
+	if ((index >= variableCorrespondence.size()) || (variableCorrespondence[index] < 0) || (variableCorrespondence[index] >= Cudd_ReadSize(target)))
+		return NULL;
+	DdNode *thenCase = transferRecur(source, target, Cudd_Regular(cuddT(node)), variableCorrespondence, copies);
+	if (thenCase == NULL)
+		return NULL;
+	thenCase = Cudd_NotCond(thenCase, Cudd_IsComplement(cuddT(node)));
+	DdNode *elseCase = transferRecur(source, target, Cudd_Regular(cuddE(node)), variableCorrespondence, copies);
+	if (elseCase == NULL)
+		return NULL;
+	elseCase = Cudd_NotCond(elseCase, Cudd_IsComplement(cuddE(node)));
+
+	DdNode *result = Cudd_bddIte(target, Cudd_bddIthVar(target, variableCorrespondence[index]), thenCase, elseCase);
+	if (result == NULL)
+		return NULL;
+	Cudd_Ref(result);
+	copies[node] = result;
+	return result;
+}
+
+/**
+ * Copies this BDD into another BDD manager, in which the variables may have different indices. This is needed
+ * whenever the two managers have not been given the same variables in the same order. The variable orders of the
+ * two managers may differ as well. Locking is done in the same way as for the other "transferTo" function, which
+ * is used if the correspondence maps every variable to the variable with the same index.
+ * @param target The manager to copy the BDD to
+ * @param variableCorrespondence For every variable index of the manager of this BDD the index of the same variable
+ *        in the target manager, or -1 if the variable has no counterpart there. The BDD must not depend on such variables.
+ * @return The BDD in the target manager.
+ */
+BFBdd BFBdd::transferTo(const BFBddManager &target, const std::vector<int> &variableCorrespondence) const {
+	bool isIdentity = ((int)variableCorrespondence.size() <= Cudd_ReadSize(target.getMgr()));
+	for (unsigned int i = 0; isIdentity && (i < variableCorrespondence.size()); i++)
+		isIdentity = (variableCorrespondence[i] == (int)i);
+	if (isIdentity)
+		return transferTo(target);
+
+	DdManager *targetMgr = target.getMgr();
+	std::unordered_map<DdNode*, DdNode*> copies;
+	std::unique_lock<std::mutex> sourceLock(bfmanager->transferMutex, std::defer_lock);
+	std::unique_lock<std::mutex> targetLock(target.transferMutex, std::defer_lock);
+	if (bfmanager == &target)
+		sourceLock.lock();
+	else
+		std::lock(sourceLock, targetLock);
+	DdNode *result = transferRecur(mgr, targetMgr, Cudd_Regular(node), variableCorrespondence, copies);
+	if (result != NULL) {
+		result = Cudd_NotCond(result, Cudd_IsComplement(node));
+		Cudd_Ref(result);
+	}
+	for (auto it = copies.begin(); it != copies.end(); it++)
+		Cudd_RecursiveDeref(targetMgr, it->second);
+	if (result == NULL)
+		throw std::runtime_error("Error in BFBdd::transferTo() - Out of memory or a variable without counterpart in the target manager.");
+	BFBdd copy(&target, result);
+	Cudd_RecursiveDeref(targetMgr, result);
+	return copy;
+}
+
+/**
+ * Picks one assignment to the given variables under which this BDD is satisfiable. The variables are assigned in
+ * the order in which they are given, and every variable gets its preferred value unless this would make the BDD
+ * unsatisfiable, given the values of the variables before it. The BDD is walked from its root towards the true
+ * terminal: variables at the top of the remaining BDD are decided by looking at its children, and only the
+ * variables further down in the BDD require a cofactor computation.
+ * @param vars The (distinct) variables to assign, as BDDs for the single variables
+ * @param preferredValues The preferred value of every variable, or NULL if 0 is preferred for all of them
+ * @param valuation Is filled with the values of the variables
+ * @return The conjunction of this BDD with the chosen values of the variables (false if this BDD is false).
+ */
+BFBdd BFBdd::pickMinterm(const std::vector<BFBdd> &vars, const std::vector<bool> *preferredValues, std::vector<bool> &valuation) const {
+	valuation.assign(vars.size(), false);
+	if (isFalse())
+		return *this;
+
+	DdNode *zero = Cudd_Not(Cudd_ReadOne(mgr));
+	DdNode *current = node;
+	Cudd_Ref(current);
+	for (unsigned int i = 0; i < vars.size(); i++) {
+		bool preferredValue = (preferredValues == NULL) ? false : (*preferredValues)[i];
+		unsigned int index = Cudd_NodeReadIndex(vars[i].node);
+		DdNode *regular = Cudd_Regular(current);
+		DdNode *next;
+		if (Cudd_IsConstant(regular) || (cuddI(mgr, index) < cuddI(mgr, regular->index))) {
+			// The remaining BDD does not depend on the variable
+			valuation[i] = preferredValue;
+			continue;
+		} else if (regular->index == index) {
+			DdNode *thenChild = Cudd_NotCond(cuddT(regular), regular != current);
+			DdNode *elseChild = Cudd_NotCond(cuddE(regular), regular != current);
+			next = preferredValue ? thenChild : elseChild;
+			valuation[i] = preferredValue;
+			if (next == zero) {
+				next = preferredValue ? elseChild : thenChild;
+				valuation[i] = !preferredValue;
+			}
+			Cudd_Ref(next);
+		} else {
+			DdNode *literal = Cudd_NotCond(vars[i].node, !preferredValue);
+			next = Cudd_Cofactor(mgr, current, literal);
+			if (next == NULL)
+				throw std::runtime_error("Error in BFBdd::pickMinterm() - Out of memory.");
+			Cudd_Ref(next);
+			valuation[i] = preferredValue;
+			if (next == zero) {
+				Cudd_RecursiveDeref(mgr, next);
+				next = Cudd_Cofactor(mgr, current, Cudd_Not(literal));
+				if (next == NULL)
+					throw std::runtime_error("Error in BFBdd::pickMinterm() - Out of memory.");
+				Cudd_Ref(next);
+				valuation[i] = !preferredValue;
+			}
+		}
+		Cudd_RecursiveDeref(mgr, current);
+		current = next;
+	}
+	Cudd_RecursiveDeref(mgr, current);
+
+	// Conjunct the chosen values with this BDD
+	return *this & bfmanager->computeMinterm(vars, valuation);
+}
+
+/**
+ * Internal function for BFBdd::cox(): computes forall in. exists out. (!env | (sys & target)) with the quantification
+ * functions of CUDD, as forall in. ((exists out. !env) | (exists out. sys & target)).
+ */
+static DdNode *coxByAbstraction(DdManager *dd, DdNode *env, DdNode *sys, DdNode *target, DdNode *outCube, DdNode *inCube) {
+	DdNode *envLoses = cuddBddExistAbstractRecur(dd, Cudd_Not(env), outCube);
+	if (envLoses == NULL)
+		return NULL;
+	cuddRef(envLoses);
+	DdNode *sysWins = cuddBddAndAbstractRecur(dd, sys, target, outCube);
+	if (sysWins == NULL) {
+		Cudd_IterDerefBdd(dd, envLoses);
+		return NULL;
+	}
+	cuddRef(sysWins);
+	DdNode *result = cuddBddAndAbstractRecur(dd, Cudd_Not(envLoses), Cudd_Not(sysWins), inCube);
+	if (result == NULL) {
+		Cudd_IterDerefBdd(dd, envLoses);
+		Cudd_IterDerefBdd(dd, sysWins);
+		return NULL;
+	}
+	cuddRef(result);
+	Cudd_IterDerefBdd(dd, envLoses);
+	Cudd_IterDerefBdd(dd, sysWins);
+	cuddDeref(result);
+	return Cudd_Not(result);
+}
+
+/**
+ * Internal function for BFBdd::cox(): computes the cofactors of a node w.r.t. the variable at the given level
+ */
+static inline void coxCofactors(DdManager *dd, DdNode *node, int level, DdNode *&thenCase, DdNode *&elseCase) {
+	DdNode *regular = Cudd_Regular(node);
+	if (cuddI(dd, regular->index) == level) {
+		thenCase = Cudd_NotCond(cuddT(regular), regular != node);
+		elseCase = Cudd_NotCond(cuddE(regular), regular != node);
+	} else {
+		thenCase = node;
+		elseCase = node;
+	}
+}
+
+/**
+ * Internal function for BFBdd::cox(): the recursive step. Universally quantified and free variables on top are
+ * handled by splitting on them. Once an existentially quantified variable is on top while universally quantified
+ * variables are left, the quantifiers cannot be swapped any more and the rest is handled by coxByAbstraction().
+ * The results are stored in the computed table for the two cubes, with (env,sys,target) as key.
+ */
+static DdNode *coxRecur(DdManager *dd, DdLocalCache *cache, DdNode *env, DdNode *sys, DdNode *target, DdNode *outCube, DdNode *inCube) {
+	statLine(dd);
+	DdNode *one = DD_ONE(dd);
+	DdNode *zero = Cudd_Not(one);
+
+	// Terminal cases
+	if (env == zero)
+		return one;
+	if ((sys == one) || (sys == target)) {
+		sys = target;
+		target = one;
+	}
+	if (sys == one)
+		return one;
+	if ((target != one) && (sys > target)) {
+		DdNode *tmp = sys;
+		sys = target;
+		target = tmp;
+	}
+
+	// Skip the quantified variables above the top variable of the operands
+	int top = cuddI(dd, Cudd_Regular(env)->index);
+	top = ddMin(top, (int)cuddI(dd, Cudd_Regular(sys)->index));
+	top = ddMin(top, (int)cuddI(dd, Cudd_Regular(target)->index));
+	while ((outCube != one) && (cuddI(dd, outCube->index) < top))
+		outCube = cuddT(outCube);
+	while ((inCube != one) && (cuddI(dd, inCube->index) < top))
+		inCube = cuddT(inCube);
+
+	if ((inCube == one) || (sys == zero) || (target == zero) || (sys == Cudd_Not(target))
+			|| ((outCube != one) && (cuddI(dd, outCube->index) == top)))
+		return coxByAbstraction(dd, env, sys, target, outCube, inCube);
+
+	checkWhetherToGiveUp(dd);
+
+	DdNode *key[3] = { env, sys, target };
+	DdNode *result = cuddLocalCacheLookup(cache, key);
+	if (result != NULL)
+		return result;
+
+	DdNode *envT, *envE, *sysT, *sysE, *targetT, *targetE;
+	coxCofactors(dd, env, top, envT, envE);
+	coxCofactors(dd, sys, top, sysT, sysE);
+	coxCofactors(dd, target, top, targetT, targetE);
+	bool universal = cuddI(dd, inCube->index) == top;
+
+	DdNode *t = coxRecur(dd, cache, envT, sysT, targetT, outCube, inCube);
+	if (t == NULL)
+		return NULL;
+	cuddRef(t);
+	if (universal && (t == zero)) {
+		// No need to look at the else-case
+		cuddDeref(t);
+		result = zero;
+	} else {
+		DdNode *e = coxRecur(dd, cache, envE, sysE, targetE, outCube, inCube);
+		if (e == NULL) {
+			Cudd_IterDerefBdd(dd, t);
+			return NULL;
+		}
+		cuddRef(e);
+		if (universal) {
+			result = cuddBddAndRecur(dd, t, e);
+			if (result == NULL) {
+				Cudd_IterDerefBdd(dd, t);
+				Cudd_IterDerefBdd(dd, e);
+				return NULL;
+			}
+			cuddRef(result);
+			Cudd_IterDerefBdd(dd, t);
+			Cudd_IterDerefBdd(dd, e);
+			cuddDeref(result);
+		} else {
+			if (t == e) {
+				result = t;
+			} else if (Cudd_IsComplement(t)) {
+				// The then-child of a node must be regular
+				result = cuddUniqueInter(dd, dd->invperm[top], Cudd_Not(t), Cudd_Not(e));
+				if (result == NULL) {
+					Cudd_IterDerefBdd(dd, t);
+					Cudd_IterDerefBdd(dd, e);
+					return NULL;
+				}
+				result = Cudd_Not(result);
+			} else {
+				result = cuddUniqueInter(dd, dd->invperm[top], t, e);
+				if (result == NULL) {
+					Cudd_IterDerefBdd(dd, t);
+					Cudd_IterDerefBdd(dd, e);
+					return NULL;
+				}
+			}
+			cuddDeref(e);
+			cuddDeref(t);
+		}
+	}
+
+	cuddLocalCacheInsert(cache, key, result);
+	return result;
+}
+
+/**
+ * Computes the controllable predecessor of the GR(1) algorithms, i.e., the BDD for
+ * forall in. exists out. (envRel -> (sysRel & target)), which is the same as
+ * envRel.Implies(sysRel & target).ExistAbstract(outCube).UnivAbstract(inCube), in one traversal. If "envRel" does not
+ * depend on the variables in "outCube", as for the assumptions of a specification, this is also the same as
+ * envRel.Implies((sysRel & target).ExistAbstract(outCube)).UnivAbstract(inCube).
+ * The conjunction and the implication are never built, and the universal quantification does not need the
+ * result of the existential quantification as a whole. This works best if the variables in "inCube" come before
+ * the ones in "outCube" in the variable order, which is the case for the pre- and post-state variables of slugs.
+ * @param envRel The environment transition relation
+ * @param sysRel The system transition relation
+ * @param target The positions or transitions that the system wants to reach
+ * @param outCube The cube of the existentially quantified variables
+ * @param inCube The cube of the universally quantified variables
+ * @return The resulting BDD
+ */
+BFBdd BFBdd::cox(const BFBdd &envRel, const BFBdd &sysRel, const BFBdd &target, const BFBddVarCube &outCube, const BFBddVarCube &inCube) {
+	DdManager *dd = envRel.mgr;
+	DdLocalCache *cache = envRel.bfmanager->getCoxCache(outCube.cube, inCube.cube);
+	if (cache == NULL)
+		throw std::runtime_error("Error in BFBdd::cox() - Out of memory.");
+	DdNode *result;
+	do {
+		dd->reordered = 0;
+		result = coxRecur(dd, cache, envRel.node, sysRel.node, target.node, outCube.cube, inCube.cube);
+	} while (dd->reordered == 1);
+	if ((dd->errorCode == CUDD_TIMEOUT_EXPIRED) && dd->timeoutHandler)
+		dd->timeoutHandler(dd, dd->tohArg);
+	if (result == NULL)
+		throwOperationFailure(dd);
+	return BFBdd(envRel.bfmanager, result);
+}
@@ -13,6 +13,17 @@
 class BFBddManager;
 class BFBddVarCube;
 class BFBddVarVector;
+template<class L, class R> class BFBddAndExpression;
+template<class L, class R> class BFBddOrExpression;
+template<class L, class R> class BFBddXorExpression;
+template<class A> struct BFBddOperandStorage;
+
+// What BFBdd::Implies returns (see "BFCuddExpressions.h")
+#ifdef BF_EAGER_EXPRESSIONS
+template<class B> using BFBddImplication = BFBdd;
+#else
+template<class B> using BFBddImplication = BFBddOrExpression<BFBdd, typename BFBddOperandStorage<B>::type>;
+#endif
 
 class BFBdd {
 private:
@@ -22,9 +33,15 @@ private:
 
 	inline BFBdd(const BFBddManager *_manager, DdNode *_node) :
 		bfmanager(_manager), mgr(_manager->getMgr()), node(_node) {
+		if (node == 0)
+			throwOperationFailure(mgr);
 		Cudd_Ref(node);
+		BF_COUNT_OPERATION(nofReferences);
+		BF_COUNT_OPERATION(nofOperations);
 	}
 
+	static void throwOperationFailure(DdManager *mgr);
+
 public:
 	inline BFBdd() :
 		bfmanager(0), mgr(0), node(0) {
@@ -37,8 +54,10 @@ public:
 
 	inline BFBdd(const BFBdd &bdd) :
 		bfmanager(bdd.bfmanager), mgr(bdd.mgr), node(bdd.node) {
-		if (node != 0)
+		if (node != 0) {
 			Cudd_Ref(node);
+			BF_COUNT_OPERATION(nofReferences);
+		}
 	}
 
     inline BFBdd(BFBdd &&bdd) : bfmanager(bdd.bfmanager), mgr(bdd.mgr), node(bdd.node) {
@@ -77,17 +96,25 @@ public:
 		return node != 0;
 	}
 
-	inline BFBdd operator&=(const BFBdd& other) {
+	inline BFBdd& operator&=(const BFBdd& other) {
 		DdNode *result = Cudd_bddAnd(mgr, node, other.node);
+		if (result == 0)
+			throwOperationFailure(mgr);
 		Cudd_Ref(result);
+		BF_COUNT_OPERATION(nofReferences);
+		BF_COUNT_OPERATION(nofOperations);
 		Cudd_RecursiveDeref(mgr, node);
 		node = result;
 		return *this;
 	}
 
-	inline BFBdd operator|=(const BFBdd& other) {
+	inline BFBdd& operator|=(const BFBdd& other) {
 		DdNode *result = Cudd_bddOr(mgr, node, other.node);
+		if (result == 0)
+			throwOperationFailure(mgr);
 		Cudd_Ref(result);
+		BF_COUNT_OPERATION(nofReferences);
+		BF_COUNT_OPERATION(nofOperations);
 		Cudd_RecursiveDeref(mgr, node);
 		node = result;
 		return *this;
@@ -108,8 +135,10 @@ public:
 		bfmanager = other.bfmanager;
 		mgr = other.mgr;
 		node = other.node;
-		if (node != 0)
+		if (node != 0) {
 			Cudd_Ref(node);
+			BF_COUNT_OPERATION(nofReferences);
+		}
 
 		return *this;
 	}
@@ -136,20 +165,14 @@ public:
 		return BFBdd(bfmanager, Cudd_Not(node));
 	}
 
-	inline BFBdd operator&(const BFBdd& other) const {
-		return BFBdd(bfmanager, Cudd_bddAnd(mgr, node, other.node));
-	}
-
-	inline BFBdd operator|(const BFBdd& other) const {
-		return BFBdd(bfmanager, Cudd_bddOr(mgr, node, other.node));
-	}
+	// The operators "&", "|" and "^" are defined in "BFCuddExpressions.h"
 
 	inline BFBdd operator-(const BFBdd& other) const {
 		return BFBdd(bfmanager, Cudd_bddAnd(mgr, node, Cudd_Not(other.node)));
 	}
 
-	inline BFBdd operator^(const BFBdd& other) const {
-		return BFBdd(bfmanager, Cudd_bddXor(mgr, node, other.node));
+	inline BFBdd Ite(const BFBdd& thenCase, const BFBdd& elseCase) const {
+		return BFBdd(bfmanager, Cudd_bddIte(mgr, node, thenCase.node, elseCase.node));
 	}
 
         inline BFBdd optimizeRestrict(const BFBdd &other) const {
@@ -190,15 +213,57 @@ public:
 		return Cudd_NodeReadIndex(node);
 	}
 	;
+	std::vector<unsigned int> getSupportIndices() const;
+	BFBdd pickMinterm(const std::vector<BFBdd> &vars, const std::vector<bool> *preferredValues, std::vector<bool> &valuation) const;
+
+	/**
+	 * Calls "callback" for every satisfying assignment to the variables in "vars", given as a std::vector<bool>.
+	 * This BDD must not depend on any other variables. The assignments are obtained from the cube iterator of CUDD,
+	 * so the callback must not perform BDD operations.
+	 */
+	template<class Callback> void forEachMinterm(const std::vector<BFBdd> &vars, Callback callback) const {
+		std::vector<int> indices(vars.size());
+		for (unsigned int i = 0; i < vars.size(); i++)
+			indices[i] = Cudd_NodeReadIndex(vars[i].node);
+		std::vector<bool> minterm(vars.size());
+		std::vector<unsigned int> dontCares;
+		DdGen *generator;
+		int *cube;
+		CUDD_VALUE_TYPE value;
+		Cudd_ForeachCube(mgr, node, generator, cube, value) {
+			dontCares.clear();
+			for (unsigned int i = 0; i < vars.size(); i++) {
+				if (cube[indices[i]] == 2)
+					dontCares.push_back(i);
+				minterm[i] = (cube[indices[i]] == 1);
+			}
+			// Enumerate all values of the variables that the cube does not fix
+			while (true) {
+				callback(static_cast<const std::vector<bool>&>(minterm));
+				unsigned int j = 0;
+				while ((j < dontCares.size()) && minterm[dontCares[j]]) {
+					minterm[dontCares[j]] = false;
+					j++;
+				}
+				if (j == dontCares.size())
+					break;
+				minterm[dontCares[j]] = true;
+			}
+		}
+	}
+	BFBdd transferTo(const BFBddManager &target) const;
+	BFBdd transferTo(const BFBddManager &target, const std::vector<int> &variableCorrespondence) const;
 	inline BFBdd SwapVariables(const BFBddVarVector &x, const BFBddVarVector &y) const;
+	inline BFBdd primeToUnprime() const;
+	inline BFBdd unprimeToPrime() const;
 	inline BFBdd AndAbstract(const BFBdd& g, const BFBddVarCube& cube) const;
 	inline BFBdd ExistAbstract(const BFBddVarCube& cube) const;
 	inline BFBdd ExistAbstractSingleVar(const BFBdd& var) const;
 	inline BFBdd UnivAbstract(const BFBddVarCube& cube) const;
         inline BFBdd UnivAbstractSingleVar(const BFBdd& var) const;
-	inline BFBdd Implies(const BFBdd& other) const {
-        return (!(*this)) | other;
-	}
+	inline BFBdd XorExistAbstract(const BFBdd& g, const BFBddVarCube& cube) const;
+	template<class B> inline BFBddImplication<B> Implies(B &&other) const;
+	static BFBdd cox(const BFBdd &envRel, const BFBdd &sysRel, const BFBdd &target, const BFBddVarCube &outCube, const BFBddVarCube &inCube);
 
 	// Not yet supported
 	// BFBdd findSatisfyingAssignment(const BFBddVarCube& cube) const;
@@ -220,6 +285,11 @@ public:
 	friend class BFBddManager;
 	friend class BFBddVarCube;
 	friend class BFBddVarVector;
+	template<class L, class R> friend class BFBddAndExpression;
+	template<class L, class R> friend class BFBddOrExpression;
+	template<class L, class R> friend class BFBddXorExpression;
 };
 
+#include "BFCuddExpressions.h"
+
 #endif /* BFCUDD_H_ */
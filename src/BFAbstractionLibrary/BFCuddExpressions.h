@@ -0,0 +1,371 @@
+/*
+ * BFCuddExpressions.h
+ *
+ * Lazily evaluated conjunctions, disjunctions and exclusive ors of BDDs.
+ *
+ * The binary operators "&", "|" and "^" on BFBdd objects (and on the results of these operators)
+ * do not compute a BDD right away, but return a small expression object that only refers to the
+ * operands. The expression is turned into a BFBdd when it is assigned to a BFBdd or passed to a
+ * function that takes one, and in this case the same CUDD calls as before are made. Some operations
+ * on expressions are however mapped to single CUDD calls that avoid building the intermediate BDD:
+ *
+ * - (f & g).ExistAbstract(c)  --> Cudd_bddAndAbstract
+ * - (f ^ g).ExistAbstract(c)  --> Cudd_bddXorExistAbstract
+ * - (f | g).UnivAbstract(c)   --> !Cudd_bddAndAbstract(!f,!g,c), which includes f.Implies(g).UnivAbstract(c)
+ * - (f | g).ExistAbstract(c)  --> f.ExistAbstract(c) | g.ExistAbstract(c), so that the parts are fused again
+ * - (f & g).isFalse(), (f | g).isTrue() and f.Implies(g).isTrue() --> Cudd_bddLeq, which builds no BDD at all
+ * - (f & g) | (!f & h), with the conjunctions in any operand order --> Cudd_bddIte(f,g,h), which is detected
+ *   when evaluating the disjunction by comparing the nodes of the operands of the conjunctions
+ *
+ * All operands are referenced by the expression, including temporary ones, which live until the end of the
+ * full expression in which the expression is created. Expression objects must therefore not outlive the full
+ * expression. To enforce this, expressions cannot be copied or moved, so that "auto e = a & (b | c);" does
+ * not compile, and they can only be used as rvalues, so that "const auto &e = a & (b | c); BFBdd f = e;" does
+ * not compile either (see the static assertions at the end of this file). Internally, the operands are used
+ * through std::move, as they are stored as lvalue references.
+ *
+ * When compiled with BF_EAGER_EXPRESSIONS, the operators compute their result right away, so that no operations
+ * are fused. Together with BF_COUNT_OPERATIONS (see "BFCuddManager.h"), this allows measuring the effect of the
+ * expressions (see "tools/countBDDOperations.py").
+ */
+
+#ifndef BFCUDDEXPRESSIONS_H_
+#define BFCUDDEXPRESSIONS_H_
+
+#include <type_traits>
+#include <utility>
+
+template<class Derived> class BFBddExpression;
+
+//===================================
+// Operand types
+//===================================
+template<class T> struct BFBddIsOperand : std::false_type {};
+template<> struct BFBddIsOperand<BFBdd> : std::true_type {};
+template<class L, class R> struct BFBddIsOperand<BFBddAndExpression<L,R> > : std::true_type {};
+template<class L, class R> struct BFBddIsOperand<BFBddOrExpression<L,R> > : std::true_type {};
+template<class L, class R> struct BFBddIsOperand<BFBddXorExpression<L,R> > : std::true_type {};
+
+// How an operand passed as "A&&" is stored: always by reference (see above)
+template<class A> struct BFBddOperandStorage { typedef const typename std::decay<A>::type &type; };
+
+template<template<class,class> class Expression, class A, class B> using BFBddOperatorExpression =
+	Expression<typename BFBddOperandStorage<A>::type, typename BFBddOperandStorage<B>::type>;
+
+// What the operators return: the expression, or the BFBdd computed from it if BF_EAGER_EXPRESSIONS is defined
+template<template<class,class> class Expression, class A, class B> using BFBddOperatorResult =
+	typename std::enable_if<BFBddIsOperand<typename std::decay<A>::type>::value && BFBddIsOperand<typename std::decay<B>::type>::value,
+#ifdef BF_EAGER_EXPRESSIONS
+		BFBdd>::type;
+#else
+		BFBddOperatorExpression<Expression,A,B> >::type;
+#endif
+
+inline const BFBdd &bfEvaluate(const BFBdd &bdd) {
+	return bdd;
+}
+
+template<class Derived> inline BFBdd bfEvaluate(const BFBddExpression<Derived> &expression) {
+	return static_cast<const Derived&&>(expression).evaluate();
+}
+
+//===================================
+// Common part of all expressions
+//===================================
+template<class Derived> class BFBddExpression {
+private:
+	const Derived &&derived() const {
+		return static_cast<const Derived&&>(*this);
+	}
+
+protected:
+	BFBddExpression() = default;
+
+public:
+	// Expressions refer to their operands, so they must not be kept beyond the full expression that creates them
+	BFBddExpression(const BFBddExpression &) = delete;
+	BFBddExpression &operator=(const BFBddExpression &) = delete;
+
+	inline operator BFBdd() const && {
+		return derived().evaluate();
+	}
+
+	inline BFBdd operator!() const && {
+		return !derived().evaluate();
+	}
+
+	inline bool isFalse() const && {
+		return derived().evaluate().isFalse();
+	}
+
+	inline bool isTrue() const && {
+		return derived().evaluate().isTrue();
+	}
+
+	inline int operator==(const BFBdd &other) const && {
+		return derived().evaluate() == other;
+	}
+
+	inline int operator!=(const BFBdd &other) const && {
+		return derived().evaluate() != other;
+	}
+
+	inline int operator<=(const BFBdd &other) const && {
+		return derived().evaluate() <= other;
+	}
+
+	inline int operator>=(const BFBdd &other) const && {
+		return derived().evaluate() >= other;
+	}
+
+	inline int operator<(const BFBdd &other) const && {
+		return derived().evaluate() < other;
+	}
+
+	inline int operator>(const BFBdd &other) const && {
+		return derived().evaluate() > other;
+	}
+
+	inline BFBdd operator-(const BFBdd &other) const && {
+		return derived().evaluate() - other;
+	}
+
+	inline BFBdd ExistAbstract(const BFBddVarCube &cube) const && {
+		return derived().evaluate().ExistAbstract(cube);
+	}
+
+	inline BFBdd UnivAbstract(const BFBddVarCube &cube) const && {
+		return derived().evaluate().UnivAbstract(cube);
+	}
+
+	inline BFBdd ExistAbstractSingleVar(const BFBdd &var) const && {
+		return derived().evaluate().ExistAbstractSingleVar(var);
+	}
+
+	inline BFBdd UnivAbstractSingleVar(const BFBdd &var) const && {
+		return derived().evaluate().UnivAbstractSingleVar(var);
+	}
+
+	inline BFBdd AndAbstract(const BFBdd &g, const BFBddVarCube &cube) const && {
+		return derived().evaluate().AndAbstract(g, cube);
+	}
+
+	inline BFBdd Ite(const BFBdd &thenCase, const BFBdd &elseCase) const && {
+		return derived().evaluate().Ite(thenCase, elseCase);
+	}
+
+	inline BFBdd SwapVariables(const BFBddVarVector &x, const BFBddVarVector &y) const && {
+		return derived().evaluate().SwapVariables(x, y);
+	}
+
+	inline BFBdd primeToUnprime() const && {
+		return derived().evaluate().primeToUnprime();
+	}
+
+	inline BFBdd unprimeToPrime() const && {
+		return derived().evaluate().unprimeToPrime();
+	}
+
+	inline double getNofSatisfyingAssignments(const BFBddVarCube &cube) const && {
+		return derived().evaluate().getNofSatisfyingAssignments(cube);
+	}
+
+	inline int getSize() const && {
+		return derived().evaluate().getSize();
+	}
+
+	template<class Callback> inline void forEachMinterm(const std::vector<BFBdd> &vars, Callback callback) const && {
+		derived().evaluate().forEachMinterm(vars, callback);
+	}
+
+	template<class B> inline BFBddOrExpression<BFBdd, typename BFBddOperandStorage<B>::type> Implies(B &&other) const && {
+		return {!derived().evaluate(), std::forward<B>(other)};
+	}
+};
+
+//===================================
+// Conjunction
+//===================================
+template<class L, class R> class BFBddAndExpression : public BFBddExpression<BFBddAndExpression<L,R> > {
+private:
+	L left;
+	R right;
+
+public:
+	template<class A, class B> inline BFBddAndExpression(A &&a, B &&b) : left(std::forward<A>(a)), right(std::forward<B>(b)) {}
+
+	inline const L &getLeft() const && {
+		return left;
+	}
+
+	inline const R &getRight() const && {
+		return right;
+	}
+
+	inline BFBdd evaluate() const && {
+		const BFBdd &l = bfEvaluate(left);
+		const BFBdd &r = bfEvaluate(right);
+		return BFBdd(l.bfmanager, Cudd_bddAnd(l.mgr, l.node, r.node));
+	}
+
+	inline bool isFalse() const && {
+		const BFBdd &l = bfEvaluate(left);
+		const BFBdd &r = bfEvaluate(right);
+		return Cudd_bddLeq(l.mgr, l.node, Cudd_Not(r.node));
+	}
+
+	inline bool isTrue() const && {
+		return std::move(left).isTrue() && std::move(right).isTrue();
+	}
+
+	inline BFBdd ExistAbstract(const BFBddVarCube &cube) const && {
+		return bfEvaluate(left).AndAbstract(bfEvaluate(right), cube);
+	}
+};
+
+//===================================
+// Disjunction
+//===================================
+template<class L, class R> class BFBddOrExpression : public BFBddExpression<BFBddOrExpression<L,R> > {
+private:
+	L left;
+	R right;
+
+	template<class A, class B> static inline BFBdd evaluateDisjunction(const A &a, const B &b) {
+		const BFBdd &l = bfEvaluate(a);
+		const BFBdd &r = bfEvaluate(b);
+		return BFBdd(l.bfmanager, Cudd_bddOr(l.mgr, l.node, r.node));
+	}
+
+	// (f & g) | (!f & h) is computed as Cudd_bddIte(f,g,h), which does not build the two conjunctions. Whether an
+	// operand of the left conjunction is the negation of an operand of the right conjunction is only known for the
+	// evaluated operands, so the check is made at run time.
+	template<class L1, class R1, class L2, class R2> static inline BFBdd evaluateDisjunction(const BFBddAndExpression<L1,R1> &a, const BFBddAndExpression<L2,R2> &b) {
+		const BFBdd &a1 = bfEvaluate(std::move(a).getLeft());
+		const BFBdd &a2 = bfEvaluate(std::move(a).getRight());
+		const BFBdd &b1 = bfEvaluate(std::move(b).getLeft());
+		const BFBdd &b2 = bfEvaluate(std::move(b).getRight());
+		const BFBdd *leftConjuncts[2] = {&a1, &a2};
+		const BFBdd *rightConjuncts[2] = {&b1, &b2};
+		for (int i = 0; i < 2; i++) {
+			for (int j = 0; j < 2; j++) {
+				if (leftConjuncts[i]->node == Cudd_Not(rightConjuncts[j]->node)) {
+					return BFBdd(a1.bfmanager, Cudd_bddIte(a1.mgr, leftConjuncts[i]->node, leftConjuncts[1-i]->node, rightConjuncts[1-j]->node));
+				}
+			}
+		}
+		const BFBdd l = BFBdd(a1.bfmanager, Cudd_bddAnd(a1.mgr, a1.node, a2.node));
+		const BFBdd r = BFBdd(b1.bfmanager, Cudd_bddAnd(b1.mgr, b1.node, b2.node));
+		return BFBdd(l.bfmanager, Cudd_bddOr(l.mgr, l.node, r.node));
+	}
+
+public:
+	template<class A, class B> inline BFBddOrExpression(A &&a, B &&b) : left(std::forward<A>(a)), right(std::forward<B>(b)) {}
+
+	inline BFBdd evaluate() const && {
+		return evaluateDisjunction(left, right);
+	}
+
+	inline bool isFalse() const && {
+		return std::move(left).isFalse() && std::move(right).isFalse();
+	}
+
+	inline bool isTrue() const && {
+		const BFBdd &l = bfEvaluate(left);
+		const BFBdd &r = bfEvaluate(right);
+		return Cudd_bddLeq(l.mgr, Cudd_Not(l.node), r.node);
+	}
+
+	inline BFBdd ExistAbstract(const BFBddVarCube &cube) const && {
+		const BFBdd l = std::move(left).ExistAbstract(cube);
+		const BFBdd r = std::move(right).ExistAbstract(cube);
+		return BFBdd(l.bfmanager, Cudd_bddOr(l.mgr, l.node, r.node));
+	}
+
+	inline BFBdd UnivAbstract(const BFBddVarCube &cube) const && {
+		return !((!bfEvaluate(left)).AndAbstract(!bfEvaluate(right), cube));
+	}
+};
+
+//===================================
+// Exclusive or
+//===================================
+template<class L, class R> class BFBddXorExpression : public BFBddExpression<BFBddXorExpression<L,R> > {
+private:
+	L left;
+	R right;
+
+public:
+	template<class A, class B> inline BFBddXorExpression(A &&a, B &&b) : left(std::forward<A>(a)), right(std::forward<B>(b)) {}
+
+	inline BFBdd evaluate() const && {
+		const BFBdd &l = bfEvaluate(left);
+		const BFBdd &r = bfEvaluate(right);
+		return BFBdd(l.bfmanager, Cudd_bddXor(l.mgr, l.node, r.node));
+	}
+
+	inline bool isFalse() const && {
+		return bfEvaluate(left) == bfEvaluate(right);
+	}
+
+	inline bool isTrue() const && {
+		return bfEvaluate(left) == !bfEvaluate(right);
+	}
+
+	inline BFBdd ExistAbstract(const BFBddVarCube &cube) const && {
+		return bfEvaluate(left).XorExistAbstract(bfEvaluate(right), cube);
+	}
+
+	inline BFBdd UnivAbstract(const BFBddVarCube &cube) const && {
+		return !(bfEvaluate(left).XorExistAbstract(!bfEvaluate(right), cube));
+	}
+};
+
+//===================================
+// Operators
+//===================================
+#ifdef BF_EAGER_EXPRESSIONS
+template<class A, class B> inline BFBddOperatorResult<BFBddAndExpression,A,B> operator&(A &&a, B &&b) {
+	return BFBddOperatorExpression<BFBddAndExpression,A,B>(std::forward<A>(a), std::forward<B>(b));
+}
+
+template<class A, class B> inline BFBddOperatorResult<BFBddOrExpression,A,B> operator|(A &&a, B &&b) {
+	return BFBddOperatorExpression<BFBddOrExpression,A,B>(std::forward<A>(a), std::forward<B>(b));
+}
+
+template<class A, class B> inline BFBddOperatorResult<BFBddXorExpression,A,B> operator^(A &&a, B &&b) {
+	return BFBddOperatorExpression<BFBddXorExpression,A,B>(std::forward<A>(a), std::forward<B>(b));
+}
+
+template<class B> inline BFBddImplication<B> BFBdd::Implies(B &&other) const {
+	return BFBddOrExpression<BFBdd, typename BFBddOperandStorage<B>::type>(!(*this), std::forward<B>(other));
+}
+#else
+template<class A, class B> inline BFBddOperatorResult<BFBddAndExpression,A,B> operator&(A &&a, B &&b) {
+	return {std::forward<A>(a), std::forward<B>(b)};
+}
+
+template<class A, class B> inline BFBddOperatorResult<BFBddOrExpression,A,B> operator|(A &&a, B &&b) {
+	return {std::forward<A>(a), std::forward<B>(b)};
+}
+
+template<class A, class B> inline BFBddOperatorResult<BFBddXorExpression,A,B> operator^(A &&a, B &&b) {
+	return {std::forward<A>(a), std::forward<B>(b)};
+}
+
+template<class B> inline BFBddImplication<B> BFBdd::Implies(B &&other) const {
+	return {!(*this), std::forward<B>(other)};
+}
+#endif
+
+//===================================
+// Expressions must only be used as rvalues (see above)
+//===================================
+static_assert(std::is_convertible<BFBddAndExpression<const BFBdd&, const BFBdd&>&&, BFBdd>::value,
+	"BDD expressions must be convertible to BFBdd");
+static_assert(!std::is_convertible<const BFBddAndExpression<const BFBdd&, const BFBdd&>&, BFBdd>::value,
+	"Stored BDD expressions must not be convertible to BFBdd, as their operands may have been destroyed");
+static_assert(!std::is_constructible<BFBddOrExpression<const BFBdd&, const BFBdd&>, BFBddOrExpression<const BFBdd&, const BFBdd&>&&>::value,
+	"BDD expressions must not be copied or moved, as their operands may have been destroyed");
+
+#endif /* BFCUDDEXPRESSIONS_H_ */
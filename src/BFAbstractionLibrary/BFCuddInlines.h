@@ -38,10 +38,31 @@ inline BFBdd BFBdd::SwapVariables(const BFBddVarVector &x, const BFBddVarVector
 	return BFBdd(bfmanager, Cudd_bddSwapVariables(mgr, node, x.nodes, y.nodes, x.nofNodes));
 }
 
+/**
+ * Replaces the primed variables by the unprimed ones of the map registered with BFBddManager::setVariableMap().
+ * As the map swaps the two sets of variables, this is the same operation as unprimeToPrime(), and the two names
+ * only tell the reader in which direction the variables are meant to be renamed. Fails with an exception if no
+ * map is registered (see BFBddManager::clearVariableMap()).
+ */
+inline BFBdd BFBdd::primeToUnprime() const {
+	return BFBdd(bfmanager, Cudd_bddVarMap(mgr, node));
+}
+
+/**
+ * Replaces the unprimed variables by the primed ones of the map registered with BFBddManager::setVariableMap().
+ */
+inline BFBdd BFBdd::unprimeToPrime() const {
+	return BFBdd(bfmanager, Cudd_bddVarMap(mgr, node));
+}
+
 inline BFBdd BFBdd::AndAbstract(const BFBdd& g, const BFBddVarCube& cube) const {
 	return BFBdd(bfmanager, Cudd_bddAndAbstract(mgr, node, g.node, cube.cube));
 }
 
+inline BFBdd BFBdd::XorExistAbstract(const BFBdd& g, const BFBddVarCube& cube) const {
+	return BFBdd(bfmanager, Cudd_bddXorExistAbstract(mgr, node, g.node, cube.cube));
+}
+
 inline BFBdd BFBdd::ExistAbstract(const BFBddVarCube& cube) const {
 	return BFBdd(bfmanager, Cudd_bddExistAbstract(mgr, node, cube.cube));
 }
@@ -58,30 +79,40 @@ inline BFBdd BFBdd::UnivAbstract(const BFBddVarCube& cube) const {
 	return BFBdd(bfmanager, Cudd_bddUnivAbstract(mgr, node, cube.cube));
 }
 
+/**
+ * @brief Computes the conjunction of a list of BDDs. Neighbouring parts are combined
+ *        pairwise, so that the conjunction is built as a balanced tree rather than as a
+ *        chain whose intermediate results grow with the number of parts already processed.
+ */
 inline BFBdd BFBddManager::multiAnd(const std::vector<BFBdd> &parts) const {
-	DdNode *soFar = Cudd_ReadOne(mgr);
-	Cudd_Ref(soFar);
-	for (std::vector<BFBdd>::const_iterator it = parts.begin(); it != parts.end(); it++) {
-		DdNode *next = Cudd_bddAnd(mgr, soFar, it->node);
-		Cudd_Ref(next);
-		Cudd_RecursiveDeref(mgr, soFar);
-		soFar = next;
+	if (parts.size()==0) return constantTrue();
+	std::vector<BFBdd> level(parts);
+	while (level.size()>1) {
+		size_t nofCombined = 0;
+		for (size_t i=0;i+1<level.size();i+=2) {
+			level[nofCombined++] = level[i] & level[i+1];
+		}
+		if (level.size() & 1) level[nofCombined++] = level.back();
+		level.resize(nofCombined);
 	}
-	Cudd_Deref(soFar);
-	return BFBdd(this, soFar);
+	return level[0];
 }
 
+/**
+ * @brief Computes the disjunction of a list of BDDs as a balanced tree - see multiAnd.
+ */
 inline BFBdd BFBddManager::multiOr(const std::vector<BFBdd> &parts) const {
-	DdNode *soFar = Cudd_Not(Cudd_ReadOne(mgr));
-	Cudd_Ref(soFar);
-	for (std::vector<BFBdd>::const_iterator it = parts.begin(); it != parts.end(); it++) {
-		DdNode *next = Cudd_bddOr(mgr, soFar, it->node);
-		Cudd_Ref(next);
-		Cudd_RecursiveDeref(mgr, soFar);
-		soFar = next;
+	if (parts.size()==0) return constantFalse();
+	std::vector<BFBdd> level(parts);
+	while (level.size()>1) {
+		size_t nofCombined = 0;
+		for (size_t i=0;i+1<level.size();i+=2) {
+			level[nofCombined++] = level[i] | level[i+1];
+		}
+		if (level.size() & 1) level[nofCombined++] = level.back();
+		level.resize(nofCombined);
 	}
-	Cudd_Deref(soFar);
-	return BFBdd(this, soFar);
+	return level[0];
 }
 
 
@@ -5,33 +5,61 @@
  *      Author: ehlers
  */
 
+#include "mtr.h" // Must come before "cudd.h" so that the variable group functions are declared
 #include "BF.h"
 #include <set>
 #include <limits>
 #include <stdexcept>
 #include <sstream>
 #include "dddmp.h"
-#include "mtr.h"
+#include <cuddInt.h>
+
+/**
+ * The configuration used for BDD managers that are created without giving one explicitly.
+ */
+BFBddManagerConfiguration BFBddManager::defaultConfiguration;
+
+#ifdef BF_COUNT_OPERATIONS
+std::atomic<unsigned long long> BFBddManager::nofReferences(0);
+std::atomic<unsigned long long> BFBddManager::nofOperations(0);
+
+/**
+ * Writes the operation counts to stderr when the program ends
+ */
+static struct BFBddOperationCountPrinter {
+	~BFBddOperationCountPrinter() {
+		std::cerr << "BF operation counts: " << BFBddManager::nofReferences << " references, " << BFBddManager::nofOperations << " operations\n";
+	}
+} operationCountPrinter;
+#endif
 
 /**
  * Creates a new BDDManager.
  *
- * @param maxMemoryInMB The amount of memory to be used. Must be <4096 as CUDD does not support more
- * @param reorderingMaxBlowup The maximal allowed blowup during sifting steps in the reordering algorithm. Standard is 1.2 - use 1.1 to have less reordering done. A value of 1.0 results in greedy reordering.
+ * @param configuration The sizes of the CUDD tables, the memory limit, and the dynamic reordering settings to be used
  * @author ehlers
  */
-BFBddManager::BFBddManager(unsigned int maxMemoryInMB, float reorderingMaxBlowup) {
+BFBddManager::BFBddManager(const BFBddManagerConfiguration &configuration) {
 
-	mgr = Cudd_Init(0, 0, CUDD_UNIQUE_SLOTS, CUDD_CACHE_SLOTS, (long) maxMemoryInMB * 1024UL * 1024UL);
+	mgr = Cudd_Init(0, 0, configuration.uniqueSlots, configuration.cacheSlots, configuration.maxMemoryInMB * 1024UL * 1024UL);
+	if (mgr == NULL)
+		throw std::runtime_error("Error in BFBddManager::BFBddManager() - Cannot initialize CUDD.");
 
 	// Configuring the manager
-	Cudd_AutodynEnable(mgr, CUDD_REORDER_SIFT);
-	Cudd_SetMaxGrowth(mgr, reorderingMaxBlowup);
-	Cudd_SetMinHit(mgr, 1);
+	if (configuration.maxCacheSlots > 0)
+		Cudd_SetMaxCacheHard(mgr, configuration.maxCacheSlots);
+	if (configuration.looseUpTo > 0)
+		Cudd_SetLooseUpTo(mgr, configuration.looseUpTo);
+	Cudd_AutodynEnable(mgr, configuration.reorderingMethod);
+	if (configuration.reorderingThreshold > 0)
+		Cudd_SetNextReordering(mgr, configuration.reorderingThreshold);
+	Cudd_SetMaxGrowth(mgr, configuration.reorderingMaxBlowup);
+	Cudd_SetMinHit(mgr, configuration.minHit);
 	setAutomaticOptimisation(true);
 }
 
 BFBddManager::~BFBddManager() {
+	freeCoxCaches();
 	int nofLeft = Cudd_CheckZeroRef(mgr);
 	if (nofLeft != 0) {
 		std::cerr << "Warning: " << nofLeft << " referenced nodes in the BDD manager left on destruction!\n";
@@ -40,13 +68,96 @@ BFBddManager::~BFBddManager() {
 }
 
 /**
- * A function for switching automatic BDD optimisation (variable reordering) on and off
+ * Returns the computed table that BFBdd::cox() uses for the given pair of cubes. The tables are kept
+ * between the calls, so that the fixed point computations, which call BFBdd::cox() with the same cubes
+ * in every iteration, can reuse results. CUDD removes the entries for dead nodes from them during
+ * garbage collection and clears them on variable reordering. The cubes are referenced as long as their
+ * table exists, so that their nodes are not recycled for other cubes.
+ *
+ * @param outCube The cube of the existentially quantified variables
+ * @param inCube The cube of the universally quantified variables
+ * @return The computed table, or NULL if CUDD is out of memory.
+ */
+DdLocalCache *BFBddManager::getCoxCache(DdNode *outCube, DdNode *inCube) const {
+	std::pair<DdNode*, DdNode*> key(outCube, inCube);
+	auto it = coxCaches.find(key);
+	if (it != coxCaches.end())
+		return it->second;
+
+	// Cubes that are computed on the fly would otherwise let the number of tables grow without bound
+	if (coxCaches.size() >= 16)
+		freeCoxCaches();
+
+	DdLocalCache *cache = cuddLocalCacheInit(mgr, 3, 2, Cudd_ReadMaxCacheHard(mgr));
+	if (cache == NULL)
+		return NULL;
+	Cudd_Ref(outCube);
+	Cudd_Ref(inCube);
+	coxCaches[key] = cache;
+	return cache;
+}
+
+/**
+ * Frees the computed tables of BFBdd::cox() and dereferences their cubes.
+ */
+void BFBddManager::freeCoxCaches() const {
+	for (auto it = coxCaches.begin(); it != coxCaches.end(); it++) {
+		cuddLocalCacheQuit(it->second);
+		Cudd_RecursiveDeref(mgr, it->first.first);
+		Cudd_RecursiveDeref(mgr, it->first.second);
+	}
+	coxCaches.clear();
+}
+
+/**
+ * Registers the map used by BFBdd::primeToUnprime() and BFBdd::unprimeToPrime(). Both functions swap the i-th
+ * variable of "unprimed" with the i-th variable of "primed". CUDD keeps the results of these functions in its
+ * computed table across calls, but has only one map per manager, and replacing the map flushes the whole computed
+ * table. Registering the same map again therefore does nothing.
+ *
+ * @param unprimed The variables to be swapped with the ones in "primed"
+ * @param primed The variables to be swapped with the ones in "unprimed"; must have the same size as "unprimed"
+ */
+void BFBddManager::setVariableMap(const BFBddVarVector &unprimed, const BFBddVarVector &primed) {
+	if (unprimed.nofNodes != primed.nofNodes)
+		throw std::runtime_error("Error in BFBddManager::setVariableMap() - The variable vectors have different sizes.");
+	std::vector<unsigned int> newMap;
+	for (int i = 0; i < unprimed.nofNodes; i++) {
+		newMap.push_back(Cudd_NodeReadIndex(unprimed.nodes[i]));
+		newMap.push_back(Cudd_NodeReadIndex(primed.nodes[i]));
+	}
+	if ((newMap == variableMap) && !variableMap.empty())
+		return;
+	if (!Cudd_SetVarMap(mgr, unprimed.nodes, primed.nodes, unprimed.nofNodes))
+		throw std::runtime_error("Error in BFBddManager::setVariableMap() - Out of memory.");
+	variableMap = newMap;
+}
+
+/**
+ * Removes the map registered with setVariableMap(). Afterwards, BFBdd::primeToUnprime() and BFBdd::unprimeToPrime()
+ * fail with an exception until a new map is registered, rather than renaming the variables with an outdated map.
+ */
+void BFBddManager::clearVariableMap() {
+	if (mgr->map != NULL) {
+		FREE(mgr->map);
+		mgr->map = NULL;
+		cuddCacheFlush(mgr);
+	}
+	variableMap.clear();
+}
+
+/**
+ * A function for switching automatic BDD optimisation (variable reordering) on and off.
+ * It always stays off if the reordering method of the manager is CUDD_REORDER_NONE, as CUDD would otherwise
+ * keep on triggering reorderings that do nothing.
  *
  * @param enable Whether automatic optimisation should be enabled or not
  * @author ehlers
  */
 void BFBddManager::setAutomaticOptimisation(bool enable) {
-	if (enable)
+	Cudd_ReorderingType method;
+	Cudd_ReorderingStatus(mgr, &method);
+	if (enable && (method != CUDD_REORDER_NONE))
 		Cudd_AutodynEnable(mgr, CUDD_REORDER_SAME);
 	else
 		Cudd_AutodynDisable(mgr);
@@ -60,6 +171,39 @@ void BFBddManager::setReorderingMaxBlowup(float reorderingMaxBlowup) {
     Cudd_SetMaxGrowth(mgr, reorderingMaxBlowup);
 }
 
+/**
+ * @brief Changes the method used for dynamic variable reordering. Automatic reordering is enabled, unless
+ *        the method is CUDD_REORDER_NONE, in which case it is disabled (as in the constructor).
+ * @param method The reordering method, where CUDD_REORDER_NONE means that no reordering takes place
+ */
+void BFBddManager::setReorderingMethod(Cudd_ReorderingType method) {
+	// Also store CUDD_REORDER_NONE as the method so that "setAutomaticOptimisation" does not enable reordering again
+	Cudd_AutodynEnable(mgr, method);
+	if (method == CUDD_REORDER_NONE)
+		Cudd_AutodynDisable(mgr);
+}
+
+/**
+ * Internal function for BFBddManager::setTerminationFlag(): the CUDD termination callback
+ */
+static int readTerminationFlag(const void *flag) {
+	return static_cast<const std::atomic<bool>*>(flag)->load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Lets the BDD operations of this manager be cancelled from another thread. Once the flag is set, CUDD aborts
+ *        the next BDD operation that takes long enough to check the flag, which then throws a std::runtime_error
+ *        (see BFBdd::throwOperationFailure()). BDDs can still be freed afterwards.
+ * @param flag The flag to be checked by CUDD every now and then, or NULL if the operations are not to be cancelled
+ */
+void BFBddManager::setTerminationFlag(const std::atomic<bool> *flag) {
+	terminationFlag = flag;
+	if (flag == NULL)
+		Cudd_UnregisterTerminationCallback(mgr);
+	else
+		Cudd_RegisterTerminationCallback(mgr, readTerminationFlag, const_cast<std::atomic<bool>*>(flag));
+}
+
 /**
  * Some statistics printing function
  */
@@ -68,31 +212,125 @@ void BFBddManager::printStats() {
 }
 
 /**
- * Groups some variables such that they "stick" together during the reordering process.
- *  --> Not currently supported due to a change in the CUDD API - the makeTreeNode function is no longer available
- * @param which The variables that should be grouped. They must have not been allocated a non-grouped variable in between the allocation of two grouped variables.
+ * Returns the current variable order.
+ * @return The indices of the variables, from the top-most level to the bottom-most level.
+ */
+std::vector<unsigned int> BFBddManager::getVariableOrder() const {
+	std::vector<unsigned int> order;
+	int nofVars = Cudd_ReadSize(mgr);
+	for (int level = 0; level < nofVars; level++) {
+		order.push_back(Cudd_ReadInvPerm(mgr, level));
+	}
+	return order;
+}
+
+/**
+ * Changes the variable order. Existing BDDs remain valid.
+ * @param order The indices of the variables that shall be at the top-most levels, in the order in which they should appear.
+ *        All other variables are put below them, keeping their relative order. Variable groups are removed.
+ */
+void BFBddManager::setVariableOrder(const std::vector<unsigned int> &order) {
+	Cudd_FreeTree(mgr);
+	int nofVars = Cudd_ReadSize(mgr);
+	std::vector<bool> used(nofVars, false);
+	std::vector<int> permutation;
+	for (auto it = order.begin(); it != order.end(); it++) {
+		if ((*it >= (unsigned int) nofVars) || used[*it])
+			throw std::runtime_error("Error in BFBddManager::setVariableOrder() - Invalid variable order.");
+		used[*it] = true;
+		permutation.push_back(*it);
+	}
+	for (int level = 0; level < nofVars; level++) {
+		int index = Cudd_ReadInvPerm(mgr, level);
+		if (!used[index])
+			permutation.push_back(index);
+	}
+	if (nofVars > 0 && !Cudd_ShuffleHeap(mgr, &(permutation[0])))
+		throw std::runtime_error("Error in BFBddManager::setVariableOrder() - Out of memory.");
+}
+
+/**
+ * Returns the number of BDD nodes that are currently in use (i.e., not dead).
+ */
+long BFBddManager::getNofLiveNodes() const {
+	return Cudd_ReadNodeCount(mgr);
+}
+
+/**
+ * Returns the maximal number of BDD nodes (including dead ones) that have been allocated at the same time so far.
  */
-/*void BFBddManager::groupVariables(const std::vector<BFBdd> &which) {
+long BFBddManager::getPeakNofNodes() const {
+	return Cudd_ReadPeakNodeCount(mgr);
+}
+
+/**
+ * Returns the fraction of lookups in the computed table that have been hits so far.
+ */
+double BFBddManager::getCacheHitRate() const {
+	double lookUps = Cudd_ReadCacheLookUps(mgr);
+	if (lookUps == 0)
+		return 0;
+	return Cudd_ReadCacheHits(mgr) / lookUps;
+}
+
+/**
+ * Returns how often the variables have been reordered so far.
+ */
+unsigned int BFBddManager::getNofReorderings() const {
+	return Cudd_ReadReorderings(mgr);
+}
+
+/**
+ * Returns the time spent on reordering the variables so far (in seconds).
+ */
+double BFBddManager::getReorderingTime() const {
+	return Cudd_ReadReorderingTime(mgr) / 1000.0;
+}
+
+/**
+ * Groups some variables such that they "stick" together during the reordering process. Groups can be nested.
+ * If automatic optimisation is enabled and uses plain sifting, it is switched to group sifting.
+ * @param which The variables that should be grouped. They must currently be at consecutive levels.
+ * @return false if the variables are not at consecutive levels (nothing is grouped then), true otherwise
+ */
+bool BFBddManager::groupVariables(const std::vector<BFBdd> &which) {
+	if (which.size() == 0)
+		return false;
 
 	// Only allow continuous variables to be grouped.
-	std::set<DdHalfWord> indices;
-	DdHalfWord min = std::numeric_limits<DdHalfWord>::max();
-	DdHalfWord max = std::numeric_limits<DdHalfWord>::min();
+	std::set<int> levels;
+	int minLevel = std::numeric_limits<int>::max();
+	int maxLevel = std::numeric_limits<int>::min();
+	DdHalfWord minIndex = 0;
 	for (unsigned int i = 0; i < which.size(); i++) {
-		DdNode *node = which[i].node;
-		DdHalfWord index = ((Cudd_Regular(node))->index);
-		if (index < min)
-			min = index;
-		if (index > max)
-			max = index;
-		indices.insert(index);
+		DdHalfWord index = Cudd_NodeReadIndex(which[i].node);
+		int level = Cudd_ReadPerm(mgr, index);
+		if (level < minLevel) {
+			minLevel = level;
+			minIndex = index;
+		}
+		if (level > maxLevel)
+			maxLevel = level;
+		levels.insert(level);
 	}
 
-	if ((unsigned int) (max - min + 1) != indices.size())
-		throw std::runtime_error("Error in BFBddManager::groupVariables(const std::vector<BFBdd> &which) - Can only group continuous variables!\n");
+	if ((unsigned int) (maxLevel - minLevel + 1) != levels.size())
+		return false;
 
-	Cudd_MakeTreeNode(mgr, min, max - min + 1, MTR_DEFAULT);
-}*/
+	if (Cudd_MakeTreeNode(mgr, minIndex, maxLevel - minLevel + 1, MTR_DEFAULT) == NULL)
+		throw std::runtime_error("Error in BFBddManager::groupVariables(const std::vector<BFBdd> &which) - Cannot create the variable group!");
+	Cudd_ReorderingType method;
+	if (Cudd_ReorderingStatus(mgr, &method) && (method == CUDD_REORDER_SIFT))
+		Cudd_AutodynEnable(mgr, CUDD_REORDER_GROUP_SIFT);
+	return true;
+}
+
+/**
+ * Removes all variable groups.
+ */
+void BFBddManager::ungroupVariables() {
+	Cudd_FreeTree(mgr);
+}
 
 BFBddVarCube BFBddManager::computeCube(const BFBdd *vars, const int * phase, int n) const {
 	DdNode **vars2 = new DdNode*[n];
@@ -118,6 +356,22 @@ BFBddVarCube BFBddManager::computeCube(const std::vector<BFBdd> &vars) const {
 	return cubic;
 }
 
+/**
+ * Computes the conjunction of the given variables, each of which is negated if its value is false.
+ */
+BFBdd BFBddManager::computeMinterm(const std::vector<BFBdd> &vars, const std::vector<bool> &values) const {
+	std::vector<DdNode*> varNodes(vars.size());
+	std::vector<int> phases(vars.size());
+	for (unsigned int i = 0; i < vars.size(); i++) {
+		varNodes[i] = vars[i].node;
+		phases[i] = values[i] ? 1 : 0;
+	}
+	DdNode *minterm = Cudd_bddComputeCube(mgr, varNodes.data(), phases.data(), vars.size());
+	if (minterm == NULL)
+		throw std::runtime_error("Error in BFBddManager::computeMinterm() - Out of memory.");
+	return BFBdd(this, minterm);
+}
+
 BFBddVarVector BFBddManager::computeVarVector(const std::vector<BFBdd> &from) const {
 	BFBddVarVector v;
 	v.nodes = new DdNode*[from.size()];
@@ -192,3 +446,47 @@ void BFBddManager::writeBDDToFile(const char *filename, std::string fileprefix,
 
 }
 
+/**
+ * Writes a list of BDDs in the binary DDDMP format to an already opened file, starting at the current position.
+ * The variables are stored by their CUDD index.
+ */
+void BFBddManager::writeBDDsToFile(FILE *file, const std::vector<BFBdd> &bdds) const {
+
+    std::vector<DdNode*> roots(bdds.size());
+    for (unsigned int i=0;i<bdds.size();i++) {
+        roots[i] = bdds[i].getCuddNode();
+    }
+
+    int storeReturnValue = Dddmp_cuddBddArrayStore(mgr, NULL, roots.size(), roots.data(), NULL, NULL, NULL, DDDMP_MODE_BINARY, DDDMP_VARIDS, NULL, file);
+    if (storeReturnValue!=DDDMP_SUCCESS) throw std::runtime_error("Error in BFBddManager::writeBDDsToFile(FILE *file, const std::vector<BFBdd> &bdds) - Unable to write the BDDs.");
+}
+
+/**
+ * Reads a list of BDDs written by writeBDDsToFile from the current position of an already opened file.
+ *
+ * @param vars The variables to be used for the variables in the file - vars[i] replaces the variable that had the CUDD index i when writing the file
+ */
+std::vector<BFBdd> BFBddManager::readBDDsFromFile(FILE *file, const std::vector<BFBdd> &vars) const {
+
+    std::vector<int> idMatcher(std::max<size_t>(vars.size(),Cudd_ReadSize(mgr)),0);
+    for (unsigned int i=0;i<vars.size();i++) {
+        idMatcher[i] = vars[i].readNodeIndex();
+    }
+
+    // DDDMP's binary loader (unlike its text loader) dereferences the constant node once at the end without having
+    // referenced it, so it is referenced here in advance to keep the reference count balanced. The constant node is
+    // never freed, so the extra reference left over by a load that fails early does no harm.
+    Cudd_Ref(Cudd_ReadOne(mgr));
+    DdNode **roots = NULL;
+    int nofRoots = Dddmp_cuddBddArrayLoad(mgr, DDDMP_ROOT_MATCHLIST, NULL, DDDMP_VAR_COMPOSEIDS, NULL, NULL, idMatcher.data(), DDDMP_MODE_BINARY, NULL, file, &roots);
+    if ((nofRoots<=0) || (roots==NULL)) throw std::runtime_error("Error in BFBddManager::readBDDsFromFile(FILE *file, const std::vector<BFBdd> &vars) - Unable to read the BDDs.");
+
+    std::vector<BFBdd> result;
+    for (int i=0;i<nofRoots;i++) {
+        result.push_back(BFBdd(this,roots[i]));
+        Cudd_RecursiveDeref(mgr,roots[i]);
+    }
+    free(roots);
+    return result;
+}
+
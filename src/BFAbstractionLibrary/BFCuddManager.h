@@ -13,6 +13,9 @@
 #include <boost/utility.hpp>
 #include <iostream>
 #include <list>
+#include <map>
+#include <mutex>
+#include <atomic>
 #include <cstdio>
 #include <cstdlib>
 
@@ -21,24 +24,77 @@
 class BFBdd;
 class BFBddVarCube;
 class BFBddVarVector;
+struct DdLocalCache;
+
+/**
+ * Settings for the CUDD manager underlying a BFBddManager. A value of 0 lets CUDD choose the respective setting.
+ */
+struct BFBddManagerConfiguration {
+	size_t maxMemoryInMB = 3096; // Also determines CUDD's limits for the cache size and for the fast growth of the unique table
+	unsigned int uniqueSlots = CUDD_UNIQUE_SLOTS; // Initial number of slots per unique subtable
+	unsigned int cacheSlots = CUDD_CACHE_SLOTS; // Initial number of slots in the computed table
+	unsigned int maxCacheSlots = 0; // Number of slots up to which the computed table may grow
+	unsigned int minHit = 1; // Hit rate (in percent) above which the computed table is grown
+	unsigned int looseUpTo = 0; // Number of unique table slots up to which the table grows instead of collecting garbage
+	Cudd_ReorderingType reorderingMethod = CUDD_REORDER_SIFT;
+	unsigned int reorderingThreshold = 0; // Number of nodes at which the first dynamic reordering happens
+	float reorderingMaxBlowup = 1.2f; // Standard is 1.2 - use 1.1 to have less reordering done. A value of 1.0 results in greedy reordering.
+};
 
 class BFBddManager: boost::noncopyable {
 private:
 	DdManager *mgr;
+	mutable std::map<std::pair<DdNode*, DdNode*>, DdLocalCache*> coxCaches; // Computed tables of BFBdd::cox(), by output and input cube
+
+	std::vector<unsigned int> variableMap; // The variable indices registered with setVariableMap(), in pairs
+	mutable std::mutex transferMutex; // Held while BDDs are copied from or to this manager by BFBdd::transferTo()
+	const std::atomic<bool> *terminationFlag = NULL; // The flag registered with setTerminationFlag()
+
+	DdLocalCache *getCoxCache(DdNode *outCube, DdNode *inCube) const;
+	void freeCoxCaches() const;
 
 public:
-	BFBddManager(unsigned int maxMemoryInMB = 3096, float reorderingMaxBlowup = 1.2f);
+	static BFBddManagerConfiguration defaultConfiguration;
+
+#ifdef BF_COUNT_OPERATIONS
+	// For measuring the effect of changes to the BF library (see "tools/countBDDOperations.py"): the calls to Cudd_Ref
+	// made by BFBdd objects, and the BFBdd objects created for the result of a CUDD call, over all managers. The counts
+	// are written to stderr when the program ends.
+	static std::atomic<unsigned long long> nofReferences;
+	static std::atomic<unsigned long long> nofOperations;
+#define BF_COUNT_OPERATION(counter) BFBddManager::counter.fetch_add(1, std::memory_order_relaxed)
+#else
+#define BF_COUNT_OPERATION(counter)
+#endif
+
+	BFBddManager(const BFBddManagerConfiguration &configuration = defaultConfiguration);
 	~BFBddManager();
 
 	void setAutomaticOptimisation(bool enable);
     void setReorderingMaxBlowup(float reorderingMaxBlowup);
+	void setReorderingMethod(Cudd_ReorderingType method);
+	void setTerminationFlag(const std::atomic<bool> *flag);
+	const std::atomic<bool> *getTerminationFlag() const { return terminationFlag; }
 	BFBddVarCube computeCube(const BFBdd * vars, const int * phase, int n) const;
 	BFBddVarCube computeCube(const std::vector<BFBdd> &vars) const;
+	BFBdd computeMinterm(const std::vector<BFBdd> &vars, const std::vector<bool> &values) const;
 	BFBddVarVector computeVarVector(const std::vector<BFBdd> &vars) const;
+	void setVariableMap(const BFBddVarVector &unprimed, const BFBddVarVector &primed);
+	void clearVariableMap();
     BFBdd readBDDFromFile(const char *filename, std::vector<BFBdd> &vars) const;
     void writeBDDToFile(const char *filename, std::string fileprefix, BFBdd bdd, std::vector<BFBdd> &vars, std::vector<std::string> variableNames) const;
-	//void groupVariables(const std::vector<BFBdd> &which);
+    void writeBDDsToFile(FILE *file, const std::vector<BFBdd> &bdds) const;
+    std::vector<BFBdd> readBDDsFromFile(FILE *file, const std::vector<BFBdd> &vars) const;
+	bool groupVariables(const std::vector<BFBdd> &which);
+	void ungroupVariables();
 	void printStats();
+	std::vector<unsigned int> getVariableOrder() const;
+	void setVariableOrder(const std::vector<unsigned int> &order);
+	long getNofLiveNodes() const;
+	long getPeakNofNodes() const;
+	double getCacheHitRate() const;
+	unsigned int getNofReorderings() const;
+	double getReorderingTime() const;
 
 	inline BFBdd constantTrue() const;
 	inline BFBdd constantFalse() const;
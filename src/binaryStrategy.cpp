@@ -0,0 +1,226 @@
+//=====================================================================
+// Writing and reading binary explicit-state strategy files
+//=====================================================================
+#include "binaryStrategy.hpp"
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * @brief Creates a writer without states
+ * @param _variableNames the names of the variables in the valuations of the states, in bit order
+ * @param _nofGoals the number of goals that the states can have
+ */
+BinaryStrategyWriter::BinaryStrategyWriter(std::vector<std::string> const &_variableNames, unsigned int _nofGoals) :
+    variableNames(_variableNames), nofWordsPerState((_variableNames.size()+63)/64), nofGoals(_nofGoals), successorOffsets(1,0) {}
+
+/**
+ * @brief Adds the next state. All subsequent calls to "addSuccessor" (up to the next call to "addState") add
+ *        successors to this state.
+ */
+void BinaryStrategyWriter::addState(std::vector<bool> const &valuation, unsigned int goal) {
+    if (goals.size()>0) successorOffsets.push_back(successors.size());
+    size_t offset = valuations.size();
+    valuations.resize(offset+nofWordsPerState,0);
+    for (unsigned int i=0;i<valuation.size();i++) {
+        if (valuation[i]) valuations[offset+i/64] |= ((uint64_t)1) << (i%64);
+    }
+    goals.push_back(goal);
+}
+
+/**
+ * @brief Writes the collected states as a binary strategy file
+ */
+void BinaryStrategyWriter::write(std::ostream &out) {
+    uint64_t nofStates = goals.size();
+    std::vector<uint64_t> offsets(successorOffsets);
+    if (nofStates>0) offsets.push_back(successors.size());
+
+    // Build the index, with at least twice as many slots as there are states
+    uint64_t nofIndexSlots = 1;
+    while (nofIndexSlots<2*nofStates) nofIndexSlots *= 2;
+    std::vector<uint32_t> index(nofIndexSlots,0);
+    for (uint64_t state=0;state<nofStates;state++) {
+        uint64_t slot = computeBinaryStrategyHash(valuations.data()+state*nofWordsPerState,nofWordsPerState,goals[state]) & (nofIndexSlots-1);
+        while (index[slot]!=0) slot = (slot+1) & (nofIndexSlots-1);
+        index[slot] = state+1;
+    }
+
+    std::string names;
+    for (auto it = variableNames.begin();it!=variableNames.end();it++) {
+        names += *it;
+        names += '\0';
+    }
+
+    auto align = [](uint64_t offset) { return (offset+7) & ~((uint64_t)7); };
+    BinaryStrategyHeader header;
+    memset(&header,0,sizeof(header));
+    memcpy(header.magic,BINARY_STRATEGY_MAGIC,8);
+    header.version = BINARY_STRATEGY_VERSION;
+    header.byteOrderMark = BINARY_STRATEGY_BYTE_ORDER_MARK;
+    header.nofVariables = variableNames.size();
+    header.nofWordsPerState = nofWordsPerState;
+    header.nofGoals = nofGoals;
+    header.nofStates = nofStates;
+    header.nofTransitions = successors.size();
+    header.nofIndexSlots = nofIndexSlots;
+    header.variableNamesOffset = sizeof(header);
+    header.valuationsOffset = align(header.variableNamesOffset+names.size());
+    header.goalsOffset = header.valuationsOffset+valuations.size()*sizeof(uint64_t);
+    header.successorOffsetsOffset = align(header.goalsOffset+goals.size()*sizeof(uint32_t));
+    header.successorsOffset = header.successorOffsetsOffset+offsets.size()*sizeof(uint64_t);
+    header.indexOffset = align(header.successorsOffset+successors.size()*sizeof(uint32_t));
+    header.fileSize = header.indexOffset+index.size()*sizeof(uint32_t);
+
+    // Write the parts, padding each of them with zeros to the offset of the next one
+    uint64_t position = 0;
+    auto writePart = [&out,&position](uint64_t offset, const void *data, size_t length) {
+        static const char zeros[8] = {0,0,0,0,0,0,0,0};
+        out.write(zeros,offset-position);
+        out.write((const char*)data,length);
+        position = offset+length;
+    };
+    writePart(0,&header,sizeof(header));
+    writePart(header.variableNamesOffset,names.data(),names.size());
+    writePart(header.valuationsOffset,valuations.data(),valuations.size()*sizeof(uint64_t));
+    writePart(header.goalsOffset,goals.data(),goals.size()*sizeof(uint32_t));
+    writePart(header.successorOffsetsOffset,offsets.data(),offsets.size()*sizeof(uint64_t));
+    writePart(header.successorsOffset,successors.data(),successors.size()*sizeof(uint32_t));
+    writePart(header.indexOffset,index.data(),index.size()*sizeof(uint32_t));
+    out.flush();
+}
+
+/**
+ * @brief Maps a binary strategy file into memory and checks its header
+ */
+BinaryStrategyReader::BinaryStrategyReader(std::string const &filename) : data(NULL), size(0) {
+    int fd = open(filename.c_str(),O_RDONLY);
+    if (fd<0) throw std::runtime_error("Could not open the binary strategy file '"+filename+"'.");
+    struct stat fileStatus;
+    if (fstat(fd,&fileStatus)!=0) {
+        close(fd);
+        throw std::runtime_error("Could not determine the size of the binary strategy file '"+filename+"'.");
+    }
+    size = fileStatus.st_size;
+    if (size<sizeof(BinaryStrategyHeader)) {
+        close(fd);
+        throw std::runtime_error("The file '"+filename+"' is too short to be a binary strategy file.");
+    }
+    data = mmap(NULL,size,PROT_READ,MAP_SHARED,fd,0);
+    close(fd);
+    if (data==MAP_FAILED) {
+        data = NULL;
+        throw std::runtime_error("Could not map the binary strategy file '"+filename+"' into memory.");
+    }
+
+    const char *base = (const char*)data;
+    header = (const BinaryStrategyHeader*)base;
+    const char *error = NULL;
+    if (memcmp(header->magic,BINARY_STRATEGY_MAGIC,8)!=0) {
+        error = "is not a binary strategy file";
+    } else if (header->byteOrderMark!=BINARY_STRATEGY_BYTE_ORDER_MARK) {
+        error = "has been written on a machine with a different byte order";
+    } else if (header->version!=BINARY_STRATEGY_VERSION) {
+        error = "has an unsupported format version";
+    } else if ((header->fileSize!=size) || !checkLayout()) {
+        error = "is truncated or corrupted";
+    }
+    if (error!=NULL) {
+        munmap(data,size);
+        data = NULL;
+        throw std::runtime_error("The file '"+filename+"' "+error+".");
+    }
+}
+
+/**
+ * @brief Checks that all parts of the file lie within the file, and that all state numbers and successor offsets
+ *        in the file are in range, so that none of the accessor functions can read outside of the mapped file for
+ *        states and variables in range. Sets the pointers to the parts of the file.
+ * @return false if the file is inconsistent
+ */
+bool BinaryStrategyReader::checkLayout() {
+    const char *base = (const char*)data;
+
+    // Is an array of "count" elements of "elementSize" bytes at "offset" completely within the file?
+    auto isInFile = [this](uint64_t offset, uint64_t count, uint64_t elementSize) {
+        if ((offset%8!=0) || (offset>size)) return false;
+        return count<=(size-offset)/elementSize;
+    };
+
+    // Parts
+    if (header->nofWordsPerState!=(header->nofVariables+63)/64) return false;
+    if (header->nofStates>=UINT32_MAX) return false;
+    if (header->valuationsOffset<header->variableNamesOffset) return false;
+    if (!isInFile(header->variableNamesOffset,header->valuationsOffset-header->variableNamesOffset,1)) return false;
+    if ((header->nofWordsPerState>0) && (header->nofStates>(size/sizeof(uint64_t))/header->nofWordsPerState)) return false;
+    if (!isInFile(header->valuationsOffset,header->nofStates*header->nofWordsPerState,sizeof(uint64_t))) return false;
+    if (!isInFile(header->goalsOffset,header->nofStates,sizeof(uint32_t))) return false;
+    if (!isInFile(header->successorOffsetsOffset,header->nofStates+1,sizeof(uint64_t))) return false;
+    if (!isInFile(header->successorsOffset,header->nofTransitions,sizeof(uint32_t))) return false;
+    if (!isInFile(header->indexOffset,header->nofIndexSlots,sizeof(uint32_t))) return false;
+    if ((header->nofIndexSlots==0) || ((header->nofIndexSlots & (header->nofIndexSlots-1))!=0)) return false;
+
+    // Variable names - each of them must be terminated within the name table
+    const char *name = base+header->variableNamesOffset;
+    const char *endOfNames = base+header->valuationsOffset;
+    variableNames.clear();
+    for (unsigned int i=0;i<header->nofVariables;i++) {
+        const char *endOfName = (const char*)memchr(name,0,endOfNames-name);
+        if (endOfName==NULL) return false;
+        variableNames.push_back(name);
+        name = endOfName+1;
+    }
+
+    valuations = (const uint64_t*)(base+header->valuationsOffset);
+    goals = (const uint32_t*)(base+header->goalsOffset);
+    successorOffsets = (const uint64_t*)(base+header->successorOffsetsOffset);
+    successors = (const uint32_t*)(base+header->successorsOffset);
+    index = (const uint32_t*)(base+header->indexOffset);
+
+    // Contents
+    if ((successorOffsets[0]!=0) || (successorOffsets[header->nofStates]!=header->nofTransitions)) return false;
+    for (uint64_t state=0;state<header->nofStates;state++) {
+        if (successorOffsets[state]>successorOffsets[state+1]) return false;
+        if (goals[state]>=header->nofGoals) return false;
+    }
+    for (uint64_t i=0;i<header->nofTransitions;i++) {
+        if (successors[i]>=header->nofStates) return false;
+    }
+    bool hasFreeSlot = false; // Otherwise, looking up a state that does not exist would not terminate
+    for (uint64_t slot=0;slot<header->nofIndexSlots;slot++) {
+        if (index[slot]>header->nofStates) return false;
+        if (index[slot]==0) hasFreeSlot = true;
+    }
+    return hasFreeSlot;
+}
+
+BinaryStrategyReader::~BinaryStrategyReader() {
+    if (data!=NULL) munmap(data,size);
+}
+
+/**
+ * @brief Looks up a state using the index of the file
+ * @param valuation the values of the variables in the state
+ * @param goal the goal of the state
+ * @return the number of the state, or -1 if there is no such state
+ */
+int64_t BinaryStrategyReader::findState(std::vector<bool> const &valuation, unsigned int goal) const {
+    std::vector<uint64_t> packed(header->nofWordsPerState,0);
+    for (unsigned int i=0;(i<valuation.size()) && (i<header->nofVariables);i++) {
+        if (valuation[i]) packed[i/64] |= ((uint64_t)1) << (i%64);
+    }
+    if (header->nofIndexSlots==0) return -1;
+    uint64_t mask = header->nofIndexSlots-1;
+    uint64_t slot = computeBinaryStrategyHash(packed.data(),header->nofWordsPerState,goal) & mask;
+    while (index[slot]!=0) {
+        uint64_t state = index[slot]-1;
+        if ((goals[state]==goal) && (memcmp(packed.data(),valuations+state*header->nofWordsPerState,header->nofWordsPerState*sizeof(uint64_t))==0)) {
+            return state;
+        }
+        slot = (slot+1) & mask;
+    }
+    return -1;
+}
@@ -0,0 +1,134 @@
+#ifndef __BINARY_STRATEGY_HPP__
+#define __BINARY_STRATEGY_HPP__
+
+//=====================================================================
+// Binary explicit-state strategy files
+//
+// -> Written by "slugs --explicitStrategy --binaryStrategy" and by
+//    "tools/convertExplicitStrategyToBinary.py". The file can be mapped
+//    into memory as a whole, and all parts of it are found via the
+//    offsets in the header. All numbers are stored in the byte order of
+//    the machine that has written the file, which is recorded in
+//    "byteOrderMark". All parts start at offsets that are multiples of 8.
+// -> The parts are:
+//    - the header (see "BinaryStrategyHeader")
+//    - the names of the variables, each terminated by a 0 character
+//    - the state table: "nofWordsPerState" 64-bit words per state, where
+//      bit i of the valuation is bit (i%64) of word (i/64)
+//    - the goals of the states, one 32-bit number per state
+//    - the successor offsets: "nofStates+1" 64-bit numbers, where the
+//      successors of state i are the entries "successorOffsets[i]" up to
+//      (excluding) "successorOffsets[i+1]" of the successor array
+//    - the successor array, with one 32-bit state number per transition
+//    - the index: "nofIndexSlots" 32-bit numbers (a power of two), which
+//      are 0 for free slots and state numbers plus one otherwise. A state
+//      with valuation v and goal g is found by starting at slot
+//      "computeBinaryStrategyHash(v,g) % nofIndexSlots" and going forward
+//      (cyclically) until the state or a free slot has been found.
+//=====================================================================
+
+#include <cstdint>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#define BINARY_STRATEGY_MAGIC "SLUGSBST"
+#define BINARY_STRATEGY_VERSION 1
+#define BINARY_STRATEGY_BYTE_ORDER_MARK 0x01020304
+
+struct BinaryStrategyHeader {
+    char magic[8]; //!< "SLUGSBST"
+    uint32_t version;
+    uint32_t byteOrderMark; //!< 0x01020304
+    uint32_t nofVariables;
+    uint32_t nofWordsPerState;
+    uint32_t nofGoals;
+    uint32_t reserved;
+    uint64_t nofStates;
+    uint64_t nofTransitions;
+    uint64_t nofIndexSlots;
+    uint64_t variableNamesOffset;
+    uint64_t valuationsOffset;
+    uint64_t goalsOffset;
+    uint64_t successorOffsetsOffset;
+    uint64_t successorsOffset;
+    uint64_t indexOffset;
+    uint64_t fileSize;
+};
+
+/**
+ * @brief The hash function of the index: FNV-1a over the 64-bit words of the valuation and the goal
+ */
+inline uint64_t computeBinaryStrategyHash(const uint64_t *valuation, uint32_t nofWords, uint32_t goal) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (uint32_t i=0;i<nofWords;i++) {
+        hash = (hash ^ valuation[i]) * 1099511628211ULL;
+    }
+    return (hash ^ goal) * 1099511628211ULL;
+}
+
+/**
+ * @brief Collects the states of an explicit-state strategy, in the order of their numbers, and writes them as a
+ *        binary strategy file.
+ */
+class BinaryStrategyWriter {
+private:
+    std::vector<std::string> variableNames;
+    uint32_t nofWordsPerState;
+    uint32_t nofGoals;
+    std::vector<uint64_t> valuations;
+    std::vector<uint32_t> goals;
+    std::vector<uint64_t> successorOffsets;
+    std::vector<uint32_t> successors;
+public:
+    BinaryStrategyWriter(std::vector<std::string> const &_variableNames, unsigned int _nofGoals);
+    void addState(std::vector<bool> const &valuation, unsigned int goal);
+    void addSuccessor(unsigned int state) { successors.push_back(state); }
+    void write(std::ostream &out);
+};
+
+/**
+ * @brief Reads a binary strategy file by mapping it into memory. Throws a std::runtime_error if the file cannot
+ *        be read, is not a binary strategy file, or is inconsistent. All offsets, lengths and state numbers in the
+ *        file are checked when opening it, so the accessor functions only need the states and variables passed to
+ *        them to be in range.
+ */
+class BinaryStrategyReader {
+private:
+    void *data;
+    size_t size;
+    const BinaryStrategyHeader *header;
+    std::vector<const char*> variableNames;
+    const uint64_t *valuations;
+    const uint32_t *goals;
+    const uint64_t *successorOffsets;
+    const uint32_t *successors;
+    const uint32_t *index;
+
+    bool checkLayout();
+
+    BinaryStrategyReader(const BinaryStrategyReader &) = delete;
+    BinaryStrategyReader &operator=(const BinaryStrategyReader &) = delete;
+
+public:
+    BinaryStrategyReader(std::string const &filename);
+    ~BinaryStrategyReader();
+
+    unsigned int getNofVariables() const { return header->nofVariables; }
+    const char *getVariableName(unsigned int variable) const { return variableNames[variable]; }
+    unsigned int getNofGoals() const { return header->nofGoals; }
+    uint64_t getNofStates() const { return header->nofStates; }
+    uint64_t getNofTransitions() const { return header->nofTransitions; }
+
+    bool getBit(uint64_t state, unsigned int variable) const {
+        return (valuations[state*header->nofWordsPerState+variable/64] >> (variable%64)) & 1;
+    }
+    unsigned int getGoal(uint64_t state) const { return goals[state]; }
+    uint64_t getNofSuccessors(uint64_t state) const { return successorOffsets[state+1]-successorOffsets[state]; }
+    const uint32_t *getSuccessors(uint64_t state) const { return successors+successorOffsets[state]; }
+
+    int64_t findState(std::vector<bool> const &valuation, unsigned int goal) const;
+};
+
+#endif
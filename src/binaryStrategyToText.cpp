@@ -0,0 +1,45 @@
+//=====================================================================
+// Prints a binary explicit-state strategy file (see "binaryStrategy.hpp")
+// in the text format of "slugs --explicitStrategy", so that the two can
+// be compared. Also checks that every state is found via the index of
+// the file.
+//=====================================================================
+#include "binaryStrategy.hpp"
+#include <iostream>
+#include <stdexcept>
+
+int main(int argc, const char **args) {
+    if (argc!=2) {
+        std::cerr << "Usage: binaryStrategyToText <binary strategy file>\n";
+        return 1;
+    }
+
+    try {
+        BinaryStrategyReader reader(args[1]);
+        std::vector<bool> valuation(reader.getNofVariables());
+        for (uint64_t state=0;state<reader.getNofStates();state++) {
+            std::cout << "State " << state << " with rank " << reader.getGoal(state) << " -> <";
+            for (unsigned int i=0;i<reader.getNofVariables();i++) {
+                valuation[i] = reader.getBit(state,i);
+                if (i>0) std::cout << ", ";
+                std::cout << reader.getVariableName(i) << ":" << (valuation[i]?"1":"0");
+            }
+            std::cout << ">\n\tWith successors : ";
+            const uint32_t *successors = reader.getSuccessors(state);
+            for (uint64_t i=0;i<reader.getNofSuccessors(state);i++) {
+                if (i>0) std::cout << ", ";
+                std::cout << successors[i];
+            }
+            std::cout << "\n";
+
+            if (reader.findState(valuation,reader.getGoal(state))!=(int64_t)state) {
+                std::cerr << "Error: State " << state << " is not found via the index of the file.\n";
+                return 1;
+            }
+        }
+    } catch (const std::runtime_error &e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
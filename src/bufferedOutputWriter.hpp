@@ -0,0 +1,70 @@
+#ifndef __BUFFERED_OUTPUT_WRITER_HPP__
+#define __BUFFERED_OUTPUT_WRITER_HPP__
+
+#include <ostream>
+#include <string>
+#include <vector>
+#include <cstring>
+
+/**
+ * @brief Collects text in a large buffer and writes it to an output stream in chunks of the size of the buffer.
+ *        Used for printing explicit-state strategies, which consist of many small pieces of text. Numbers are
+ *        formatted directly, without the locale handling of the iostream library. The remaining text is written
+ *        to the stream when calling "flush" or when the writer is destroyed.
+ */
+class BufferedOutputWriter {
+private:
+    std::ostream &out;
+    std::vector<char> buffer;
+    size_t fill;
+
+    void write(const char *text, size_t length) {
+        if (fill+length>buffer.size()) {
+            flush();
+            if (length>buffer.size()) {
+                out.write(text,length);
+                return;
+            }
+        }
+        memcpy(buffer.data()+fill,text,length);
+        fill += length;
+    }
+
+public:
+    BufferedOutputWriter(std::ostream &_out, size_t bufferSize = 1 << 20) : out(_out), buffer(bufferSize), fill(0) {}
+    ~BufferedOutputWriter() { flush(); }
+
+    void flush() {
+        if (fill>0) out.write(buffer.data(),fill);
+        fill = 0;
+    }
+
+    BufferedOutputWriter &operator<<(const char *text) {
+        write(text,strlen(text));
+        return *this;
+    }
+
+    BufferedOutputWriter &operator<<(std::string const &text) {
+        write(text.data(),text.size());
+        return *this;
+    }
+
+    BufferedOutputWriter &operator<<(char c) {
+        if (fill==buffer.size()) flush();
+        buffer[fill++] = c;
+        return *this;
+    }
+
+    BufferedOutputWriter &operator<<(unsigned int number) {
+        char digits[16];
+        size_t length = 0;
+        do {
+            digits[sizeof(digits)-1-length++] = '0'+(number % 10);
+            number /= 10;
+        } while (number>0);
+        write(digits+sizeof(digits)-length,length);
+        return *this;
+    }
+};
+
+#endif
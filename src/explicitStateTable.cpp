@@ -0,0 +1,92 @@
+//=====================================================================
+// The state table for extracting explicit-state strategies
+//=====================================================================
+#include "explicitStateTable.hpp"
+#include <algorithm>
+
+/**
+ * @brief Creates an empty state table
+ * @param nofBits the number of bits of the valuation of each state
+ */
+ExplicitStateTable::ExplicitStateTable(unsigned int _nofBits) : nofBits(_nofBits), nofWordsPerState((_nofBits+63)/64), hashTable(1024,0), nofProcessedStates(0) {}
+
+/**
+ * @brief FNV-1a hash over the words of a valuation and the goal
+ */
+size_t ExplicitStateTable::computeHash(const uint64_t *valuation, unsigned int goal) const {
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned int i=0;i<nofWordsPerState;i++) {
+        hash = (hash ^ valuation[i]) * 1099511628211ULL;
+    }
+    hash = (hash ^ goal) * 1099511628211ULL;
+    return (size_t)(hash ^ (hash >> 32));
+}
+
+/**
+ * @brief Doubles the size of the hash table - called when it is half full.
+ */
+void ExplicitStateTable::growHashTable() {
+    std::vector<unsigned int> newTable(hashTable.size()*2,0);
+    size_t mask = newTable.size()-1;
+    for (unsigned int state=0;state<goals.size();state++) {
+        size_t slot = computeHash(valuations.data()+state*nofWordsPerState,goals[state]) & mask;
+        while (newTable[slot]!=0) slot = (slot+1) & mask;
+        newTable[slot] = state+1;
+    }
+    hashTable.swap(newTable);
+}
+
+/**
+ * @brief Looks up a state, and adds it if it is not in the table yet
+ * @param valuation the values of the pre-variables in the state
+ * @param goal the goal of the state
+ * @return the number of the state and whether it has been added by this call
+ */
+std::pair<unsigned int,bool> ExplicitStateTable::insert(std::vector<bool> const &valuation, unsigned int goal) {
+    std::vector<uint64_t> packed(nofWordsPerState,0);
+    for (unsigned int i=0;i<valuation.size();i++) {
+        if (valuation[i]) packed[i/64] |= ((uint64_t)1) << (i%64);
+    }
+
+    size_t mask = hashTable.size()-1;
+    size_t slot = computeHash(packed.data(),goal) & mask;
+    while (hashTable[slot]!=0) {
+        unsigned int state = hashTable[slot]-1;
+        if ((goals[state]==goal) && std::equal(packed.begin(),packed.end(),valuations.begin()+state*nofWordsPerState)) {
+            return std::pair<unsigned int,bool>(state,false);
+        }
+        slot = (slot+1) & mask;
+    }
+
+    unsigned int state = goals.size();
+    valuations.insert(valuations.end(),packed.begin(),packed.end());
+    goals.push_back(goal);
+    hashTable[slot] = state+1;
+    if (goals.size()*2>hashTable.size()) growHashTable();
+    return std::pair<unsigned int,bool>(state,true);
+}
+
+/**
+ * @brief Reads the valuation of the pre-variables of a state
+ * @param state the number of the state
+ * @param valuation is filled with the values of the variables
+ */
+void ExplicitStateTable::getValuation(unsigned int state, std::vector<bool> &valuation) const {
+    valuation.resize(nofBits);
+    for (unsigned int i=0;i<valuation.size();i++) {
+        valuation[i] = getBit(state,i);
+    }
+}
+
+/**
+ * @brief Compares the valuations of two states lexicographically, starting with the first variable, where 0 is
+ *        smaller than 1. This is the order in which "GR1Context::determinize" picks valuations.
+ */
+bool ExplicitStateTable::isValuationSmaller(unsigned int state1, unsigned int state2) const {
+    for (unsigned int i=0;i<nofBits;i++) {
+        bool bit1 = getBit(state1,i);
+        bool bit2 = getBit(state2,i);
+        if (bit1!=bit2) return bit2;
+    }
+    return false;
+}
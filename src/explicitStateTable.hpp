@@ -0,0 +1,46 @@
+#ifndef __EXPLICIT_STATE_TABLE_HPP__
+#define __EXPLICIT_STATE_TABLE_HPP__
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+
+/**
+ * @brief The table of states used when extracting explicit-state strategies. A state consists of a valuation of the
+ *        pre-variables, stored as a bit-packed vector, and the index of a goal. States are numbered in the order
+ *        in which they are added, and an open-addressing hash table maps them back to their numbers.
+ *
+ *        As the extraction processes the states in the order in which they are found, the states that have
+ *        been added but not processed yet are exactly those that "getNextUnprocessedState()" has not returned yet,
+ *        so the table also serves as the to-do list.
+ */
+class ExplicitStateTable {
+private:
+    unsigned int nofBits;
+    unsigned int nofWordsPerState;
+    std::vector<uint64_t> valuations; //! The bits of all states, "nofWordsPerState" words each
+    std::vector<unsigned int> goals;
+    std::vector<unsigned int> hashTable; //! State numbers plus one, or 0 for free slots. The size is a power of two.
+    unsigned int nofProcessedStates;
+
+    size_t computeHash(const uint64_t *valuation, unsigned int goal) const;
+    void growHashTable();
+
+public:
+    ExplicitStateTable(unsigned int nofBits);
+
+    std::pair<unsigned int,bool> insert(std::vector<bool> const &valuation, unsigned int goal);
+    unsigned int size() const { return goals.size(); }
+    unsigned int getGoal(unsigned int state) const { return goals[state]; }
+    bool getBit(unsigned int state, unsigned int bit) const {
+        return (valuations[state*nofWordsPerState+bit/64] >> (bit%64)) & 1;
+    }
+    void getValuation(unsigned int state, std::vector<bool> &valuation) const;
+    bool isValuationSmaller(unsigned int state1, unsigned int state2) const;
+
+    bool hasUnprocessedStates() const { return nofProcessedStates<goals.size(); }
+    unsigned int getNextUnprocessedState() { return nofProcessedStates++; }
+};
+
+#endif
@@ -0,0 +1,176 @@
+//=====================================================================
+// Minimization of explicit-state strategies
+//=====================================================================
+#include "explicitStrategyMinimizer.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+/**
+ * @brief A refinable partition of the numbers 0 to n-1, as used in "Fast brief practical DFA minimization" by
+ *        Antti Valmari (Information Processing Letters, 2012). The elements are stored ordered by their sets, so
+ *        that every set is a range of "elements". Elements are marked by moving them to the front of their sets,
+ *        and "split" then makes the marked and unmarked elements of the touched sets separate sets, where the
+ *        smaller part gets the new number.
+ */
+class RefinablePartition {
+public:
+    unsigned int nofSets;
+    std::vector<unsigned int> elements; //! The elements, ordered by their sets
+    std::vector<unsigned int> locations; //! The position of every element in "elements"
+    std::vector<unsigned int> setOfElement;
+    std::vector<unsigned int> first; //! The first position of every set in "elements"
+    std::vector<unsigned int> past; //! The position after the last one of every set in "elements"
+    std::vector<unsigned int> nofMarked;
+    std::vector<unsigned int> touchedSets;
+
+    /**
+     * @brief Creates the partition in which two elements are in the same set if and only if they have the same key
+     */
+    RefinablePartition(std::vector<unsigned int> const &keys) : nofSets(0), elements(keys.size()), locations(keys.size()),
+        setOfElement(keys.size()), first(keys.size()), past(keys.size()), nofMarked(keys.size(),0) {
+        for (unsigned int i=0;i<keys.size();i++) elements[i] = i;
+        std::stable_sort(elements.begin(),elements.end(),[&keys](unsigned int a, unsigned int b) {
+            return keys[a]<keys[b];
+        });
+        for (unsigned int i=0;i<elements.size();i++) {
+            if ((i==0) || (keys[elements[i]]!=keys[elements[i-1]])) {
+                if (i>0) past[nofSets-1] = i;
+                first[nofSets++] = i;
+            }
+            setOfElement[elements[i]] = nofSets-1;
+            locations[elements[i]] = i;
+        }
+        if (nofSets>0) past[nofSets-1] = elements.size();
+    }
+
+    void mark(unsigned int element) {
+        unsigned int set = setOfElement[element];
+        unsigned int i = locations[element];
+        unsigned int j = first[set]+nofMarked[set];
+        elements[i] = elements[j];
+        locations[elements[i]] = i;
+        elements[j] = element;
+        locations[element] = j;
+        if (nofMarked[set]++==0) touchedSets.push_back(set);
+    }
+
+    void split() {
+        while (touchedSets.size()>0) {
+            unsigned int set = touchedSets.back();
+            touchedSets.pop_back();
+            unsigned int j = first[set]+nofMarked[set];
+            if (j==past[set]) {
+                nofMarked[set] = 0;
+                continue;
+            }
+            if (nofMarked[set]<=past[set]-j) {
+                first[nofSets] = first[set];
+                past[nofSets] = first[set] = j;
+            } else {
+                past[nofSets] = past[set];
+                first[nofSets] = past[set] = j;
+            }
+            for (unsigned int i=first[nofSets];i<past[nofSets];i++) setOfElement[elements[i]] = nofSets;
+            nofMarked[set] = nofMarked[nofSets++] = 0;
+        }
+    }
+};
+
+}
+
+/**
+ * @brief Adds the next state. All subsequent calls to "addSuccessor" (up to the next call to "addState") add
+ *        successors to this state.
+ */
+void ExplicitStrategyMinimizer::addState(std::vector<bool> const &valuation, unsigned int goal) {
+    if (states.size()>0) successorOffsets.push_back(successors.size());
+    states.insert(valuation,goal);
+}
+
+/**
+ * @brief Computes the merged states. Must be called once, after all states have been added.
+ */
+void ExplicitStrategyMinimizer::minimize() {
+    unsigned int nofStates = states.size();
+    if (nofStates>0) successorOffsets.push_back(successors.size());
+
+    // Number the valuations of the states
+    std::vector<unsigned int> statesByValuation(nofStates);
+    for (unsigned int i=0;i<nofStates;i++) statesByValuation[i] = i;
+    std::sort(statesByValuation.begin(),statesByValuation.end(),[this](unsigned int a, unsigned int b) {
+        return states.isValuationSmaller(a,b);
+    });
+    std::vector<unsigned int> valuationNumbers(nofStates);
+    unsigned int nofValuations = 0;
+    for (unsigned int i=0;i<nofStates;i++) {
+        if ((i>0) && states.isValuationSmaller(statesByValuation[i-1],statesByValuation[i])) nofValuations++;
+        valuationNumbers[statesByValuation[i]] = nofValuations;
+    }
+
+    // Transitions, with the valuations of their targets as letters
+    unsigned int nofTransitions = successors.size();
+    std::vector<unsigned int> tails(nofTransitions);
+    std::vector<unsigned int> letters(nofTransitions);
+    for (unsigned int state=0;state<nofStates;state++) {
+        for (unsigned int i=successorOffsets[state];i<successorOffsets[state+1];i++) {
+            tails[i] = state;
+            letters[i] = valuationNumbers[successors[i]];
+        }
+    }
+
+    // The incoming transitions of every state
+    std::vector<unsigned int> incomingOffsets(nofStates+1,0);
+    std::vector<unsigned int> incoming(nofTransitions);
+    for (unsigned int i=0;i<nofTransitions;i++) incomingOffsets[successors[i]+1]++;
+    for (unsigned int state=0;state<nofStates;state++) incomingOffsets[state+1] += incomingOffsets[state];
+    {
+        std::vector<unsigned int> fill(incomingOffsets.begin(),incomingOffsets.end()-1);
+        for (unsigned int i=0;i<nofTransitions;i++) incoming[fill[successors[i]]++] = i;
+    }
+
+    // Refine the partition of the states by valuation ("blocks") and the partition of the transitions
+    // by letter ("cords") until the tails of the transitions in every cord and the targets of the transitions
+    // in every block are unions of blocks and cords, respectively. Using all blocks except for the first one of
+    // the initial partition as splitters suffices.
+    RefinablePartition blocks(valuationNumbers);
+    RefinablePartition cords(letters);
+    unsigned int nextBlock = 1;
+    for (unsigned int cord=0;cord<cords.nofSets;cord++) {
+        for (unsigned int i=cords.first[cord];i<cords.past[cord];i++) blocks.mark(tails[cords.elements[i]]);
+        blocks.split();
+        for (;nextBlock<blocks.nofSets;nextBlock++) {
+            for (unsigned int i=blocks.first[nextBlock];i<blocks.past[nextBlock];i++) {
+                unsigned int state = blocks.elements[i];
+                for (unsigned int j=incomingOffsets[state];j<incomingOffsets[state+1];j++) cords.mark(incoming[j]);
+            }
+            cords.split();
+        }
+    }
+
+    // Number the merged states in the order of their first states
+    const unsigned int unnumbered = std::numeric_limits<unsigned int>::max();
+    std::vector<unsigned int> numberOfBlock(blocks.nofSets,unnumbered);
+    blockOfState.resize(nofStates);
+    representatives.clear();
+    for (unsigned int state=0;state<nofStates;state++) {
+        unsigned int block = blocks.setOfElement[state];
+        if (numberOfBlock[block]==unnumbered) {
+            numberOfBlock[block] = representatives.size();
+            representatives.push_back(state);
+        }
+        blockOfState[state] = numberOfBlock[block];
+    }
+}
+
+/**
+ * @brief Computes the successors of a merged state, which are the merged states of the successors of its first state
+ */
+void ExplicitStrategyMinimizer::getSuccessors(unsigned int minimizedState, std::vector<unsigned int> &minimizedSuccessors) const {
+    unsigned int state = representatives[minimizedState];
+    minimizedSuccessors.clear();
+    for (unsigned int i=successorOffsets[state];i<successorOffsets[state+1];i++) {
+        minimizedSuccessors.push_back(blockOfState[successors[i]]);
+    }
+}
@@ -0,0 +1,42 @@
+#ifndef __EXPLICIT_STRATEGY_MINIMIZER_HPP__
+#define __EXPLICIT_STRATEGY_MINIMIZER_HPP__
+
+#include "explicitStateTable.hpp"
+#include <vector>
+
+/**
+ * @brief Collects the states of an explicit-state strategy, in the order of their numbers, and merges the states
+ *        with the same future behavior. Two states are merged if they have the same valuation and, for every
+ *        successor of one of them, the other one has a successor with the same valuation that is merged with it.
+ *        The goals of the states are not taken into account, so states that only differ in their goals can be
+ *        merged.
+ *
+ *        As the successors of a state differ in their input values, the strategy is a deterministic automaton
+ *        with the valuations of the successors as letters, which is minimized with the partition refinement
+ *        algorithm by Valmari and Lehtinen for partial transition functions in O(m log n) time.
+ */
+class ExplicitStrategyMinimizer {
+private:
+    ExplicitStateTable states;
+    std::vector<unsigned int> successorOffsets; //! The successors of state i are at positions successorOffsets[i] to successorOffsets[i+1]
+    std::vector<unsigned int> successors;
+    std::vector<unsigned int> blockOfState; //! The number of the merged state for each state
+    std::vector<unsigned int> representatives; //! The first state of every merged state
+
+public:
+    ExplicitStrategyMinimizer(unsigned int nofBits) : states(nofBits), successorOffsets(1,0) {}
+
+    void addState(std::vector<bool> const &valuation, unsigned int goal);
+    void addSuccessor(unsigned int state) { successors.push_back(state); }
+    void minimize();
+
+    unsigned int getNofStates() const { return states.size(); }
+    unsigned int getNofMinimizedStates() const { return representatives.size(); }
+    unsigned int getGoal(unsigned int minimizedState) const { return states.getGoal(representatives[minimizedState]); }
+    void getValuation(unsigned int minimizedState, std::vector<bool> &valuation) const {
+        states.getValuation(representatives[minimizedState],valuation);
+    }
+    void getSuccessors(unsigned int minimizedState, std::vector<unsigned int> &minimizedSuccessors) const;
+};
+
+#endif
@@ -115,7 +115,7 @@ protected:
             while ((winningPositions!=oldWinningPositions) && (roundFoundInitPos==-1)) {
                 distances.push_back(winningPositions);
                 oldWinningPositions = winningPositions;
-                winningPositions |= (safetyEnv & (winningPositions.SwapVariables(varVectorPre,varVectorPost) | !safetySys).UnivAbstract(varCubePostOutput)).ExistAbstract(varCubePostInput);
+                winningPositions |= (safetyEnv & (winningPositions.unprimeToPrime() | !safetySys).UnivAbstract(varCubePostOutput)).ExistAbstract(varCubePostInput);
                 round++;
                 if ((roundFoundInitPos==-1) &&
                         ((!initSys) | (initEnv & winningPositions)).UnivAbstract(varCubePreOutput).ExistAbstract(varCubePreInput).isTrue()) {
@@ -127,11 +127,11 @@ protected:
             while ((winningPositions!=oldWinningPositions) && (roundFoundInitPos==-1)) {
                 distances.push_back(winningPositions);
                 oldWinningPositions = winningPositions;
-                winningPositions |= (safetyEnv.Implies((safetySys & winningPositions.SwapVariables(varVectorPre,varVectorPost))).ExistAbstract(varCubePostOutput)).UnivAbstract(varCubePostInput);
+                winningPositions |= BF::cox(safetyEnv,safetySys,winningPositions.unprimeToPrime(),varCubePostOutput,varCubePostInput);
                 if (winningPositions.isFalse()) std::cerr << "Still nothing!\n";
                 round++;
                 if ((roundFoundInitPos==-1) &&
-                        initEnv.Implies(initSys & winningPositions).ExistAbstract(varCubePreOutput).UnivAbstract(varCubePreInput).isTrue()) {
+                        BF::cox(initEnv,initSys,winningPositions,varCubePreOutput,varCubePreInput).isTrue()) {
                     roundFoundInitPos = round;
                 }
             }
@@ -184,9 +184,9 @@ protected:
 
                                 BF newPre;
                                 if (environmentShouldWin) {
-                                    newPre = (safetyEnv & (candidatePost.SwapVariables(varVectorPre,varVectorPost) | !safetySys).UnivAbstract(varCubePostOutput)).ExistAbstract(varCubePostInput);
+                                    newPre = (safetyEnv & (candidatePost.unprimeToPrime() | !safetySys).UnivAbstract(varCubePostOutput)).ExistAbstract(varCubePostInput);
                                 } else {
-                                    newPre = (safetyEnv.Implies((safetySys & candidatePost.SwapVariables(varVectorPre,varVectorPost))).ExistAbstract(varCubePostOutput)).UnivAbstract(varCubePostInput);
+                                    newPre = BF::cox(safetyEnv,safetySys,candidatePost.unprimeToPrime(),varCubePostOutput,varCubePostInput);
                                 }
                                 if ((newPre >= candidatePre) && (candidatePost != distances[i])) {
                                     madeChange = true;
@@ -214,7 +214,7 @@ protected:
         // Replace the last element in case of an environment-winning strategy -- we should have the last input here then,
         // provided that it is well-defined.
         if ((distances.size()>1) && (environmentShouldWin)) {
-           distances[0] = determinize(((safetyEnv & !safetySys) | !distances[1]).UnivAbstract(varCubePostOutput).UnivAbstract(varCubePre),postInputVars).SwapVariables(varVectorPre,varVectorPost);
+           distances[0] = determinize(((safetyEnv & !safetySys) | !distances[1]).UnivAbstract(varCubePostOutput).UnivAbstract(varCubePre),postInputVars).primeToUnprime();
         }
 
         // Debugging output
@@ -32,8 +32,8 @@ protected:
     using T::varCubePostOutput;
     using T::varCubePreInput;
     using T::varCubePreOutput;
+    using T::safetyEnvParts;
 
-    std::vector<BF> safetyEnvParts;
     std::vector<std::string> safetyEnvPartNames;
     std::vector<std::string> livenessEnvPartNames;
 
@@ -206,7 +206,7 @@ protected:
 
                 overapproximativeWinningStrategy.push_back(std::vector<BF>());
 
-                 BF livetransitions = livenessGuarantees[j] & (nu2.getValue().SwapVariables(varVectorPre,varVectorPost));
+                 BF livetransitions = livenessGuarantees[j] & (nu2.getValue().unprimeToPrime());
 
                  BFFixedPoint mu1(mgr.constantFalse());
                  int round = 0;
@@ -214,7 +214,7 @@ protected:
                      round++;
 
                      // Update the set of transitions that lead closer to the goal.
-                     livetransitions |= mu1.getValue().SwapVariables(varVectorPre,varVectorPost);
+                     livetransitions |= mu1.getValue().unprimeToPrime();
 
                      // Iterate over the liveness assumptions. Store the positions that are found to be winning for *any*
                      // of them into the variable 'goodForAnyLivenessAssumption'.
@@ -231,11 +231,11 @@ protected:
                          for (;!nu0.isFixedPointReached();) {
 
                              // Compute a set of paths that are safe to take - used for the enforceable predecessor operator ('cox')
-                             foundPaths = livetransitions | (nu0.getValue().SwapVariables(varVectorPre,varVectorPost) & !(livenessAssumptions[i]));
+                             foundPaths = livetransitions | (nu0.getValue().unprimeToPrime() & !(livenessAssumptions[i]));
                              foundPaths &= safetySys;
 
                              // Update the inner-most fixed point with the result of applying the enforcable predecessor operator
-                             nu0.update(safetyEnv.Implies(foundPaths).ExistAbstract(varCubePostOutput).UnivAbstract(varCubePostInput));
+                             nu0.update(BF::cox(safetyEnv,foundPaths,mgr.constantTrue(),varCubePostOutput,varCubePostInput));
                          }
 
                          // Update the set of positions that are winning for some liveness assumption
@@ -260,7 +260,7 @@ protected:
         // Prepare reference distances
         std::vector<std::vector<BF> > referenceDistances;
         BF referenceWinningPositions = computeReactiveDistancesAndWinningPositions(referenceDistances);
-        if (initEnv.Implies((referenceWinningPositions & initSys).ExistAbstract(varCubePreOutput)).UnivAbstract(varCubePreInput).isTrue()) {
+        if (BF::cox(initEnv,initSys,referenceWinningPositions,varCubePreOutput,varCubePreInput).isTrue()) {
             std::cout << "Starting with a realizable specification (in the standard GR(1) semantics).\n\n";
         } else {
             std::cout << "Starting with an unrealizable specification --> Analyzing the assumptions does not make sense.\n";
@@ -291,8 +291,8 @@ protected:
                 BFFixedPoint muInner(transitionPoints);
                 for (;!muInner.isFixedPointReached();) {
                     BF nextTransitions = muInner.getValue() & goalStrategies[i];
-                    transitionPoints |= (nextTransitions & livenessGuarantees[i]).ExistAbstract(varCubePre).SwapVariables(varVectorPre,varVectorPost);
-                    muInner.update(muInner.getValue() | nextTransitions.ExistAbstract(varCubePre).SwapVariables(varVectorPre,varVectorPost));
+                    transitionPoints |= (nextTransitions & livenessGuarantees[i]).ExistAbstract(varCubePre).primeToUnprime();
+                    muInner.update(muInner.getValue() | nextTransitions.ExistAbstract(varCubePre).primeToUnprime());
                 }
                 all |= muInner.getValue();
             }
@@ -316,7 +316,7 @@ protected:
             std::vector<std::vector<BF> > newDistances;
             BF newWinningPositions = computeReactiveDistancesAndWinningPositions(newDistances);
 
-            if (initEnv.Implies((newWinningPositions & initSys).ExistAbstract(varCubePreOutput)).UnivAbstract(varCubePreInput).isTrue()) {
+            if (BF::cox(initEnv,initSys,newWinningPositions,varCubePreOutput,varCubePreInput).isTrue()) {
                 // Not crucially needed
                 if (newWinningPositions < referenceWinningPositions) {
                     if ((newWinningPositions & initEnv) < (referenceWinningPositions & initEnv)) {
@@ -386,7 +386,7 @@ protected:
             std::vector<std::vector<BF> > newDistances;
             BF newWinningPositions = computeReactiveDistancesAndWinningPositions(newDistances);
 
-            if (initEnv.Implies((newWinningPositions & initSys).ExistAbstract(varCubePreOutput)).UnivAbstract(varCubePreInput).isTrue()) {
+            if (BF::cox(initEnv,initSys,newWinningPositions,varCubePreOutput,varCubePreInput).isTrue()) {
                 // Not crucially needed
                 if (newWinningPositions < referenceWinningPositions) {
                     if ((newWinningPositions & initEnv) < (referenceWinningPositions & initEnv)) {
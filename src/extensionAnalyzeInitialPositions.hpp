@@ -194,7 +194,7 @@ public:
             BF oldReachableStates = mgr.constantFalse();
             while (reachableStates!=oldReachableStates) {
                 oldReachableStates = reachableStates;
-                reachableStates |= (reachableStates & combined).ExistAbstract(varCubePre).SwapVariables(varVectorPre,varVectorPost);
+                reachableStates |= (reachableStates & combined).ExistAbstract(varCubePre).primeToUnprime();
             }
             variableLimits &= reachableStates;
         }
@@ -80,7 +80,7 @@ protected:
 
             computeWinningPositions();
 
-            bool isWinningTraditionalSemantics = initEnv.Implies((winningPositions & initSys).ExistAbstract(varCubePreOutput)).UnivAbstract(varCubePreInput).isTrue();
+            bool isWinningTraditionalSemantics = BF::cox(initEnv,initSys,winningPositions,varCubePreOutput,varCubePreInput).isTrue();
             bool isWinningRoboticsSemantics = (initEnv & initSys).Implies(winningPositions).UnivAbstract(varCubePreOutput).UnivAbstract(varCubePreInput).isTrue();
 
             resultsClassicalSemantics.push_back(isWinningTraditionalSemantics);
@@ -117,7 +117,7 @@ protected:
 
             computeWinningPositions();
 
-            bool isWinningTraditionalSemantics = initEnv.Implies((winningPositions & initSys).ExistAbstract(varCubePreOutput)).UnivAbstract(varCubePreInput).isTrue();
+            bool isWinningTraditionalSemantics = BF::cox(initEnv,initSys,winningPositions,varCubePreOutput,varCubePreInput).isTrue();
             bool isWinningRoboticsSemantics = (initEnv & initSys).Implies(winningPositions).UnivAbstract(varCubePreOutput).UnivAbstract(varCubePreInput).isTrue();
 
 
@@ -148,7 +148,7 @@ protected:
             BF oldWinningPositions = !winningPositions;
             while ((winningPositions!=oldWinningPositions) && (roundFoundInitPos==-1)) {
                 oldWinningPositions = winningPositions;
-                winningPositions |= (safetyEnv & (winningPositions.SwapVariables(varVectorPre,varVectorPost) | !safetySys).UnivAbstract(varCubePostOutput)).ExistAbstract(varCubePostInput);
+                winningPositions |= (safetyEnv & (winningPositions.unprimeToPrime() | !safetySys).UnivAbstract(varCubePostOutput)).ExistAbstract(varCubePostInput);
                 round++;
                 if ((roundFoundInitPos==-1) &&
                         ((!initSys) | (initEnv & winningPositions)).UnivAbstract(varCubePreOutput).ExistAbstract(varCubePreInput).isTrue()) {
@@ -176,10 +176,10 @@ protected:
             BF oldWinningPositions = !winningPositions;
             while (winningPositions!=oldWinningPositions) {
                 oldWinningPositions = winningPositions;
-                winningPositions |= (((safetySys & winningPositions.SwapVariables(varVectorPre,varVectorPost)) | (!safetyEnv))).ExistAbstract(varCubePostOutput).UnivAbstract(varCubePostInput);
+                winningPositions |= BF::cox(safetyEnv,safetySys,winningPositions.unprimeToPrime(),varCubePostOutput,varCubePostInput);
                 round++;
                 if ((roundFoundInitPos==-1) &&
-                        initEnv.Implies((winningPositions & initSys).ExistAbstract(varCubePreOutput)).UnivAbstract(varCubePreInput).isTrue()) {
+                        BF::cox(initEnv,initSys,winningPositions,varCubePreOutput,varCubePreInput).isTrue()) {
                     roundFoundInitPos = round;
                 }
             }
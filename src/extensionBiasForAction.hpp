@@ -44,20 +44,20 @@ public:
 
            for (unsigned int j=0;j<livenessGuarantees.size();j++) {
 
-                BF livetransitions = livenessGuarantees[j] & (nu2.getValue().SwapVariables(varVectorPre,varVectorPost));
+                BF livetransitions = livenessGuarantees[j] & (nu2.getValue().unprimeToPrime());
 
                 BFFixedPoint mu1(mgr.constantFalse());
                 for (;!mu1.isFixedPointReached();) {
 
-                    livetransitions |= mu1.getValue().SwapVariables(varVectorPre,varVectorPost);
+                    livetransitions |= mu1.getValue().unprimeToPrime();
 
                     // Added a bias for action here.
                     BFFixedPoint mu1b(mu1.getValue());
                     for (;!mu1b.isFixedPointReached();) {
-                        BF foundPaths = livetransitions | (mu1b.getValue().SwapVariables(varVectorPre,varVectorPost));
+                        BF foundPaths = livetransitions | (mu1b.getValue().unprimeToPrime());
                         foundPaths &= safetySys;
                         strategyDumpingData.push_back(std::pair<unsigned int,BF>(j,foundPaths));
-                        mu1b.update(safetyEnv.Implies(foundPaths).ExistAbstract(varCubePostOutput).UnivAbstract(varCubePostInput));
+                        mu1b.update(BF::cox(safetyEnv,foundPaths,mgr.constantTrue(),varCubePostOutput,varCubePostInput));
                     }
 
                     // Iterate over the liveness assumptions. Store the positions that are found to be winning for *any*
@@ -70,10 +70,10 @@ public:
                         BFFixedPoint nu0(mgr.constantTrue());
                         for (;!nu0.isFixedPointReached();) {
 
-                            foundPaths = livetransitions | (nu0.getValue().SwapVariables(varVectorPre,varVectorPost) & !(livenessAssumptions[i]));
+                            foundPaths = livetransitions | (nu0.getValue().unprimeToPrime() & !(livenessAssumptions[i]));
                             foundPaths &= safetySys;
 
-                            nu0.update(safetyEnv.Implies(foundPaths).ExistAbstract(varCubePostOutput).UnivAbstract(varCubePostInput));
+                            nu0.update(BF::cox(safetyEnv,foundPaths,mgr.constantTrue(),varCubePostOutput,varCubePostInput));
                         }
 
                        goodForAnyLivenessAssumption |= nu0.getValue();
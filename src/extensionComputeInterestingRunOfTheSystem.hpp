@@ -34,6 +34,7 @@ protected:
     using T::variableNames;
     using T::doesVariableInheritType;
     using T::determinizeRandomized;
+    using T::randomGenerator;
 
     BF currentPosition;
 
@@ -74,7 +75,7 @@ public:
         BF nonDeadlockingTransitions;
         while (nonDeadlockingStates!=oldNonDeadlockingStates) {
             oldNonDeadlockingStates = nonDeadlockingStates;
-            nonDeadlockingTransitions = ((nonDeadlockingStates.SwapVariables(varVectorPre,varVectorPost) | !safetySys).UnivAbstract(varCubePostOutput) & safetyEnv);
+            nonDeadlockingTransitions = ((nonDeadlockingStates.unprimeToPrime() | !safetySys).UnivAbstract(varCubePostOutput) & safetyEnv);
             nonDeadlockingStates = nonDeadlockingTransitions.ExistAbstract(varCubePostInput);
         }
         //BF_newDumpDot(*this,nonDeadlockingTransitions,NULL,"/tmp/ndt.dot");
@@ -88,7 +89,7 @@ public:
             BF moves = mgr.constantFalse();
             do {
                 oldWinning = winning;
-                BF newMoves = (((livenessAssumptions[i] | oldWinning.SwapVariables(varVectorPre,varVectorPost)) & nonDeadlockingTransitions) | (!safetySys)).UnivAbstract(varCubePostOutput);
+                BF newMoves = (((livenessAssumptions[i] | oldWinning.unprimeToPrime()) & nonDeadlockingTransitions) | (!safetySys)).UnivAbstract(varCubePostOutput);
                 winning = newMoves.ExistAbstract(varCubePostInput);
                 moves |= winning & !oldWinning & newMoves;
             } while (winning!=oldWinning);
@@ -118,7 +119,7 @@ public:
             BF currentPosition = trace.back();
 
             BF nextPosition = currentPosition & safetyEnv & positionalStrategiesForTheIndividualGoals[systemGoals.back()] & environmentStrategyForAchievingTheLivenessAssumptions[environmentGoals.back()];
-            BF edge = determinizeRandomized(nextPosition,postVars);
+            BF edge = determinizeRandomized(nextPosition,postVars,randomGenerator);
 
             //std::ostringstream edgename;
             //edgename << "/tmp/edge" << i << ".dot";
@@ -154,7 +155,7 @@ public:
 
             // Compute next position
             assert(nextPosition < safetySys);
-            nextPosition = determinizeRandomized(nextPosition.ExistAbstract(varCubePre).SwapVariables(varVectorPre,varVectorPost),preVars);
+            nextPosition = determinizeRandomized(nextPosition.ExistAbstract(varCubePre).primeToUnprime(),preVars,randomGenerator);
             trace.push_back(nextPosition);
 
             //std::ostringstream npname;
@@ -40,7 +40,7 @@ public:
 
         // Compute system transitions that are not environment dead-ends.
         // The system is only allowed to use these.
-        BF nonDeadEndSafetySys = safetySys & safetyEnv.ExistAbstract(varCubePost).SwapVariables(varVectorPre,varVectorPost);
+        BF nonDeadEndSafetySys = safetySys & safetyEnv.ExistAbstract(varCubePost).unprimeToPrime();
         // BF_newDumpDot(*this,nonDeadEndSafetySys,"Pre Post","/tmp/nonDeadEndSys.dot");
         // BF_newDumpDot(*this,safetyEnv.ExistAbstract(varCubePost).SwapVariables(varVectorPre,varVectorPost),"Pre Post","/tmp/notDeadEndSafetyEnv.dot");
 
@@ -74,7 +74,7 @@ public:
                 // Start computing the transitions that lead closer to the goal and lead to a position that is not yet known to be losing.
                 // Start with the ones that actually represent reaching the goal (which is a transition in this implementation as we can have
                 // nexts in the goal descriptions).
-                BF livetransitions = livenessGuarantees[j] & (nu2.getValue().SwapVariables(varVectorPre,varVectorPost));
+                BF livetransitions = livenessGuarantees[j] & (nu2.getValue().unprimeToPrime());
 
                 // Compute the middle least-fixed point (called 'Y' in the GR(1) paper)
                 BFFixedPoint mu1(mgr.constantFalse());
@@ -83,7 +83,7 @@ public:
                     mu1Nr++;
 
                     // Update the set of transitions that lead closer to the goal.
-                    livetransitions |= mu1.getValue().SwapVariables(varVectorPre,varVectorPost);
+                    livetransitions |= mu1.getValue().unprimeToPrime();
 
                     // { std::ostringstream os;
                     // os << "/tmp/livetransitions" << nu2Nr << "-" << j << "-" << mu1Nr << ".dot";
@@ -117,7 +117,7 @@ public:
                             livenessAssumptionProgressPaths.push_back(livetransitions);
                             for (;!muCoop.isFixedPointReached();) {
                                 muCoopNr++;
-                                foundPaths = livetransitions | ((nu0.getValue() & muCoop.getValue()).SwapVariables(varVectorPre,varVectorPost) & !(livenessAssumptions[i]));
+                                foundPaths = livetransitions | ((nu0.getValue() & muCoop.getValue()).unprimeToPrime() & !(livenessAssumptions[i]));
                                 foundPaths &= nonDeadEndSafetySys & safetyEnv;
 
                                 // { std::ostringstream os;
@@ -138,7 +138,7 @@ public:
 
 
                             // Update the inner-most fixed point with the result of applying the enforcable predecessor operator
-                            nu0.update(safetyEnv.Implies(foundPaths).ExistAbstract(varCubePostOutput).UnivAbstract(varCubePostInput));
+                            nu0.update(BF::cox(safetyEnv,foundPaths,mgr.constantTrue(),varCubePostOutput,varCubePostInput));
 
                             // { std::ostringstream os;
                             // os << "/tmp/nu0-" << nu2Nr << "-" << j << "-" << mu1Nr << "-" << i << "-" << nu0Nr << ".dot";
@@ -179,7 +179,7 @@ public:
                 // always enforce to land in a winning state afterwards
                 BFFixedPoint mu1(mgr.constantFalse());
                 unsigned int mu1Nr = 0;
-                BF goodTransitions = currentLivenessAssumption & nonDeadEndSafetySys & nextContraintsForGoals & safetyEnv & nextContraintsForGoals.SwapVariables(varVectorPre,varVectorPost);
+                BF goodTransitions = currentLivenessAssumption & nonDeadEndSafetySys & nextContraintsForGoals & safetyEnv & nextContraintsForGoals.unprimeToPrime();
 
                 for (;!mu1.isFixedPointReached();) {
                     mu1Nr++;
@@ -204,14 +204,14 @@ public:
                     // goodTransition? We cannot offer losing transitions.
 
                     BF winningStates = goodTransitions.ExistAbstract(varCubePost);
-                    goodTransitions |= winningStates.SwapVariables(varVectorPre,varVectorPost) & safetyEnv & nonDeadEndSafetySys & nextContraintsForGoals;
+                    goodTransitions |= winningStates.unprimeToPrime() & safetyEnv & nonDeadEndSafetySys & nextContraintsForGoals;
                     mu1.update(winningStates | mu1.getValue());
                 }
                 nextContraintsForGoals &= mu1.getValue();
                 transitionsTowardsLivenessAssumption[j-(livenessGuarantees.size()-livenessAssumptions.size())] = goodTransitions;
 
                 // Backup transitions not towards the goal
-                strategyDumpingData.push_back(std::pair<unsigned int,BF>(j,nonDeadEndSafetySys & nu2.getValue().SwapVariables(varVectorPre,varVectorPost)));
+                strategyDumpingData.push_back(std::pair<unsigned int,BF>(j,nonDeadEndSafetySys & nu2.getValue().unprimeToPrime()));
             }
 
 
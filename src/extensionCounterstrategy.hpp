@@ -15,6 +15,7 @@ protected:
 
     // Inherited stuff used
     using T::mgr;
+    using T::traceFixedPointIteration;
     using T::livenessGuarantees;
     using T::livenessAssumptions;
     using T::varVectorPre;
@@ -73,7 +74,7 @@ public:
             // Start computing the transitions that lead closer to the goal and lead to a position that is not yet known to be losing (for the environment).
             // Start with the ones that actually represent reaching the goal (which is a transition in this implementation as we can have
             // nexts in the goal descriptions).
-            BF livetransitions = (!livenessGuarantees[j]) | (mu2.getValue().SwapVariables(varVectorPre,varVectorPost));
+            BF livetransitions = (!livenessGuarantees[j]) | (mu2.getValue().unprimeToPrime());
 
             // Compute the middle least-fixed point (called 'Y' in the GR(1) paper)
             BFFixedPoint nu1(mgr.constantTrue());
@@ -83,7 +84,7 @@ public:
                 strategyDumpingData = strategyDumpingDataOld;
 
                 // Update the set of transitions that lead closer to the goal.
-                livetransitions &= nu1.getValue().SwapVariables(varVectorPre,varVectorPost);
+                livetransitions &= nu1.getValue().unprimeToPrime();
 
                 // Iterate over the liveness assumptions. Store the positions that are found to be winning for *all*
                 // of them into the variable 'goodForAnyLivenessAssumption'.
@@ -99,7 +100,7 @@ public:
                     for (;!mu0.isFixedPointReached();) {
 
                         // Compute a set of paths that are safe to take - used for the enforceable predecessor operator ('cox')
-                        foundPaths = livetransitions & (mu0.getValue().SwapVariables(varVectorPre,varVectorPost) | (livenessAssumptions[i]));
+                        foundPaths = livetransitions & (mu0.getValue().unprimeToPrime() | (livenessAssumptions[i]));
                         foundPaths = (safetyEnv & safetySys.Implies(foundPaths)).UnivAbstract(varCubePostOutput);
 
                         // Dump the paths that we just found into 'strategyDumpingData' - store the current goal
@@ -108,6 +109,7 @@ public:
 
                         // Update the inner-most fixed point with the result of applying the enforcable predecessor operator
                         mu0.update(foundPaths.ExistAbstract(varCubePostInput));
+                        traceFixedPointIteration("mu0",j,i,mu0.getValue(),&foundPaths);
                     }
 
                     // Update the set of positions that are winning for some liveness assumption
@@ -117,6 +119,7 @@ public:
 
                 // Update the middle fixed point
                 nu1.update(goodForAllLivenessAssumptions);
+                traceFixedPointIteration("nu1",j,-1,nu1.getValue());
             }
 
             // Update the set of positions that are winning for some environment goal for the outermost fixed point
@@ -125,6 +128,7 @@ public:
 
         // Update the outer-most fixed point
         mu2.update(nextContraintsForGoals);
+        traceFixedPointIteration("mu2",-1,-1,mu2.getValue());
 
     }
 
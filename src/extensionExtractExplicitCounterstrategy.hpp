@@ -201,7 +201,7 @@ void computeAndPrintExplicitStateStrategy(std::ostream &outputStream) {
                 remainingTransitions &= !newCombination;
 
                 // We don't need the pre information from the point onwards anymore.
-                newCombination = newCombination.ExistAbstract(varCubePre).SwapVariables(varVectorPre,varVectorPost);
+                newCombination = newCombination.ExistAbstract(varCubePre).primeToUnprime();
 
                 unsigned int tn;
 
@@ -240,7 +240,7 @@ void computeAndPrintExplicitStateStrategy(std::ostream &outputStream) {
     
     BF newCombination = determinize(targetPositionCandidateSet, postVars) ;
     
-    newCombination  = (newCombination.ExistAbstract(varCubePostOutput).ExistAbstract(varCubePre)).SwapVariables(varVectorPre,varVectorPost);
+    newCombination  = (newCombination.ExistAbstract(varCubePostOutput).ExistAbstract(varCubePre)).primeToUnprime();
     
     std::pair<size_t, std::pair<unsigned int, unsigned int> > target = std::pair<size_t, std::pair<unsigned int, unsigned int> >(newCombination.getHashCode(),std::pair<unsigned int, unsigned int>(current.second.first, current.second.second));
     unsigned int tn;
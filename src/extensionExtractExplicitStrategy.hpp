@@ -2,7 +2,13 @@
 #define __EXTENSION_EXTRACT_STRATEGY_HPP
 
 #include "gr1context.hpp"
+#include "explicitStateTable.hpp"
+#include "bufferedOutputWriter.hpp"
+#include "binaryStrategy.hpp"
+#include "explicitStrategyMinimizer.hpp"
 #include <string>
+#include <algorithm>
+#include <limits>
 
 /**
  * An extension that triggers that a strategy is actually extracted.
@@ -27,12 +33,14 @@ protected:
     using T::variableTypes;
     using T::realizable;
     using T::postVars;
-    using T::varCubePre;
     using T::variableNames;
-    using T::varVectorPre;
-    using T::varVectorPost;
     using T::varCubePostOutput;
     using T::determinize;
+    using T::solverOptions;
+    using T::postOutputVars;
+    using T::varCubePre;
+    using T::varVectorPre;
+    using T::varVectorPost;
     using T::doesVariableInheritType;
 
     XExtractExplicitStrategy<T,oneStepRecovery,jsonOutput>(std::list<std::string> &filenames): T(filenames) {}
@@ -53,15 +61,15 @@ public:
         T::execute();
         if (realizable) {
             if (outputFilename=="") {
-                computeAndPrintExplicitStateStrategy(std::cout);
+                writeExplicitStateStrategy(std::cout);
             } else {
-                std::ofstream of(outputFilename.c_str());
+                std::ofstream of(outputFilename.c_str(),solverOptions.binaryStrategyOutput?(std::ios::out | std::ios::binary):std::ios::out);
                 if (of.fail()) {
                     SlugsException ex(false);
                     ex << "Error: Could not open output file'" << outputFilename << "\n";
                     throw ex;
                 }
-                computeAndPrintExplicitStateStrategy(of);
+                writeExplicitStateStrategy(of);
                 if (of.fail()) {
                     SlugsException ex(false);
                     ex << "Error: Writing to output file'" << outputFilename << "failed. \n";
@@ -72,6 +80,48 @@ public:
         }
     }
 
+    /**
+     * @brief Extracts the explicit-state strategy with the extraction function selected in the solver options
+     *        and prints it, either as text/JSON or in the binary strategy format (see "binaryStrategy.hpp").
+     */
+    void writeExplicitStateStrategy(std::ostream &outputFile) {
+        if (solverOptions.binaryStrategyOutput) {
+            std::vector<std::string> preVariableNames;
+            for (unsigned int i=0;i<variables.size();i++) {
+                if (doesVariableInheritType(i,Pre)) preVariableNames.push_back(variableNames[i]);
+            }
+            BinaryStrategyWriter outputStream(preVariableNames,livenessGuarantees.size());
+            printExplicitStateStrategy(outputStream);
+            outputStream.write(outputFile);
+        } else {
+            BufferedOutputWriter outputStream(outputFile);
+            printExplicitStateStrategy(outputStream);
+        }
+    }
+
+    /**
+     * @brief Extracts the explicit-state strategy and prints it, after minimizing it if selected in the solver options.
+     */
+    template<class Output> void printExplicitStateStrategy(Output &outputStream) {
+        if (solverOptions.minimizeExplicitStrategy) {
+            ExplicitStrategyMinimizer minimizer(preVars.size());
+            computeAndPrintExplicitStateStrategyWithSelectedAlgorithm(minimizer);
+            minimizer.minimize();
+            std::cerr << "Minimized the explicit-state strategy from " << minimizer.getNofStates() << " to " << minimizer.getNofMinimizedStates() << " states.\n";
+            printMinimizedStrategy(minimizer,outputStream);
+        } else {
+            computeAndPrintExplicitStateStrategyWithSelectedAlgorithm(outputStream);
+        }
+    }
+
+    template<class Output> void computeAndPrintExplicitStateStrategyWithSelectedAlgorithm(Output &outputStream) {
+        if (solverOptions.symbolicFrontierExtraction) {
+            computeAndPrintExplicitStateStrategySymbolically(outputStream);
+        } else {
+            computeAndPrintExplicitStateStrategy(outputStream);
+        }
+    }
+
     /**
      * @brief Compute and print out (to stdout) an explicit-state strategy that is winning for
      *        the system. The output is compatible with the old JTLV output of LTLMoP.
@@ -80,72 +130,35 @@ public:
      *        "winningPositions" have been filled by the synthesis algorithm with meaningful data.
      * @param outputStream - Where the strategy shall be printed to.
      */
-    void computeAndPrintExplicitStateStrategy(std::ostream &outputStream) {
+    template<class Output> void computeAndPrintExplicitStateStrategy(Output &outputStream) {
 
         // We don't want any reordering from this point onwards, as
         // the BDD manipulations from this point onwards are 'kind of simple'.
         mgr.setAutomaticOptimisation(false);
 
-        // List of states in existance so far. The first map
-        // maps from a BF node pointer (for the pre variable valuation) and a goal
-        // to a state number. The vector then contains the concrete valuation.
-        std::map<std::pair<size_t, unsigned int>, unsigned int > lookupTableForPastStates;
-        std::vector<BF> bfsUsedInTheLookupTable;
-        std::list<std::pair<size_t, unsigned int> > todoList;
+        // List of states in existance so far, consisting of the pre variable valuations
+        // and goals. The states that have not been processed yet form the to-do list.
+        ExplicitStateTable states(preVars.size());
 
         // Prepare initial to-do list from the allowed initial states
-        BF todoInit = (oneStepRecovery)?(winningPositions & initSys):(winningPositions & initSys & initEnv);
+        BF todoInit = (oneStepRecovery)?BF(winningPositions & initSys):BF(winningPositions & initSys & initEnv);
+        std::vector<bool> valuation;
         while (!(todoInit.isFalse())) {
-            BF concreteState = determinize(todoInit,preVars);
-            std::pair<size_t, unsigned int> lookup = std::pair<size_t, unsigned int>(concreteState.getHashCode(),0);
-            lookupTableForPastStates[lookup] = bfsUsedInTheLookupTable.size();
-            bfsUsedInTheLookupTable.push_back(concreteState);
+            BF concreteState = determinize(todoInit,preVars,valuation);
+            states.insert(valuation,0);
             todoInit &= !concreteState;
-            todoList.push_back(lookup);
         }
 
-        // Prepare positional strategies for the individual goals
-        std::vector<BF> positionalStrategiesForTheIndividualGoals(livenessGuarantees.size());
-        for (unsigned int i=0;i<livenessGuarantees.size();i++) {
-            BF casesCovered = mgr.constantFalse();
-            BF strategy = mgr.constantFalse();
-            for (auto it = strategyDumpingData.begin();it!=strategyDumpingData.end();it++) {
-                if (it->first == i) {
-                    BF newCases = it->second.ExistAbstract(varCubePostOutput) & !casesCovered;
-                    strategy |= newCases & it->second;
-                    casesCovered |= newCases;
-                }
-            }
-            positionalStrategiesForTheIndividualGoals[i] = strategy;
-            //BF_newDumpDot(*this,strategy,"PreInput PreOutput PostInput PostOutput","/tmp/generalStrategy.dot");
-        }
-
-        // Print JSON Header if JSON output is desired
-        if (jsonOutput) {
-            outputStream << "{\"version\": 0,\n \"slugs\": \"0.0.1\",\n\n";
-
-            // print names of variables
-            bool first = true;
-            outputStream << " \"variables\": [";
-            for (unsigned int i=0; i<variables.size(); i++) {
-                if (doesVariableInheritType(i, Pre)) {
-                    if (first) {
-                        first = false;
-                    } else {
-                        outputStream << ", ";
-                    }
-                    outputStream << "\"" << variableNames[i] << "\"";
-                }
-            }
-            outputStream << "],\n\n \"nodes\": {\n";
-        }
+        std::vector<BF> positionalStrategiesForTheIndividualGoals = computePositionalStrategies();
+        printStrategyHeader(outputStream);
 
         // Extract strategy
-        while (todoList.size()>0) {
-            std::pair<size_t, unsigned int> current = todoList.front();
-            todoList.pop_front();
-            unsigned int stateNum = lookupTableForPastStates[current];
-            BF currentPossibilities = bfsUsedInTheLookupTable[stateNum];
+        while (states.hasUnprocessedStates()) {
+            unsigned int stateNum = states.getNextUnprocessedState();
+            unsigned int currentGoal = states.getGoal(stateNum);
+            states.getValuation(stateNum,valuation);
+            BF currentState = mgr.computeMinterm(preVars,valuation);
+            BF currentPossibilities = currentState;
 
             /*{
                 std::ostringstream filename;
@@ -154,35 +167,11 @@ public:
             }*/
 
             // Print state information
-            if (jsonOutput) {
-                outputStream << "\"" << stateNum << "\": {\n\t\"rank\": " << current.second << ",\n\t\"state\": [";
-            } else {
-                outputStream << "State " << stateNum << " with rank " << current.second << " -> <";
-            }
-
+            printStateHeader(outputStream,stateNum,currentGoal,valuation);
             bool first = true;
-            for (unsigned int i=0;i<variables.size();i++) {
-                if (doesVariableInheritType(i,Pre)) {
-                    if (first) {
-                        first = false;
-                    } else {
-                        outputStream << ", ";
-                    }
-                    if (!jsonOutput) outputStream << variableNames[i] << ":";
-                    outputStream << (((currentPossibilities & variables[i]).isFalse())?"0":"1");
-                }
-            }
-            if (jsonOutput) {
-                outputStream << "],\n";  // end of state list
-                // start list of successors
-                outputStream << "\t\"trans\": [";
-            } else {
-                outputStream << ">\n\tWith successors : ";
-            }
-            first = true;
 
             // Compute successors for all variables that allow these
-            currentPossibilities &= positionalStrategiesForTheIndividualGoals[current.second];
+            currentPossibilities &= positionalStrategiesForTheIndividualGoals[currentGoal];
             BF remainingTransitions =
                     (oneStepRecovery)?
                     currentPossibilities:
@@ -195,12 +184,12 @@ public:
             BF envTransDone = mgr.constantFalse();
 #endif
             while (!(remainingTransitions.isFalse())) {
-                BF newCombination = determinize(remainingTransitions,postVars);
+                BF newCombination = determinize(remainingTransitions,postVars,valuation);
 
                 // Jump as much forward  in the liveness guarantee list as possible ("stuttering avoidance")
-                unsigned int nextLivenessGuarantee = current.second;
+                unsigned int nextLivenessGuarantee = currentGoal;
                 bool firstTry = true;
-                while (((nextLivenessGuarantee != current.second) || firstTry) && !((livenessGuarantees[nextLivenessGuarantee] & newCombination).isFalse())) {
+                while (((nextLivenessGuarantee != currentGoal) || firstTry) && !((livenessGuarantees[nextLivenessGuarantee] & newCombination).isFalse())) {
                     nextLivenessGuarantee = (nextLivenessGuarantee + 1) % livenessGuarantees.size();
                     firstTry = false;
                 }
@@ -210,51 +199,301 @@ public:
 #ifndef NDEBUG
                 envTransDone |= inputCaptured;
 #endif
-                newCombination = newCombination.ExistAbstract(varCubePre).SwapVariables(varVectorPre,varVectorPost);
                 remainingTransitions &= !inputCaptured;
 
-                // Search for newCombination
-                unsigned int tn;
-                std::pair<size_t, unsigned int> target = std::pair<size_t, unsigned int>(newCombination.getHashCode(),nextLivenessGuarantee);
-                if (lookupTableForPastStates.count(target)==0) {
-                    tn = lookupTableForPastStates[target] = bfsUsedInTheLookupTable.size();
-                    bfsUsedInTheLookupTable.push_back(newCombination);
-                    todoList.push_back(target);
-                } else {
-                    tn = lookupTableForPastStates[target];
-                }
+                // Search for the successor state - the valuation of the post variables is the one of the pre variables there
+                unsigned int tn = states.insert(valuation,nextLivenessGuarantee).first;
 
                 // Print
-                if (first) {
-                    first = false;
-                } else {
-                    outputStream << ", ";
-                }
-
-                outputStream << tn;
+                printSuccessor(outputStream,first,tn);
             }
 
 #ifndef NDEBUG
-             if (!((bfsUsedInTheLookupTable[stateNum] & safetyEnv &!envTransDone).isFalse()))
+             if (!((currentState & safetyEnv &!envTransDone).isFalse()))
                  throw "Error: Missing transition. Strategy generating plugin seems to be unsound.";
 #endif
 
-            if (jsonOutput) {
-                outputStream << "]\n}";
-                if (!(todoList.empty())) {
-                    outputStream << ",";
+            printStateFooter(outputStream);
+        }
+        printStrategyFooter(outputStream,states.size()>0);
+    }
+
+    /**
+     * @brief Computes the same explicit-state strategy as "computeAndPrintExplicitStateStrategy", but
+     *        computes the reachable states for all goals symbolically first, and then enumerates the states and
+     *        transitions from the resulting BDDs. This replaces the BDD operations for every single state
+     *        by a few operations on large BDDs.
+     * @param outputStream - Where the strategy shall be printed to.
+     */
+    template<class Output> void computeAndPrintExplicitStateStrategySymbolically(Output &outputStream) {
+
+        // As above, no reordering from this point onwards.
+        mgr.setAutomaticOptimisation(false);
+        unsigned int nofGoals = livenessGuarantees.size();
+        std::vector<BF> positionalStrategiesForTheIndividualGoals = computePositionalStrategies();
+
+        // Compute the transitions taken for every goal, split by the goal in the target state. Like
+        // "determinize" in the other extraction function, the strategy takes the first output (in the order of
+        // the variables, 0 before 1) that it allows for every input. The goal switching is the same as well.
+        std::vector<std::vector<BF> > transitions(nofGoals,std::vector<BF>(nofGoals));
+        std::vector<BF> const &outputVars = postOutputVars;
+        for (unsigned int goal=0;goal<nofGoals;goal++) {
+            BF choices = (oneStepRecovery)?positionalStrategiesForTheIndividualGoals[goal]:(positionalStrategiesForTheIndividualGoals[goal] & safetyEnv);
+            for (auto const &outputVar : outputVars) {
+                BF canBeFalse = (choices & !outputVar).ExistAbstract(varCubePostOutput);
+                choices &= !outputVar | !canBeFalse;
+            }
+
+            // Jump as much forward  in the liveness guarantee list as possible ("stuttering avoidance")
+            transitions[goal][goal] = choices & !livenessGuarantees[goal];
+            BF remainingChoices = choices & livenessGuarantees[goal];
+            for (unsigned int i=1;i<nofGoals;i++) {
+                unsigned int nextGoal = (goal+i) % nofGoals;
+                transitions[goal][nextGoal] = remainingChoices & !livenessGuarantees[nextGoal];
+                remainingChoices &= livenessGuarantees[nextGoal];
+            }
+            transitions[goal][goal] |= remainingChoices;
+        }
+
+        // Compute the reachable states for every goal, with a frontier of new states for every goal
+        BF initialStates = (oneStepRecovery)?BF(winningPositions & initSys):BF(winningPositions & initSys & initEnv);
+        std::vector<BF> reachableStates(nofGoals,mgr.constantFalse());
+        std::vector<BF> frontiers(nofGoals,mgr.constantFalse());
+        reachableStates[0] = frontiers[0] = initialStates;
+        bool frontiersEmpty = initialStates.isFalse();
+        while (!frontiersEmpty) {
+            std::vector<BF> successors(nofGoals,mgr.constantFalse());
+            for (unsigned int goal=0;goal<nofGoals;goal++) {
+                if (frontiers[goal].isFalse()) continue;
+                for (unsigned int nextGoal=0;nextGoal<nofGoals;nextGoal++) {
+                    successors[nextGoal] |= frontiers[goal].AndAbstract(transitions[goal][nextGoal],varCubePre).primeToUnprime();
                 }
-                outputStream << "\n\n";
-            } else {
-                outputStream << "\n";
+            }
+            frontiersEmpty = true;
+            for (unsigned int goal=0;goal<nofGoals;goal++) {
+                frontiers[goal] = successors[goal] & !reachableStates[goal];
+                reachableStates[goal] |= frontiers[goal];
+                frontiersEmpty &= frontiers[goal].isFalse();
             }
         }
+
+        // Enumerate the states and transitions. The initial states come first, in the order in which
+        // "determinize" picks them.
+        std::vector<BF> const &preVarVector = preVars;
+        std::vector<BF> const &postVarVector = postVars;
+        ExplicitStateTable states(preVarVector.size());
+        std::vector<std::vector<bool> > initialValuations;
+        initialStates.forEachMinterm(preVarVector,[&initialValuations](std::vector<bool> const &valuation) {
+            initialValuations.push_back(valuation);
+        });
+        std::sort(initialValuations.begin(),initialValuations.end());
+        std::vector<unsigned int> initialStateNumbers;
+        for (auto const &valuation : initialValuations) {
+            initialStateNumbers.push_back(states.insert(valuation,0).first);
+        }
+
+        std::vector<BF> prePostVarVector(preVarVector);
+        prePostVarVector.insert(prePostVarVector.end(),postVarVector.begin(),postVarVector.end());
+        std::vector<std::vector<unsigned int> > successorStates;
+        std::vector<bool> preValuation(preVarVector.size());
+        std::vector<bool> postValuation(postVarVector.size());
+        for (unsigned int goal=0;goal<nofGoals;goal++) {
+            for (unsigned int nextGoal=0;nextGoal<nofGoals;nextGoal++) {
+                (reachableStates[goal] & transitions[goal][nextGoal]).forEachMinterm(prePostVarVector,[&](std::vector<bool> const &valuation) {
+                    std::copy(valuation.begin(),valuation.begin()+preValuation.size(),preValuation.begin());
+                    std::copy(valuation.begin()+preValuation.size(),valuation.end(),postValuation.begin());
+                    unsigned int from = states.insert(preValuation,goal).first;
+                    unsigned int to = states.insert(postValuation,nextGoal).first;
+                    if (successorStates.size()<states.size()) successorStates.resize(states.size());
+                    successorStates[from].push_back(to);
+                });
+            }
+        }
+        successorStates.resize(states.size());
+
+        // Number the states in the order of a breadth-first search in which the successors
+        // are ordered as "determinize" picks them, i.e., as the other extraction function does.
+        const unsigned int unnumbered = std::numeric_limits<unsigned int>::max();
+        std::vector<unsigned int> stateNumbers(states.size(),unnumbered);
+        std::vector<unsigned int> statesInOrder;
+        for (unsigned int state : initialStateNumbers) {
+            stateNumbers[state] = statesInOrder.size();
+            statesInOrder.push_back(state);
+        }
+        for (unsigned int i=0;i<statesInOrder.size();i++) {
+            std::vector<unsigned int> &successors = successorStates[statesInOrder[i]];
+            std::sort(successors.begin(),successors.end(),[&states](unsigned int a, unsigned int b) {
+                return states.isValuationSmaller(a,b);
+            });
+            for (unsigned int successor : successors) {
+                if (stateNumbers[successor]==unnumbered) {
+                    stateNumbers[successor] = statesInOrder.size();
+                    statesInOrder.push_back(successor);
+                }
+            }
+        }
+
+        // Print
+        printStrategyHeader(outputStream);
+        std::vector<bool> valuation;
+        for (unsigned int i=0;i<statesInOrder.size();i++) {
+            unsigned int state = statesInOrder[i];
+            states.getValuation(state,valuation);
+            printStateHeader(outputStream,i,states.getGoal(state),valuation);
+            bool first = true;
+            for (unsigned int successor : successorStates[state]) {
+                printSuccessor(outputStream,first,stateNumbers[successor]);
+            }
+            printStateFooter(outputStream);
+        }
+        printStrategyFooter(outputStream,statesInOrder.size()>0);
+    }
+
+    /**
+     * @brief Prints a strategy that has been minimized by an "ExplicitStrategyMinimizer"
+     */
+    template<class Output> void printMinimizedStrategy(ExplicitStrategyMinimizer const &minimizer, Output &outputStream) {
+        printStrategyHeader(outputStream);
+        std::vector<bool> valuation;
+        std::vector<unsigned int> successors;
+        for (unsigned int i=0;i<minimizer.getNofMinimizedStates();i++) {
+            minimizer.getValuation(i,valuation);
+            printStateHeader(outputStream,i,minimizer.getGoal(i),valuation);
+            bool first = true;
+            minimizer.getSuccessors(i,successors);
+            for (unsigned int successor : successors) {
+                printSuccessor(outputStream,first,successor);
+            }
+            printStateFooter(outputStream);
+        }
+        printStrategyFooter(outputStream,minimizer.getNofMinimizedStates()>0);
+    }
+
+    /**
+     * @brief Prepares the positional strategies for the individual goals from the "strategyDumpingData"
+     */
+    std::vector<BF> computePositionalStrategies() {
+        std::vector<BF> positionalStrategiesForTheIndividualGoals(livenessGuarantees.size());
+        for (unsigned int i=0;i<livenessGuarantees.size();i++) {
+            BF casesCovered = mgr.constantFalse();
+            BF strategy = mgr.constantFalse();
+            for (auto it = strategyDumpingData.begin();it!=strategyDumpingData.end();it++) {
+                if (it->first == i) {
+                    BF newCases = it->second.ExistAbstract(varCubePostOutput) & !casesCovered;
+                    strategy |= newCases & it->second;
+                    casesCovered |= newCases;
+                }
+            }
+            positionalStrategiesForTheIndividualGoals[i] = strategy;
+            //BF_newDumpDot(*this,strategy,"PreInput PreOutput PostInput PostOutput","/tmp/generalStrategy.dot");
+        }
+        return positionalStrategiesForTheIndividualGoals;
+    }
+
+    void printStrategyHeader(BufferedOutputWriter &outputStream) {
+        // Print JSON Header if JSON output is desired
         if (jsonOutput) {
+            outputStream << "{\"version\": 0,\n \"slugs\": \"0.0.1\",\n\n";
+
+            // print names of variables
+            bool first = true;
+            outputStream << " \"variables\": [";
+            for (unsigned int i=0; i<variables.size(); i++) {
+                if (doesVariableInheritType(i, Pre)) {
+                    if (first) {
+                        first = false;
+                    } else {
+                        outputStream << ", ";
+                    }
+                    outputStream << "\"" << variableNames[i] << "\"";
+                }
+            }
+            outputStream << "],\n\n \"nodes\": {\n";
+        }
+    }
+
+    /**
+     * @brief Prints a state up to the list of successors. The states need to be printed in the order of their numbers.
+     * @param valuation the values of the pre variables in the state
+     */
+    void printStateHeader(BufferedOutputWriter &outputStream, unsigned int stateNum, unsigned int goal, std::vector<bool> const &valuation) {
+        if (jsonOutput) {
+            // The separator from the previous state
+            if (stateNum>0) outputStream << ",\n\n";
+            outputStream << "\"" << stateNum << "\": {\n\t\"rank\": " << goal << ",\n\t\"state\": [";
+        } else {
+            outputStream << "State " << stateNum << " with rank " << goal << " -> <";
+        }
+
+        bool first = true;
+        unsigned int preVarNumber = 0;
+        for (unsigned int i=0;i<variables.size();i++) {
+            if (doesVariableInheritType(i,Pre)) {
+                if (first) {
+                    first = false;
+                } else {
+                    outputStream << ", ";
+                }
+                if (!jsonOutput) outputStream << variableNames[i] << ":";
+                outputStream << (valuation[preVarNumber++]?"1":"0");
+            }
+        }
+        if (jsonOutput) {
+            outputStream << "],\n";  // end of state list
+            // start list of successors
+            outputStream << "\t\"trans\": [";
+        } else {
+            outputStream << ">\n\tWith successors : ";
+        }
+    }
+
+    void printSuccessor(BufferedOutputWriter &outputStream, bool &first, unsigned int successor) {
+        if (first) {
+            first = false;
+        } else {
+            outputStream << ", ";
+        }
+        outputStream << successor;
+    }
+
+    void printStateFooter(BufferedOutputWriter &outputStream) {
+        if (jsonOutput) {
+            outputStream << "]\n}";
+        } else {
+            outputStream << "\n";
+        }
+    }
+
+    void printStrategyFooter(BufferedOutputWriter &outputStream, bool anyStatesPrinted) {
+        if (jsonOutput) {
+            if (anyStatesPrinted) outputStream << "\n\n";
             // close "nodes" dict and json object
             outputStream << "}}\n";
         }
     }
 
+    // In the binary format, the states are only collected until the strategy is complete
+    void printStrategyHeader(BinaryStrategyWriter &) {}
+    void printStateHeader(BinaryStrategyWriter &outputStream, unsigned int, unsigned int goal, std::vector<bool> const &valuation) {
+        outputStream.addState(valuation,goal);
+    }
+    void printSuccessor(BinaryStrategyWriter &outputStream, bool &, unsigned int successor) {
+        outputStream.addSuccessor(successor);
+    }
+    void printStateFooter(BinaryStrategyWriter &) {}
+    void printStrategyFooter(BinaryStrategyWriter &, bool) {}
+
+    // When minimizing the strategy, the states are collected first as well
+    void printStrategyHeader(ExplicitStrategyMinimizer &) {}
+    void printStateHeader(ExplicitStrategyMinimizer &outputStream, unsigned int, unsigned int goal, std::vector<bool> const &valuation) {
+        outputStream.addState(valuation,goal);
+    }
+    void printSuccessor(ExplicitStrategyMinimizer &outputStream, bool &, unsigned int successor) {
+        outputStream.addSuccessor(successor);
+    }
+    void printStateFooter(ExplicitStrategyMinimizer &) {}
+    void printStrategyFooter(ExplicitStrategyMinimizer &, bool) {}
+
     static GR1Context* makeInstance(std::list<std::string> &filenames) {
         return new XExtractExplicitStrategy<T,oneStepRecovery,jsonOutput>(filenames);
     }
@@ -80,7 +80,7 @@ public:
         mgr.setAutomaticOptimisation(false);
 
         // Prepare initial to-do list from the allowed initial states
-        BF init = (oneStepRecovery)?(winningPositions & initSys):(winningPositions & initSys & initEnv);
+        BF init = (oneStepRecovery)?BF(winningPositions & initSys):BF(winningPositions & initSys & initEnv);
 
         // Prepare positional strategies for the individual goals
         std::vector<BF> positionalStrategiesForTheIndividualGoals(livenessGuarantees.size());
@@ -16,6 +16,7 @@ protected:
 
     // Inherited stuff used
     using T::mgr;
+    using T::traceFixedPointIteration;
     using T::strategyDumpingData;
     using T::livenessGuarantees;
     using T::livenessAssumptions;
@@ -26,12 +27,19 @@ protected:
     using T::safetyEnv;
     using T::safetySys;
     using T::winningPositions;
+    using T::solverOptions;
+    using T::enforceablePredecessor;
+    using T::computeTransitionRelationClusters;
 
     // Constructor
     XFixedPointRecycling<T>(std::list<std::string> &filenames) : T(filenames) {}
 
     // Modified synthesis function
-    void computeWinningPositions() {
+    void computeWinningPositionsWithoutPortfolio() {
+
+        // Group the safety constraints into clusters if the enforceable predecessor is to be computed
+        // with a partitioned transition relation
+        if (solverOptions.partitionedTransitionRelation) computeTransitionRelationClusters();
 
         // The greatest fixed point - called "Z" in the GR(1) synthesis paper
         BFFixedPoint nu2(mgr.constantTrue());
@@ -66,7 +74,7 @@ protected:
                 // Start computing the transitions that lead closer to the goal and lead to a position that is not yet known to be losing.
                 // Start with the ones that actually represent reaching the goal (which is a transition in this implementation as we can have
                 // nexts in the goal descriptions).
-                BF livetransitions = livenessGuarantees[j] & (nu2.getValue().SwapVariables(varVectorPre,varVectorPost));
+                BF livetransitions = livenessGuarantees[j] & (nu2.getValue().unprimeToPrime());
 
                 // Compute the middle least-fixed point (called 'Y' in the GR(1) paper)
                 BFFixedPoint mu1(mgr.constantFalse());
@@ -76,7 +84,7 @@ protected:
                 for (;!mu1.isFixedPointReached();) {
 
                     // Update the set of transitions that lead closer to the goal.
-                    livetransitions |= mu1.getValue().SwapVariables(varVectorPre,varVectorPost);
+                    livetransitions |= mu1.getValue().unprimeToPrime();
 
                     // Iterate over the liveness assumptions. Store the positions that are found to be winning for *any*
                     // of them into the variable 'goodForAnyLivenessAssumption'.
@@ -92,13 +100,16 @@ protected:
                         for (;!nu0.isFixedPointReached();) {
 
                             // Compute a set of paths that are safe to take - used for the enforceable predecessor operator ('cox')
-                            foundPaths = livetransitions | (nu0.getValue().SwapVariables(varVectorPre,varVectorPost) & !(livenessAssumptions[i]));
-                            foundPaths &= safetySys;
+                            foundPaths = livetransitions | (nu0.getValue().unprimeToPrime() & !(livenessAssumptions[i]));
 
                             // Update the inner-most fixed point with the result of applying the enforcable predecessor operator
-                            nu0.update(safetyEnv.Implies(foundPaths).ExistAbstract(varCubePostOutput).UnivAbstract(varCubePostInput));
+                            nu0.update(enforceablePredecessor(foundPaths));
+                            traceFixedPointIteration("nu0",j,i,nu0.getValue(),&foundPaths);
                         }
 
+                        // Only the paths that are allowed by the safety guarantees are used for strategy extraction
+                        foundPaths &= safetySys;
+
                         // Update the set of positions that are winning for some liveness assumption
                         goodForAnyLivenessAssumption |= nu0.getValue();
 
@@ -111,6 +122,7 @@ protected:
 
                     // Update the moddle fixed point
                     mu1.update(goodForAnyLivenessAssumption);
+                    traceFixedPointIteration("mu1",j,-1,mu1.getValue());
 
                     firstMiddle = false;
                 }
@@ -121,6 +133,7 @@ protected:
 
             // Update the outer-most fixed point
             nu2.update(nextContraintsForGoals);
+            traceFixedPointIteration("nu2",-1,-1,nu2.getValue());
             firstOutermost = false;
 
         }
@@ -23,6 +23,7 @@ protected:
 
     // Inherited stuff used
     using T::mgr;
+    using T::traceFixedPointIteration;
     using T::livenessGuarantees;
     using T::livenessAssumptions;
     using T::varVectorPre;
@@ -37,7 +38,7 @@ protected:
     using T::variables;
     using T::variableNames;
     using T::variableTypes;
-    using T::parseBooleanFormulaRecurse;
+    using T::addVariable;
     using T::parseBooleanFormula;
     using T::preVars;
     using T::postVars;
@@ -118,26 +119,14 @@ void init(std::list<std::string> &filenames) {
                 }
             } else {
                 if (readMode==0) {
-                    variables.push_back(mgr.newVariable());
-                    variableNames.push_back(currentLine);
-                    variableTypes.push_back(PreInput);
-                    variables.push_back(mgr.newVariable());
-                    variableNames.push_back(currentLine+"'");
-                    variableTypes.push_back(PostInput);
+                    addVariable(PreInput,currentLine);
+                    addVariable(PostInput,currentLine+"'");
                 } else if (readMode==1) {
-                    variables.push_back(mgr.newVariable());
-                    variableNames.push_back(currentLine);
-                    variableTypes.push_back(PreOutputFast);
-                    variables.push_back(mgr.newVariable());
-                    variableNames.push_back(currentLine+"'");
-                    variableTypes.push_back(PostOutputFast);
+                    addVariable(PreOutputFast,currentLine);
+                    addVariable(PostOutputFast,currentLine+"'");
                 } else if (readMode==8) {
-                    variables.push_back(mgr.newVariable());
-                    variableNames.push_back(currentLine);
-                    variableTypes.push_back(PreOutputSlow);
-                    variables.push_back(mgr.newVariable());
-                    variableNames.push_back(currentLine+"'");
-                    variableTypes.push_back(PostOutputSlow);
+                    addVariable(PreOutputSlow,currentLine);
+                    addVariable(PostOutputSlow,currentLine+"'");
                 } else if (readMode==2) {
                     std::set<VariableType> allowedTypes;
                     allowedTypes.insert(PreInput);
@@ -223,9 +212,9 @@ public:
     BFFixedPoint nu2(mgr.constantTrue());
     
     BF safeStates = safetySys.ExistAbstract(varCubePostInput).ExistAbstract(varCubePostOutputS).ExistAbstract(varCubePostOutputF);
-    BF safeNext = (safetySys.ExistAbstract(varCubePreInput).ExistAbstract(varCubePreOutputS).ExistAbstract(varCubePreOutputF)).SwapVariables(varVectorPost,varVectorPre);
+    BF safeNext = (safetySys.ExistAbstract(varCubePreInput).ExistAbstract(varCubePreOutputS).ExistAbstract(varCubePreOutputF)).primeToUnprime();
     
-    BF newSafetySys = safetySys & (safeStates & safeNext).SwapVariables(varVectorPre,varVectorPost).SwapVariables(varVectorPostOutputS,varVectorPreOutputS);
+    BF newSafetySys = safetySys & (safeStates & safeNext).unprimeToPrime().SwapVariables(varVectorPostOutputS,varVectorPreOutputS);
     
     assert(((const BFVarCube&)varCubePostOutputS).size()+((const BFVarCube&)varCubePostOutputF).size()==((const BFVarCube&)varCubePostOutput).size());
     
@@ -258,14 +247,14 @@ public:
             // Start computing the transitions that lead closer to the goal and lead to a position that is not yet known to be losing.
             // Start with the ones that actually represent reaching the goal (which is a transition in this implementation as we can have
             // nexts in the goal descriptions).
-            BF livetransitions = livenessGuarantees[j] & (nu2.getValue().SwapVariables(varVectorPre,varVectorPost));
+            BF livetransitions = livenessGuarantees[j] & (nu2.getValue().unprimeToPrime());
 
             // Compute the middle least-fixed point (called 'Y' in the GR(1) paper)
             BFFixedPoint mu1(mgr.constantFalse());
             for (;!mu1.isFixedPointReached();) {
 
                 // Update the set of transitions that lead closer to the goal.
-                livetransitions |= mu1.getValue().SwapVariables(varVectorPre,varVectorPost);
+                livetransitions |= mu1.getValue().unprimeToPrime();
 
                 // Iterate over the liveness assumptions. Store the positions that are found to be winning for *any*
                 // of them into the variable 'goodForAnyLivenessAssumption'.
@@ -281,7 +270,7 @@ public:
                     for (;!nu0.isFixedPointReached();) {
 
                         // Compute a set of paths that are safe to take - used for the enforceable predecessor operator ('cox')
-                        foundPaths = livetransitions | (nu0.getValue().SwapVariables(varVectorPre,varVectorPost) & !(livenessAssumptions[i]));
+                        foundPaths = livetransitions | (nu0.getValue().unprimeToPrime() & !(livenessAssumptions[i]));
                         foundPaths &= newSafetySys;
 
                         // Update the inner-most fixed point with the result of applying the enforcable *FS* predecessor operator
@@ -290,11 +279,11 @@ public:
                         //Read the new enforceable predecessor operator starting at the update statement***
                         
                         //And there is a transition to the "to" (foundPaths) set, i.e. a slow move as well as the (pre-determined) fast move
-                        BF exy1 = (foundPaths).SwapVariables(varVectorPre,varVectorPost) & safetySys.ExistAbstract(varCubePostOutputF);        
+                        BF exy1 = (foundPaths).unprimeToPrime() & safetySys.ExistAbstract(varCubePostOutputF);        
                         
                         
                         //Such that the slowSame move is safe...
-                        BF exy2 = (sameVarS.Implies((safeStates & safeNext).SwapVariables(varVectorPre,varVectorPost))).UnivAbstract(varCubePostOutputF);        
+                        BF exy2 = (sameVarS.Implies((safeStates & safeNext).unprimeToPrime())).UnivAbstract(varCubePostOutputF);        
                         
                         
                         //If both types are changing, check the intermediate state (i.e. the "sameVarS" state):
@@ -304,7 +293,7 @@ public:
                         
                         
                         //If only one type of controller changes, use old enforceable predecessor operator
-                        BF fs2 = (foundPaths).SwapVariables(varVectorPre,varVectorPost) & (safetySys & (sameVarS)).ExistAbstract(varCubePostOutputF).ExistAbstract(varCubePostOutputF);
+                        BF fs2 = (foundPaths).unprimeToPrime() & (safetySys & (sameVarS)).ExistAbstract(varCubePostOutputF).ExistAbstract(varCubePostOutputF);
         
                         
                         ////For all environment moves, there is either a move that changes only slow or only fast, 
@@ -312,7 +301,8 @@ public:
                         nu0.update(safetyEnv.Implies(fs1 | (fs2)).UnivAbstract(varCubePostInput));
                         */
                         
-                        nu0.update(safetyEnv.Implies(foundPaths).ExistAbstract(varCubePostOutputF).ExistAbstract(varCubePostOutputS).UnivAbstract(varCubePostInput));
+                        nu0.update(BF::cox(safetyEnv,foundPaths,mgr.constantTrue(),varCubePostOutput,varCubePostInput));
+                        traceFixedPointIteration("nu0",j,i,nu0.getValue(),&foundPaths);
                     }
                 
                     // Update the set of positions that are winning for some liveness assumption
@@ -325,6 +315,7 @@ public:
 
                 // Update the moddle fixed point
                 mu1.update(goodForAnyLivenessAssumption);
+                traceFixedPointIteration("mu1",j,-1,mu1.getValue());
             }
 
             // Update the set of positions that are winning for any goal for the outermost fixed point
@@ -333,6 +324,7 @@ public:
 
         // Update the outer-most fixed point
         nu2.update(nextContraintsForGoals);
+        traceFixedPointIteration("nu2",-1,-1,nu2.getValue());
 
     }
 
@@ -347,7 +339,7 @@ void checkRealizability() {
 
     // Check if for every possible environment initial position the system has a good system initial position
     BF result;
-    result = initEnv.Implies((winningPositions & initSys).ExistAbstract(varCubePreOutputF).ExistAbstract(varCubePreOutputS)).UnivAbstract(varCubePreInput);
+    result = BF::cox(initEnv,initSys,winningPositions,varCubePreOutput,varCubePreInput);
 
     // Check if the result is well-defind. Might fail after an incorrect modification of the above algorithm
     if (!result.isConstant()) {
@@ -230,7 +230,7 @@ protected:
         while (reachableStates!=oldReachableStates) {
             std::cerr << ".";
             oldReachableStates = reachableStates;
-            BF newStates = reachableStates.AndAbstract(allSafetyConstraints,varCubePre).SwapVariables(varVectorPre,varVectorPost);
+            BF newStates = reachableStates.AndAbstract(allSafetyConstraints,varCubePre).primeToUnprime();
             //assert(newStates == (reachableStates & safetyEnv & safetySys).ExistAbstract(varCubePre).SwapVariables(varVectorPre,varVectorPost));
             reachableStates |= newStates;
         }
@@ -249,7 +249,7 @@ protected:
             do {
                 std::cerr << "x";
                 oldInnerReachableStates = reachableStates;
-                BF newStates = reachableStates.AndAbstract(allSafetyConstraints,varCubePre).SwapVariables(varVectorPre,varVectorPost);
+                BF newStates = reachableStates.AndAbstract(allSafetyConstraints,varCubePre).primeToUnprime();
                 BF ored = (reachableStates | newStates);
                 BF newReachable = ored.optimizeRestrict(oldReachableStates | !ored);
                 if (newReachable==reachable) && (ored!=reachable) {
@@ -340,7 +340,7 @@ protected:
         while (reachableStates!=oldReachableStates) {
             std::cerr << ".";
             oldReachableStates = reachableStates;
-            reachableStates |= reachableStates.AndAbstract(combined,varCubePre).SwapVariables(varVectorPre,varVectorPost);
+            reachableStates |= reachableStates.AndAbstract(combined,varCubePre).primeToUnprime();
         }
         std::cerr << "!";
         //BF_newDumpDot(*this,reachableStates,NULL,"/tmp/reachable2.dot");
@@ -359,7 +359,7 @@ protected:
         while (reachableStates!=oldReachableStates) {
               std::cerr << ".";
               oldReachableStates = reachableStates;
-              reachableStates |= reachableStates.AndAbstract(combined,varCubePre).SwapVariables(varVectorPre,varVectorPost);
+              reachableStates |= reachableStates.AndAbstract(combined,varCubePre).primeToUnprime();
         }
 
         // Perform some checks
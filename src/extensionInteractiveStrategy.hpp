@@ -18,6 +18,7 @@ protected:
 
     using T::checkRealizability;
     using T::realizable;
+    using T::reportRealizability;
     using T::variables;
     using T::variableNames;
     using T::variableTypes;
@@ -35,6 +36,7 @@ protected:
     using T::postOutputVars;
     using T::determinize;
     using T::determinizeRandomized;
+    using T::randomGenerator;
     using T::initEnv;
     using T::initSys;
     using T::preVars;
@@ -51,12 +53,7 @@ public:
 
     void execute() {
         checkRealizability();
-
-        if (realizable) {
-            std::cerr << "RESULT: Specification is realizable.\n";
-        } else {
-            std::cerr << "RESULT: Specification is unrealizable.\n";
-        }
+        reportRealizability();
 
         // Condense Strategy to positional strategies for the individual goals
         std::vector<BF> positionalStrategiesForTheIndividualGoals;
@@ -88,18 +85,18 @@ public:
             for (;!mu2.isFixedPointReached();) {
                 BF nextContraintsForGoals = mgr.constantFalse();
                 for (unsigned int j=0;j<livenessGuarantees.size();j++) {
-                    BF livetransitions = (!livenessGuarantees[j]) | (mu2.getValue().SwapVariables(varVectorPre,varVectorPost));
+                    BF livetransitions = (!livenessGuarantees[j]) | (mu2.getValue().unprimeToPrime());
                     std::vector<std::pair<unsigned int,BF> > strategyDumpingDataOld = strategyDumpingData;
                     BFFixedPoint nu1(mgr.constantTrue());
                     for (;!nu1.isFixedPointReached();) {
                         strategyDumpingData = strategyDumpingDataOld;
-                        livetransitions &= nu1.getValue().SwapVariables(varVectorPre,varVectorPost);
+                        livetransitions &= nu1.getValue().unprimeToPrime();
                         BF goodForAllLivenessAssumptions = nu1.getValue();
                         for (unsigned int i=0;i<livenessAssumptions.size();i++) {
                             BF foundPaths = mgr.constantFalse();
                             BFFixedPoint mu0(mgr.constantFalse());
                             for (;!mu0.isFixedPointReached();) {
-                                foundPaths = livetransitions & (mu0.getValue().SwapVariables(varVectorPre,varVectorPost) | (livenessAssumptions[i]));
+                                foundPaths = livetransitions & (mu0.getValue().unprimeToPrime() | (livenessAssumptions[i]));
                                 foundPaths = (safetyEnv & safetySys.Implies(foundPaths)).UnivAbstract(varCubePostOutput);
                                 strategyDumpingData.push_back(std::pair<unsigned int,BF>(i,foundPaths));
                                 mu0.update(foundPaths.ExistAbstract(varCubePostInput));
@@ -409,7 +406,7 @@ public:
                                 if (!foundOne) std::cout << "none";
                                 std::cout << std::endl;
 
-                                currentPosition = nextPosition.SwapVariables(varVectorPre,varVectorPost);
+                                currentPosition = nextPosition.primeToUnprime();
                             }
                         }
                     }
@@ -458,7 +455,7 @@ public:
 
                     currentLivenessGuarantee = nextLivenessGuarantee;
                     assert(currentLivenessGuarantee<positionalStrategiesForTheIndividualGoals.size());
-                    currentPosition = newCombination.ExistAbstract(varCubePre).SwapVariables(varVectorPre,varVectorPost);
+                    currentPosition = newCombination.ExistAbstract(varCubePre).primeToUnprime();
 
                     // Print position
                     for (unsigned int i=0;i<variables.size();i++) {
@@ -507,7 +504,7 @@ public:
                     trans &= positionalStrategiesForTheIndividualGoals[currentLivenessGuarantee];
 
                     // Switching goals
-                    BF newCombination = determinizeRandomized(trans,postVars);
+                    BF newCombination = determinizeRandomized(trans,postVars,randomGenerator);
 
                     // Jump as much forward  in the liveness guarantee list as possible ("stuttering avoidance")
                     unsigned int nextLivenessGuarantee = currentLivenessGuarantee;
@@ -518,7 +515,7 @@ public:
                     }
 
                     currentLivenessGuarantee = nextLivenessGuarantee;
-                    currentPosition = newCombination.ExistAbstract(varCubePre).SwapVariables(varVectorPre,varVectorPost);
+                    currentPosition = newCombination.ExistAbstract(varCubePre).primeToUnprime();
 
                     // Print position
                     for (unsigned int i=0;i<variables.size();i++) {
@@ -1019,7 +1016,7 @@ public:
 
                             // See if we can suggest a next trace element that does not enforce violation
                             BF allSafe = (safetySys & safetyEnv).ExistAbstract(varCubePost);
-                            BF candidate = allSafe.SwapVariables(varVectorPost,varVectorPre) & allSoFar;
+                            BF candidate = allSafe.unprimeToPrime() & allSoFar;
                             if (!(candidate.isFalse())) allSoFar = candidate;
 
                             // Determinize the rest
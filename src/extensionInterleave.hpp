@@ -24,6 +24,7 @@ protected:
 
     // Inherited stuff used
     using T::mgr;
+    using T::traceFixedPointIteration;
     using T::livenessGuarantees;
     using T::livenessAssumptions;
     using T::varVectorPre;
@@ -38,7 +39,6 @@ protected:
     using T::variables;
     using T::variableNames;
     using T::variableTypes;
-    using T::parseBooleanFormulaRecurse;
     using T::parseBooleanFormula;
     using T::preVars;
     using T::postVars;
@@ -113,14 +113,14 @@ public:
                 // Start computing the transitions that lead closer to the goal and lead to a position that is not yet known to be losing.
                 // Start with the ones that actually represent reaching the goal (which is a transition in this implementation as we can have
                 // nexts in the goal descriptions).
-                BF livetransitions = livenessGuarantees[j] & (nu2.getValue().SwapVariables(varVectorPre,varVectorPost));
+                BF livetransitions = livenessGuarantees[j] & (nu2.getValue().unprimeToPrime());
 
                 // Compute the middle least-fixed point (called 'Y' in the GR(1) paper)
                 BFFixedPoint mu1(mgr.constantFalse());
                 for (; !mu1.isFixedPointReached();) {
 
                     // Update the set of transitions that lead closer to the goal.
-                    livetransitions |= mu1.getValue().SwapVariables(varVectorPre,varVectorPost);
+                    livetransitions |= mu1.getValue().unprimeToPrime();
 
                     // Iterate over the liveness assumptions. Store the positions that are found to be winning for *any*
                     // of them into the variable 'goodForAnyLivenessAssumption'.
@@ -136,12 +136,13 @@ public:
                         for (; !nu0.isFixedPointReached();) {
 
                             // Compute a set of paths that are safe to take - used for the enforceable predecessor operator ('cox')
-                            foundPaths = livetransitions | (nu0.getValue().SwapVariables(varVectorPre,varVectorPost) & !(livenessAssumptions[i]));
+                            foundPaths = livetransitions | (nu0.getValue().unprimeToPrime() & !(livenessAssumptions[i]));
 
                             // Update the inner-most fixed point with the result of applying the enforcable *BA* predecessor operator
                             // Exists setting to "before" outputs such that for all settings to inputs, exists setting to "after" outputs that enforces successor
 
-                            nu0.update((safetyEnv.Implies(safetySys & foundPaths)).ExistAbstract(varCubePostOutputA).UnivAbstract(varCubePostInput).ExistAbstract(varCubePostOutputB));
+                            nu0.update(BF::cox(safetyEnv,safetySys,foundPaths,varCubePostOutputA,varCubePostInput).ExistAbstract(varCubePostOutputB));
+                            traceFixedPointIteration("nu0",j,i,nu0.getValue(),&foundPaths);
                         }
 
                         // Update the set of positions that are winning for some liveness assumption
@@ -154,6 +155,7 @@ public:
 
                     // Update the moddle fixed point
                     mu1.update(goodForAnyLivenessAssumption);
+                    traceFixedPointIteration("mu1",j,-1,mu1.getValue());
                 }
 
                 // Update the set of positions that are winning for any goal for the outermost fixed point
@@ -162,6 +164,7 @@ public:
 
             // Update the outer-most fixed point
             nu2.update(nextContraintsForGoals);
+            traceFixedPointIteration("nu2",-1,-1,nu2.getValue());
         }
 
         // We found the set of winning positions
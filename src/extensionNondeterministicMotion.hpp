@@ -14,6 +14,7 @@ protected:
     using T::safetySys;
     using T::lineNumberCurrentlyRead;
     using T::addVariable;
+    using T::parseBooleanFormula;
     using T::livenessGuarantees;
     using T::livenessAssumptions;
     using T::variableNames;
@@ -27,6 +28,7 @@ protected:
     using T::varCubePreInput;
     using T::varCubePreOutput;
     using T::realizable;
+    using T::reportRealizability;
     using T::computeVariableInformation;
 
     // Own variables local to this plugin
@@ -44,106 +46,6 @@ public:
 
     XNonDeterministicMotion<T,initSpecialRoboticsSemantics>(std::list<std::string> &filenames): T(filenames) {}
 
-    /**
-     * @brief Recurse internal function to parse a Boolean formula from a line in the input file
-     * @param is the input stream from which the tokens in the line are read
-     * @param allowedTypes a list of allowed variable types - this allows to check that assumptions do not refer to 'next' output values.
-     * @param readBDDs a list of bdds that can be accessed by names
-     * @return a BF that represents the transition constraint read from the line
-     */
-    BF parseBooleanFormulaRecurseEx(std::istringstream &is,std::set<VariableType> &allowedTypes, std::vector<BF> &memory,const std::map<std::string,BF> &readBDDs) {
-        std::string operation = "";
-        is >> operation;
-        if (operation=="") {
-            SlugsException e(false);
-            e << "Error reading line " << lineNumberCurrentlyRead << ". Premature end of line.";
-            throw e;
-        }
-        if (operation=="|") return parseBooleanFormulaRecurseEx(is,allowedTypes,memory,readBDDs) | parseBooleanFormulaRecurseEx(is,allowedTypes,memory,readBDDs);
-        if (operation=="^") return parseBooleanFormulaRecurseEx(is,allowedTypes,memory,readBDDs) ^ parseBooleanFormulaRecurseEx(is,allowedTypes,memory,readBDDs);
-        if (operation=="&") return parseBooleanFormulaRecurseEx(is,allowedTypes,memory,readBDDs) & parseBooleanFormulaRecurseEx(is,allowedTypes,memory,readBDDs);
-        if (operation=="!") return !parseBooleanFormulaRecurseEx(is,allowedTypes,memory,readBDDs);
-        if (operation=="1") return mgr.constantTrue();
-        if (operation=="0") return mgr.constantFalse();
-
-        // Memory Functionality - Create Buffer
-        if (operation=="$") {
-            unsigned nofElements;
-            is >> nofElements;
-            if (is.fail()) {
-                SlugsException e(false);
-                e << "Error reading line " << lineNumberCurrentlyRead << ". Expected number of memory elements.";
-                throw e;
-            }
-            std::vector<BF> memoryNew(nofElements);
-            for (unsigned int i=0;i<nofElements;i++) {
-                memoryNew[i] = parseBooleanFormulaRecurseEx(is,allowedTypes,memoryNew,readBDDs);
-            }
-            return memoryNew[nofElements-1];
-        }
-
-        // Memory Functionality - Recall from Buffer
-        if (operation=="?") {
-            unsigned int element;
-            is >> element;
-            if (is.fail()) {
-                SlugsException e(false);
-                e << "Error reading line " << lineNumberCurrentlyRead << ". Expected number after memory recall operator '?'.";
-                throw e;
-            }
-            if (element>=memory.size()) {
-                SlugsException e(false);
-                e << "Error reading line " << lineNumberCurrentlyRead << ". Trying to recall a memory element that has not been stored (yet).";
-                throw e;
-            }
-            return memory[element];
-        }
-
-        // Is BDD?
-        auto it = readBDDs.find(operation);
-        if (it!=readBDDs.end()) {
-            return it->second;
-        }
-
-        // Has to be a variable!
-        for (unsigned int i=0;i<variableNames.size();i++) {
-            if (variableNames[i]==operation) {
-                if (allowedTypes.count(variableTypes[i])==0) {
-                    SlugsException e(false);
-                    e << "Error reading line " << lineNumberCurrentlyRead << ". The variable " << operation << " is not allowed for this type of expression.";
-                    throw e;
-                }
-                return variables[i];
-            }
-        }
-        SlugsException e(false);
-        e << "Error reading line " << lineNumberCurrentlyRead << ". The variable " << operation << " has not been found.";
-        throw e;
-    }
-
-    /**
-     * @brief Internal function for parsing a Boolean formula from a line in the input file - calls the recursive function to do all the work.
-     * @param currentLine the line to parse
-     * @param allowedTypes a list of allowed variable types - this allows to check that assumptions do not refer to 'next' output values.
-     * @param readBDDs a list of bdds that can be accessed by names
-     * @return a BF that represents the transition constraint read from the line
-     */
-    BF parseBooleanFormulaEx(std::string currentLine, std::set<VariableType> &allowedTypes, const std::map<std::string,BF> &readBDDs) {
-
-        std::istringstream is(currentLine);
-
-        std::vector<BF> memory;
-        BF result = parseBooleanFormulaRecurseEx(is,allowedTypes,memory,readBDDs);
-        assert(memory.size()==0);
-        std::string nextPart = "";
-        is >> nextPart;
-        if (nextPart=="") return result;
-
-        SlugsException e(false);
-        e << "Error reading line " << lineNumberCurrentlyRead << ". There are stray characters: '" << nextPart << "'";
-        throw e;
-    }
-
 
 
 
@@ -213,47 +115,31 @@ public:
                     }
                 } else {
                     if (readMode==0) {
-                        variables.push_back(mgr.newVariable());
-                        variableNames.push_back(currentLine);
-                        variableTypes.push_back(PreInput);
-                        variables.push_back(mgr.newVariable());
-                        variableNames.push_back(currentLine+"'");
-                        variableTypes.push_back(PostInput);
+                        addVariable(PreInput,currentLine);
+                        addVariable(PostInput,currentLine+"'");
                     } else if (readMode==1) {
-                        variables.push_back(mgr.newVariable());
-                        variableNames.push_back(currentLine);
-                        variableTypes.push_back(PreMotionState);
-                        variables.push_back(mgr.newVariable());
-                        variableNames.push_back(currentLine+"'");
-                        variableTypes.push_back(PostMotionState);
+                        addVariable(PreMotionState,currentLine);
+                        addVariable(PostMotionState,currentLine+"'");
                     } else if (readMode==2) {
-                        variables.push_back(mgr.newVariable());
-                        variableNames.push_back(currentLine);
-                        variableTypes.push_back(PreMotionControlOutput);
-                        variables.push_back(mgr.newVariable());
-                        variableNames.push_back(currentLine+"'");
-                        variableTypes.push_back(PostMotionControlOutput);
+                        addVariable(PreMotionControlOutput,currentLine);
+                        addVariable(PostMotionControlOutput,currentLine+"'");
                     } else if (readMode==3) {
-                        variables.push_back(mgr.newVariable());
-                        variableNames.push_back(currentLine);
-                        variableTypes.push_back(PreOtherOutput);
-                        variables.push_back(mgr.newVariable());
-                        variableNames.push_back(currentLine+"'");
-                        variableTypes.push_back(PostOtherOutput);
+                        addVariable(PreOtherOutput,currentLine);
+                        addVariable(PostOtherOutput,currentLine+"'");
                     } else if (readMode==4) {
                         std::set<VariableType> allowedTypes;
                         allowedTypes.insert(PreInput);
                         allowedTypes.insert(PreMotionState);
                         // allowedTypes.insert(PreMotionControlOutput); -> Is not taken into account
                         allowedTypes.insert(PreOtherOutput);
-                        initEnv &= parseBooleanFormulaEx(currentLine,allowedTypes,readBDDs);
+                        initEnv &= parseBooleanFormula(currentLine,allowedTypes,&readBDDs);
                     } else if (readMode==5) {
                         std::set<VariableType> allowedTypes;
                         allowedTypes.insert(PreInput);
                         allowedTypes.insert(PreMotionState);
                          // allowedTypes.insert(PreMotionControlOutput); -> Is not taken into account
                         allowedTypes.insert(PreOtherOutput);
-                        initSys &= parseBooleanFormulaEx(currentLine,allowedTypes,readBDDs);
+                        initSys &= parseBooleanFormula(currentLine,allowedTypes,&readBDDs);
                     } else if (readMode==6) {
                         std::set<VariableType> allowedTypes;
                         allowedTypes.insert(PreInput);
@@ -263,7 +149,7 @@ public:
                         allowedTypes.insert(PostInput);
                         allowedTypes.insert(PostMotionState);
                         allowedTypes.insert(PostOtherOutput);
-                        safetyEnv &= parseBooleanFormulaEx(currentLine,allowedTypes,readBDDs);
+                        safetyEnv &= parseBooleanFormula(currentLine,allowedTypes,&readBDDs);
                     } else if (readMode==7) {
                         std::set<VariableType> allowedTypes;
                         allowedTypes.insert(PreInput);
@@ -273,7 +159,7 @@ public:
                         allowedTypes.insert(PostInput);
                         allowedTypes.insert(PostMotionState);
                         allowedTypes.insert(PostOtherOutput);
-                        safetySys &= parseBooleanFormulaEx(currentLine,allowedTypes,readBDDs);
+                        safetySys &= parseBooleanFormula(currentLine,allowedTypes,&readBDDs);
                     } else if (readMode==8) {
                         std::set<VariableType> allowedTypes;
                         allowedTypes.insert(PreInput);
@@ -281,7 +167,7 @@ public:
                          // allowedTypes.insert(PreMotionControlOutput); -> Is not taken into account
                         allowedTypes.insert(PreOtherOutput);
                         allowedTypes.insert(PostInput);
-                        livenessAssumptions.push_back(parseBooleanFormulaEx(currentLine,allowedTypes,readBDDs));
+                        livenessAssumptions.push_back(parseBooleanFormula(currentLine,allowedTypes,&readBDDs));
                     } else if (readMode==9) {
                         std::set<VariableType> allowedTypes;
                         allowedTypes.insert(PreInput);
@@ -291,7 +177,7 @@ public:
                         allowedTypes.insert(PostInput);
                         allowedTypes.insert(PostMotionState);
                         allowedTypes.insert(PostOtherOutput);
-                        livenessGuarantees.push_back(parseBooleanFormulaEx(currentLine,allowedTypes,readBDDs));
+                        livenessGuarantees.push_back(parseBooleanFormula(currentLine,allowedTypes,&readBDDs));
                     } else if (readMode==10) {
                         if (currentLine.find(" ")==std::string::npos) {
                             std::cerr << "Error with line " << lineNumberCurrentlyRead << "!";
@@ -320,7 +206,7 @@ public:
                         }
                         readBDDs[bddName] = newBDD;
                         computeVariableInformation(); // Becuase varVectors are used below.
-                        readBDDs[bddName+"'"] = newBDD.SwapVariables(varVectorPre,varVectorPost);
+                        readBDDs[bddName+"'"] = newBDD.unprimeToPrime();
                     } else {
                         std::cerr << "Error with line " << lineNumberCurrentlyRead << "!";
                         throw "Found a line in the specification file that has no proper categorial context.";
@@ -379,7 +265,7 @@ public:
                 // Start computing the transitions that lead closer to the goal and lead to a position that is not yet known to be losing.
                 // Start with the ones that actually represent reaching the goal (which is a transition in this implementation as we can have
                 // nexts in the goal descriptions).
-                BF livetransitions = livenessGuarantees[j] & (nu2.getValue().SwapVariables(varVectorPre,varVectorPost));
+                BF livetransitions = livenessGuarantees[j] & (nu2.getValue().unprimeToPrime());
                 //BF_newDumpDot(*this,livetransitions,NULL,"/tmp/liveTransitions.dot");
 
                 // Compute the middle least-fixed point (called 'Y' in the GR(1) paper)
@@ -387,7 +273,7 @@ public:
                 for (;!mu1.isFixedPointReached();) {
 
                     // Update the set of transitions that lead closer to the goal.
-                    livetransitions |= mu1.getValue().SwapVariables(varVectorPre,varVectorPost);
+                    livetransitions |= mu1.getValue().unprimeToPrime();
 
                     // Iterate over the liveness assumptions. Store the positions that are found to be winning for *any*
                     // of them into the variable 'goodForAnyLivenessAssumption'.
@@ -403,14 +289,14 @@ public:
                         for (;!nu0.isFixedPointReached();) {
 
                             // Compute a set of paths that are safe to take - used for the enforceable predecessor operator ('cox')
-                            foundPaths = livetransitions | (nu0.getValue().SwapVariables(varVectorPre,varVectorPost) & !(livenessAssumptions[i]));
+                            foundPaths = livetransitions | (nu0.getValue().unprimeToPrime() & !(livenessAssumptions[i]));
                             foundPaths &= safetySys;
                             //BF_newDumpDot(*this,foundPaths,NULL,"/tmp/foundPathsPreRobot.dot");
                             foundPaths = robotAllowedMoves & robotBDD.Implies(foundPaths).UnivAbstract(varCubePostMotionState);
                             //BF_newDumpDot(*this,foundPaths,NULL,"/tmp/foundPathsPostRobot.dot");
 
                             // Update the inner-most fixed point with the result of applying the enforcable predecessor operator
-                            nu0.update(safetyEnv.Implies(foundPaths).ExistAbstract(varCubePostControllerOutput).UnivAbstract(varCubePostInput));
+                            nu0.update(BF::cox(safetyEnv,foundPaths,mgr.constantTrue(),varCubePostControllerOutput,varCubePostInput));
                         }
 
                         // Update the set of positions that are winning for some liveness assumption
@@ -445,7 +331,7 @@ public:
             result = initEnv.Implies(winningPositions.UnivAbstract(varCubePreOutput)).UnivAbstract(varCubePreInput);
 
         } else {
-            result = initEnv.Implies((winningPositions & initSys).ExistAbstract(varCubePreOutput)).UnivAbstract(varCubePreInput);
+            result = BF::cox(initEnv,initSys,winningPositions,varCubePreOutput,varCubePreInput);
         }
 
         // Get rid of the PreMotionState
@@ -492,11 +378,7 @@ public:
      */
     void execute() {
         checkRealizability();
-        if (realizable) {
-            std::cerr << "RESULT: Specification is realizable.\n";
-        } else {
-            std::cerr << "RESULT: Specification is unrealizable.\n";
-        }
+        reportRealizability();
     }
 
 
@@ -34,7 +34,7 @@ public:
         // Now add additional recovery transition...
         BFFixedPoint mu(winningPositions);
         while (!mu.isFixedPointReached()) {
-            BF additionalTransitions = mu.getValue().SwapVariables(varVectorPre,varVectorPost) ;
+            BF additionalTransitions = mu.getValue().unprimeToPrime() ;
             additionalTransitions &= safetySys;
             BF additionalStates = additionalTransitions.ExistAbstract(varCubePost);
             mu.update(additionalStates);
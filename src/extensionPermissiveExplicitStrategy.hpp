@@ -2,6 +2,8 @@
 #define __EXTENSION_PERMISSIVE_STRATEGY_HPP__
 
 #include "gr1context.hpp"
+#include "explicitStateTable.hpp"
+#include "bufferedOutputWriter.hpp"
 
 #include <string>
 
@@ -27,10 +29,7 @@ protected:
     using T::variableTypes;
     using T::realizable;
     using T::postVars;
-    using T::varCubePre;
     using T::variableNames;
-    using T::varVectorPre;
-    using T::varVectorPost;
     using T::varCubePostOutput;
     using T::varCubePostInput;
     using T::determinize;
@@ -83,28 +82,24 @@ public:
      *        "winningPositions" have been filled by the synthesis algorithm with meaningful data.
      * @param outputStream - Where the strategy shall be printed to.
      */
-    void computeAndPrintExplicitStateStrategy(std::ostream &outputStream) {        
+    void computeAndPrintExplicitStateStrategy(std::ostream &outputFile) {
+        BufferedOutputWriter outputStream(outputFile);
 
         // We don't want any reordering from this point onwards, as
         // the BDD manipulations from this point onwards are 'kind of simple'.
         mgr.setAutomaticOptimisation(false);
 
-        // List of states in existance so far. The first map
-        // maps from a BF node pointer (for the pre variable valuation) and a goal
-        // to a state number. The vector then contains the concrete valuation.
-        std::map<std::pair<size_t, unsigned int>, unsigned int > lookupTableForPastStates;
-        std::vector<BF> bfsUsedInTheLookupTable;
-        std::list<std::pair<size_t, unsigned int> > todoList;
+        // List of states in existance so far, consisting of the pre variable valuations
+        // and goals. The states that have not been processed yet form the to-do list.
+        ExplicitStateTable states(preVars.size());
 
         // Prepare initial to-do list from the allowed initial states
         BF todoInit = winningPositions;
+        std::vector<bool> valuation;
         while (!(todoInit.isFalse())) {
-            BF concreteState = determinize(todoInit,preVars);
-            std::pair<size_t, unsigned int> lookup = std::pair<size_t, unsigned int>(concreteState.getHashCode(),0);
-            lookupTableForPastStates[lookup] = bfsUsedInTheLookupTable.size();
-            bfsUsedInTheLookupTable.push_back(concreteState);
+            BF concreteState = determinize(todoInit,preVars,valuation);
+            states.insert(valuation,0);
             todoInit &= !concreteState;
-            todoList.push_back(lookup);
         }
 
         // Prepare positional strategies for the individual goals
@@ -128,11 +123,11 @@ public:
         }
 
         // Extract strategy
-        while (todoList.size()>0) {
-            std::pair<size_t, unsigned int> current = todoList.front();
-            todoList.pop_front();
-            unsigned int stateNum = lookupTableForPastStates[current];
-            BF currentPossibilities = bfsUsedInTheLookupTable[stateNum];
+        while (states.hasUnprocessedStates()) {
+            unsigned int stateNum = states.getNextUnprocessedState();
+            unsigned int currentGoal = states.getGoal(stateNum);
+            states.getValuation(stateNum,valuation);
+            BF currentPossibilities = mgr.computeMinterm(preVars,valuation);
 
             /*{
                 std::ostringstream filename;
@@ -141,8 +136,9 @@ public:
             }*/
 
             // Print state information
-            outputStream << "State " << stateNum << " with rank " << current.second << "\n";
+            outputStream << "State " << stateNum << " with rank " << currentGoal << "\n";
             bool first = true;
+            unsigned int preVarNumber = 0;
             for (unsigned int i=0;i<variables.size();i++) {
                 if (doesVariableInheritType(i,Pre)) {
                     if (first) {
@@ -151,7 +147,7 @@ public:
                         outputStream << ", ";
                     }
                     outputStream << variableNames[i] << ":";
-                    outputStream << (((currentPossibilities & variables[i]).isFalse())?"0":"1");
+                    outputStream << (valuation[preVarNumber++]?"1":"0");
                 }
             }
 
@@ -159,7 +155,7 @@ public:
             first = true;
 
             // Compute successors for all variables that allow these
-            currentPossibilities &= positionalStrategiesForTheIndividualGoals[current.second];
+            currentPossibilities &= positionalStrategiesForTheIndividualGoals[currentGoal];
             BF remainingTransitions =
                     (oneStepRecovery)?
                     currentPossibilities:
@@ -167,12 +163,12 @@ public:
 
             // Switching goals
             while (!(remainingTransitions.isFalse())) {
-                BF newCombination = determinize(remainingTransitions,postVars);
+                BF newCombination = determinize(remainingTransitions,postVars,valuation);
 
                 // Jump as much forward  in the liveness guarantee list as possible ("stuttering avoidance")
-                unsigned int nextLivenessGuarantee = current.second;
+                unsigned int nextLivenessGuarantee = currentGoal;
                 bool firstTry = true;
-                while (((nextLivenessGuarantee != current.second) || firstTry) && !((livenessGuarantees[nextLivenessGuarantee] & newCombination).isFalse())) {
+                while (((nextLivenessGuarantee != currentGoal) || firstTry) && !((livenessGuarantees[nextLivenessGuarantee] & newCombination).isFalse())) {
                     nextLivenessGuarantee = (nextLivenessGuarantee + 1) % livenessGuarantees.size();
                     firstTry = false;
                 }
@@ -180,22 +176,13 @@ public:
                 // Mark which input has been captured by this case
                 // ---- The following line is a modification for the maximally permissive strategy case.
                 BF inputCaptured = newCombination;
-                newCombination = newCombination.ExistAbstract(varCubePre).SwapVariables(varVectorPre,varVectorPost);
                 remainingTransitions &= !inputCaptured;
 
-                // Search for newCombination
-                unsigned int tn;
-                std::pair<size_t, unsigned int> target = std::pair<size_t, unsigned int>(newCombination.getHashCode(),nextLivenessGuarantee);
-                if (lookupTableForPastStates.count(target)==0) {
-                    tn = lookupTableForPastStates[target] = bfsUsedInTheLookupTable.size();
-                    bfsUsedInTheLookupTable.push_back(newCombination);
-                    todoList.push_back(target);
-                } else {
-                    tn = lookupTableForPastStates[target];
-                }
+                // Search for the successor state - the valuation of the post variables is the one of the pre variables there
+                unsigned int tn = states.insert(valuation,nextLivenessGuarantee).first;
 
                 // Print
-                outputStream << tn << std::endl;
+                outputStream << tn << "\n";
             }
             outputStream << "\n";
         }
@@ -27,14 +27,15 @@ public:
         computeWinningPositions();
 
         // Check if for every possible environment initial position the system has a good system initial position
-        BF result;
-        result = (initEnv & initSys).Implies(winningPositions).UnivAbstract(varCubePreOutput).UnivAbstract(varCubePreInput);
+        realizable = initialPositionsAreWinning(winningPositions);
+    }
+
+    bool initialPositionsAreWinning(BF const &positions) {
+        BF result = (initEnv & initSys).Implies(positions).UnivAbstract(varCubePreOutput).UnivAbstract(varCubePreInput);
 
         // Check if the result is well-defind. Might fail after an incorrect modification of the above algorithm
         if (!result.isConstant()) throw "Internal error: Could not establish realizability/unrealizability of the specification.";
-
-        // Return the result in Boolean form.
-        realizable = result.isTrue();
+        return result.isTrue();
     }
 
     static GR1Context* makeInstance(std::list<std::string> &filenames) {
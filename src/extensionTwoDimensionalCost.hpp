@@ -219,7 +219,7 @@ public:
         // In the following, "livenessGuarantees" will be used as they are -- so conjunct them with
         // the winning positions as post states
         for (unsigned int i=0;i<livenessGuarantees.size();i++) {
-            livenessGuarantees[i] &= winningPositions.SwapVariables(varVectorPre,varVectorPost);;
+            livenessGuarantees[i] &= winningPositions.unprimeToPrime();;
         }
 
         // First, check if the costly transitions made sense.
@@ -389,7 +389,7 @@ public:
                             BF transitions = mgr.constantFalse();
                             while (winningSCCStates != oldWinningSCCStates) {
                                 oldWinningSCCStates = winningSCCStates;
-                                transitions = nonTransitionalStatePreEncoding[livenessAssumption] & isInftyCostPreVars[0] & ((!safetyEnv) | (safetySys & (allowedEscapeTransitions | ((!livenessAssumptions[livenessAssumption]) & winningSCCStates.SwapVariables(varVectorPre,varVectorPost) & nonTransitionalStatePostEncoding[livenessAssumption] & isInftyCostPostVars[0]))));
+                                transitions = nonTransitionalStatePreEncoding[livenessAssumption] & isInftyCostPreVars[0] & ((!safetyEnv) | (safetySys & (allowedEscapeTransitions | ((!livenessAssumptions[livenessAssumption]) & winningSCCStates.unprimeToPrime() & nonTransitionalStatePostEncoding[livenessAssumption] & isInftyCostPostVars[0]))));
                                 winningSCCStates &= transitions.ExistAbstract(varCubePostOutput).UnivAbstract(varCubePostInput);
                             }
 
@@ -397,8 +397,8 @@ public:
                             //BF_newDumpDot(*this,transitions,"Pre Post",filename.str()+"transitiveBeforeClosure.dot");
 
                             // For computing the transitive closure, only the internal transitions are to be used.
-                            BF transitiveClosureInternaltransitions = winningSCCStates & winningSCCStates.SwapVariables(varVectorPre,varVectorPost);
-                            transitiveClosureInternaltransitions &= nonTransitionalStatePreEncoding[livenessAssumption] & ((!safetyEnv) | (safetySys & (((!livenessAssumptions[livenessAssumption]) & winningSCCStates.SwapVariables(varVectorPre,varVectorPost) & nonTransitionalStatePreEncoding[livenessAssumption] & isInftyCostPreVars[0])))) & nonTransitionalStatePostEncoding[livenessAssumption] & isInftyCostPostVars[0];
+                            BF transitiveClosureInternaltransitions = winningSCCStates & winningSCCStates.unprimeToPrime();
+                            transitiveClosureInternaltransitions &= nonTransitionalStatePreEncoding[livenessAssumption] & ((!safetyEnv) | (safetySys & (((!livenessAssumptions[livenessAssumption]) & winningSCCStates.unprimeToPrime() & nonTransitionalStatePreEncoding[livenessAssumption] & isInftyCostPreVars[0])))) & nonTransitionalStatePostEncoding[livenessAssumption] & isInftyCostPostVars[0];
                             BF transitiveClosureInternaltransitionsOld = mgr.constantFalse();
                             while (transitiveClosureInternaltransitions!=transitiveClosureInternaltransitionsOld) {
                                 transitiveClosureInternaltransitionsOld = transitiveClosureInternaltransitions;
@@ -415,7 +415,7 @@ public:
                                 (!safetyEnv)
                               | (safetySys
                                   & ((allowedEscapeTransitions & ((!nonTransitionalStatePostEncoding[livenessAssumption]) | livenessGuarantees[livenessGoal] | !isInftyCostPostVars[0]))
-                                    | ((!livenessAssumptions[livenessAssumption]) & winningSCCStates.SwapVariables(varVectorPre,varVectorPost) & reversibleTransitions & isInftyCostPostVars[0]))));
+                                    | ((!livenessAssumptions[livenessAssumption]) & winningSCCStates.unprimeToPrime() & reversibleTransitions & isInftyCostPostVars[0]))));
                             BF finalSCCStates = winningSCCStates & finalTransitions.ExistAbstract(varCubePostOutput).UnivAbstract(varCubePostInput);
 
                             //BF_newDumpDot(*this,finalSCCStates,"Pre Post",filename.str()+"finalSCCStates.dot");
@@ -447,8 +447,8 @@ public:
                         BF oldPositionsWinning = positionsAlreadyFoundToBeWinning;
                         while (winningPositionsNew!=winningPositionsOld) {
                             winningPositionsOld = winningPositionsNew;
-                            BF newWinningTransitions = (isInftyCostPreVars[0]) & safetySys & (allowedEndingTransitions | (winningPositionsNew.SwapVariables(varVectorPre,varVectorPost)));
-                            winningPositionsNew = ((!safetyEnv) | newWinningTransitions.ExistAbstract(varCubePostOutput)).UnivAbstract(varCubePostInput);
+                            BF newWinningTransitions = (isInftyCostPreVars[0]) & safetySys & (allowedEndingTransitions | (winningPositionsNew.unprimeToPrime()));
+                            winningPositionsNew = BF::cox(safetyEnv,newWinningTransitions,mgr.constantTrue(),varCubePostOutput,varCubePostInput);
                             strategyDumpingData.push_back(std::pair<int,BF>(livenessGoal,newWinningTransitions & winningPositionsNew & preTransitionalStateEncoding));
                             // std::cerr << "Added Strategy dumping data " << strategyDumpingData.size() << " at line " << __LINE__ << std::endl;
                             transitionsAlreadyFoundToBeWinning |= newWinningTransitions & winningPositionsNew & preTransitionalStateEncoding;
@@ -510,7 +510,7 @@ public:
                             // The upper bound is not quite what we need, rather the element before it
                             winningStateFinder--;
                             // std::cerr << "Found some transitions...\n";
-                            allowedEndingTransitions |= safetySys & winningStateFinder->second.SwapVariables(varVectorPre,varVectorPost) & it->second;
+                            allowedEndingTransitions |= safetySys & winningStateFinder->second.unprimeToPrime() & it->second;
                             //BF_newDumpDot(*this,winningStateFinder->second,"Pre Post",filename.str()+"winningStateFinder.dot");
                         }
                     }
@@ -524,8 +524,8 @@ public:
                     BF oldPositionsWinning = positionsAlreadyFoundToBeWinning;
                     while (winningPositionsNew!=winningPositionsOld) {
                         winningPositionsOld = winningPositionsNew;
-                        BF newWinningTransitions = preTransitionalStateEncoding & !isInftyCostPreVars[0] & safetySys & (allowedEndingTransitions | (transitionCosts[0.0] & winningPositionsNew.SwapVariables(varVectorPre,varVectorPost)));
-                        winningPositionsNew = ((!safetyEnv) | newWinningTransitions.ExistAbstract(varCubePostOutput)).UnivAbstract(varCubePostInput);
+                        BF newWinningTransitions = preTransitionalStateEncoding & !isInftyCostPreVars[0] & safetySys & (allowedEndingTransitions | (transitionCosts[0.0] & winningPositionsNew.unprimeToPrime()));
+                        winningPositionsNew = BF::cox(safetyEnv,newWinningTransitions,mgr.constantTrue(),varCubePostOutput,varCubePostInput);
                         strategyDumpingData.push_back(std::pair<int,BF>(livenessGoal,newWinningTransitions));
                         // std::cerr << "Added Strategy dumping data " << strategyDumpingData.size() << " at line " << __LINE__ << std::endl;
                         transitionsAlreadyFoundToBeWinning |= newWinningTransitions;
@@ -580,7 +580,7 @@ public:
                             BF transitions = mgr.constantFalse();
                             while (winningSCCStates != oldWinningSCCStates) {
                                 oldWinningSCCStates = winningSCCStates;
-                                transitions = nonTransitionalStatePreEncoding[livenessAssumption] & !isInftyCostPreVars[0] & ((!safetyEnv) | (safetySys & (allowedEscapeTransitions | ((!livenessAssumptions[livenessAssumption]) & winningSCCStates.SwapVariables(varVectorPre,varVectorPost) & cheapTransitions & nonTransitionalStatePostEncoding[livenessAssumption] & !isInftyCostPostVars[0]))));
+                                transitions = nonTransitionalStatePreEncoding[livenessAssumption] & !isInftyCostPreVars[0] & ((!safetyEnv) | (safetySys & (allowedEscapeTransitions | ((!livenessAssumptions[livenessAssumption]) & winningSCCStates.unprimeToPrime() & cheapTransitions & nonTransitionalStatePostEncoding[livenessAssumption] & !isInftyCostPostVars[0]))));
                                 winningSCCStates &= transitions.ExistAbstract(varCubePostOutput).UnivAbstract(varCubePostInput);
                             }
 
@@ -588,8 +588,8 @@ public:
                             //BF_newDumpDot(*this,transitions,"Pre Post",filename.str()+"transitiveBeforeClosure.dot");
 
                             // For computing the transitive closure, only the internal transitions are to be used.
-                            BF transitiveClosureInternaltransitions = (!winningPositionsFound[currentTuple]) & winningSCCStates & winningSCCStates.SwapVariables(varVectorPre,varVectorPost);
-                            transitiveClosureInternaltransitions &= nonTransitionalStatePreEncoding[livenessAssumption] & ((!safetyEnv) | (safetySys & (((!livenessAssumptions[livenessAssumption]) & winningSCCStates.SwapVariables(varVectorPre,varVectorPost) & cheapTransitions & nonTransitionalStatePreEncoding[livenessAssumption] & !isInftyCostPreVars[0])))) & nonTransitionalStatePostEncoding[livenessAssumption] & !isInftyCostPostVars[0];
+                            BF transitiveClosureInternaltransitions = (!winningPositionsFound[currentTuple]) & winningSCCStates & winningSCCStates.unprimeToPrime();
+                            transitiveClosureInternaltransitions &= nonTransitionalStatePreEncoding[livenessAssumption] & ((!safetyEnv) | (safetySys & (((!livenessAssumptions[livenessAssumption]) & winningSCCStates.unprimeToPrime() & cheapTransitions & nonTransitionalStatePreEncoding[livenessAssumption] & !isInftyCostPreVars[0])))) & nonTransitionalStatePostEncoding[livenessAssumption] & !isInftyCostPostVars[0];
                             BF transitiveClosureInternaltransitionsOld = mgr.constantFalse();
                             while (transitiveClosureInternaltransitions!=transitiveClosureInternaltransitionsOld) {
                                 transitiveClosureInternaltransitionsOld = transitiveClosureInternaltransitions;
@@ -606,7 +606,7 @@ public:
                                 (!safetyEnv)
                               | (safetySys
                                   & ((allowedEscapeTransitions & ((!nonTransitionalStatePostEncoding[livenessAssumption]) | livenessGuarantees[livenessGoal] | isInftyCostPostVars[0]))
-                                    | ((!livenessAssumptions[livenessAssumption]) & winningSCCStates.SwapVariables(varVectorPre,varVectorPost) & reversibleTransitions & cheapTransitions & !isInftyCostPostVars[0]))));
+                                    | ((!livenessAssumptions[livenessAssumption]) & winningSCCStates.unprimeToPrime() & reversibleTransitions & cheapTransitions & !isInftyCostPostVars[0]))));
                             BF finalSCCStates = winningSCCStates & finalTransitions.ExistAbstract(varCubePostOutput).UnivAbstract(varCubePostInput);
 
                             //BF_newDumpDot(*this,finalSCCStates,"Pre Post",filename.str()+"finalSCCStates.dot");
@@ -638,8 +638,8 @@ public:
                         BF oldPositionsWinning = mgr.constantFalse();
                         while (winningPositionsNew!=winningPositionsOld) {
                             winningPositionsOld = winningPositionsNew;
-                            BF newWinningTransitions = (!(isInftyCostPreVars[0])) & safetySys & (allowedEndingTransitions | (transitionCosts[0.0] & winningPositionsNew.SwapVariables(varVectorPre,varVectorPost)));
-                            winningPositionsNew = ((!safetyEnv) | newWinningTransitions.ExistAbstract(varCubePostOutput)).UnivAbstract(varCubePostInput);
+                            BF newWinningTransitions = (!(isInftyCostPreVars[0])) & safetySys & (allowedEndingTransitions | (transitionCosts[0.0] & winningPositionsNew.unprimeToPrime()));
+                            winningPositionsNew = BF::cox(safetyEnv,newWinningTransitions,mgr.constantTrue(),varCubePostOutput,varCubePostInput);
                             strategyDumpingData.push_back(std::pair<int,BF>(livenessGoal,newWinningTransitions & winningPositionsNew & preTransitionalStateEncoding));
                             // std::cerr << "Added Strategy dumping data " << strategyDumpingData.size() << " at line " << __LINE__ << std::endl;
                             transitionsAlreadyFoundToBeWinning |= newWinningTransitions & winningPositionsNew & preTransitionalStateEncoding;
@@ -735,9 +735,7 @@ public:
     void checkRealizability() {
         if (isSysInitRoboticsSemantics) {
             T::computeWinningPositions();
-            BF result = (initEnv & initSys).Implies(winningPositions).UnivAbstract(varCubePre);
-            if (!result.isConstant()) throw "Internal error: Could not establish realizability/unrealizability of the specification.";
-            realizable = result.isTrue();
+            realizable = initialPositionsAreWinning(winningPositions);
             if (realizable) {
                 computeCostOptimalStrategy();
             }
@@ -749,6 +747,14 @@ public:
         }
     }
 
+    //! Checks the initial positions with the robotics semantics if the respective template parameter is set.
+    bool initialPositionsAreWinning(BF const &positions) {
+        if (!isSysInitRoboticsSemantics) return T::initialPositionsAreWinning(positions);
+        BF result = (initEnv & initSys).Implies(positions).UnivAbstract(varCubePre);
+        if (!result.isConstant()) throw "Internal error: Could not establish realizability/unrealizability of the specification.";
+        return result.isTrue();
+    }
+
 };
 
 
@@ -8,8 +8,100 @@
 #include <set>
 #include <list>
 #include <vector>
+#include <memory>
+#include <fstream>
+#include <mutex>
+#include <chrono>
+#include <random>
+#include <limits>
+#include <sstream>
+#include <functional>
 #include "variableTypes.hpp"
 #include "variableManager.hpp"
+#include "slugsException.hpp"
+
+/**
+ * @brief Options that tune how the synthesis algorithm works internally, but that do not
+ *        change the set of plugins used. They are set in 'main.cpp' from the command line
+ *        before the context is instantiated, and apply to all contexts in the process.
+ */
+struct GR1SolverOptions {
+    bool partitionedTransitionRelation = false; //!< Use clustered safety constraints in the enforceable predecessor
+    unsigned int clusterSizeThreshold = 5000; //!< Maximal BDD size of a cluster of safety constraints
+    unsigned int nofGoalSolvingThreads = 1; //!< Number of threads that solve the liveness guarantees in parallel
+    unsigned int portfolioSize = 1; //!< Number of solver configurations that race to compute the winning positions
+    bool earlyUnrealizabilityExit = false; //!< Stop computing the winning positions once unrealizability is detected
+    bool chainedGoalFixedPoint = false; //!< Use chaining between the liveness assumptions in the middle fixed point
+    std::vector<std::string> variableOrder; //!< Names of the variables in the order to be used for the BF variables (if not empty)
+    std::string variableOrderOutputFilename; //!< Where to write the final variable order to (if not empty)
+    bool groupVariables = false; //!< Keep pre/post variable pairs and the bits of integer variables together during reordering
+    unsigned int randomSeed = 1; //!< Seed for the random choices of the contexts (see 'determinizeRandomized')
+    std::string compiledSpecificationOutputFilename; //!< Where to write the parsed specification to instead of performing synthesis (if not empty)
+    bool symbolicFrontierExtraction = false; //!< Compute the states of explicit-state strategies symbolically before enumerating them
+    bool binaryStrategyOutput = false; //!< Write explicit-state strategies in the binary strategy format (see "binaryStrategy.hpp")
+    bool minimizeExplicitStrategy = false; //!< Merge the states with the same future behavior in explicit-state strategies before printing them
+};
+
+/**
+ * @brief Writes one JSON record per line for every iteration of the fixed points in the synthesis algorithms.
+ *        Records can be written from multiple threads. Nothing is written unless the trace has been opened.
+ */
+class GR1SolverTrace {
+private:
+    std::ofstream file;
+    std::mutex fileMutex;
+    std::chrono::steady_clock::time_point startTime;
+public:
+    void open(std::string filename);
+    bool isOpen() const { return file.is_open(); }
+    void record(BFManager const &mgr, const char *fixedPoint, int goal, int assumption, BF const &value, BF const *foundPaths);
+};
+
+/**
+ * @brief Splits a line of a slugsin file into its whitespace-separated tokens.
+ *        The tokens are read directly from the character buffer of the line. The current
+ *        token is kept in a buffer that is reused for all tokens, so that no memory needs
+ *        to be allocated while parsing a line.
+ */
+class SlugsFormulaTokenizer {
+private:
+    const char *position;
+    const char *end;
+    std::string token;
+    unsigned int lineNumber; // Only used for error messages
+    static bool isSeparator(char c) { return (c==' ') || (c=='\t') || (c=='\r') || (c=='\n') || (c=='\v') || (c=='\f'); }
+public:
+    SlugsFormulaTokenizer(std::string const &line, unsigned int _lineNumber) : position(line.data()), end(line.data()+line.size()), lineNumber(_lineNumber) {}
+
+    //! Reads the next token. Returns false (and leaves the token empty) at the end of the line.
+    bool next() {
+        while ((position<end) && isSeparator(*position)) position++;
+        const char *start = position;
+        while ((position<end) && !isSeparator(*position)) position++;
+        token.assign(start,position-start);
+        return position>start;
+    }
+
+    //! Reads the next token as a non-negative number. Returns false if it is missing or not a number.
+    //! Throws a SlugsException if the number does not fit into an unsigned int.
+    bool nextNumber(unsigned int &number) {
+        if (!next()) return false;
+        number = 0;
+        for (char c : token) {
+            if ((c<'0') || (c>'9')) return false;
+            unsigned int digit = c-'0';
+            if (number>(std::numeric_limits<unsigned int>::max()-digit)/10) {
+                SlugsException e(false);
+                e << "Error reading line " << lineNumber << ". The number '" << token << "' is too large.";
+                throw e;
+            }
+            number = number*10 + digit;
+        }
+        return true;
+    }
+
+    std::string const &current() const { return token; }
+};
 
 /**
  * @brief Container class for all GR(1) synthesis related activities
@@ -43,6 +135,27 @@ protected:
     SlugsVectorOfVarBFs postOutputVars{PostOutput, this};
     //@}
 
+    //@{
+    /** @name Partitioned transition relation
+     *  The individual lines of the [ENV_TRANS] and [SYS_TRANS] sections are kept in 'safetyEnvParts' and
+     *  'safetySysParts' when loading the specification. If the 'partitionedTransitionRelation' solver option
+     *  is set, they are grouped into clusters before the realizability check, and every cluster comes with
+     *  the cube of post-variables that can be quantified away right after conjoining it. The "unclustered"
+     *  cubes contain the post-variables that do not occur in any cluster. The last two BFs store for which
+     *  safety constraints the clusters have been computed.
+     */
+    std::vector<BF> safetyEnvParts;
+    std::vector<BF> safetySysParts;
+    std::vector<BF> safetyEnvClusters;
+    std::vector<BF> safetySysClusters;
+    std::vector<BFVarCube> safetyEnvClusterCubes;
+    std::vector<BFVarCube> safetySysClusterCubes;
+    BFVarCube safetyEnvUnclusteredCube;
+    BFVarCube safetySysUnclusteredCube;
+    BF clusteredSafetyEnv;
+    BF clusteredSafetySys;
+    //@}
+
     //@{
     /** @name Information that is computed during realizability checking
      *  The following variables are set by the realizability checking part. The first one
@@ -50,9 +163,13 @@ protected:
      *  of BFs/BDDs that represent transitions in the game that shall be preferred over those
      *  that come later in the vector. The 'unsigned int' data type in the vector represents the goal
      *  that a BF refers to. The winningPositions BF represents which positions are winning for the system player.
+     *  If the 'earlyUnrealizabilityExit' solver option is set and the specification is found to be unrealizable,
+     *  winningPositions is only an over-approximation of the winning positions (see 'computeWinningPositions').
+     *  'realizabilityReported' tells if the realizability result has been reported with 'reportRealizability'.
      */
     std::vector<std::pair<unsigned int,BF> > strategyDumpingData;
     bool realizable;
+    bool realizabilityReported = false;
     BF winningPositions;
     //@}
 
@@ -60,27 +177,76 @@ protected:
     //! It allows us to get better error messages for parsing.
     unsigned int lineNumberCurrentlyRead;
 
+    //! The content hash of the specification file read by "init" - stored in compiled specifications
+    std::string specificationSourceHash;
+
     //@{
     /**
      * @name Internal functions - these are used during parsing an input instance
      */
-    BF parseBooleanFormulaRecurse(std::istringstream &is,std::set<VariableType> &allowedTypes, std::vector<BF> &memory);
-    BF parseBooleanFormula(std::string currentLine,std::set<VariableType> &allowedTypes);
+    BF parseBooleanFormula(std::string const &currentLine,std::set<VariableType> &allowedTypes, const std::map<std::string,BF> *namedBFs = NULL);
+    bool loadCompiledSpecification(std::string const &filename, std::string const &expectedSourceHash);
+    bool isSlugsinFormula(std::string const &line) const;
+    void readStructuredSpecification(std::istream &inFile);
     //@}
 
+    //@{
+    /**
+     * @name Internal functions - these are used by the synthesis algorithm
+     */
+    void computeTransitionRelationClusters();
+    void computeClustersForQuantification(std::vector<BF> const &parts, VariableType quantifiedType, std::vector<BF> &clusters, std::vector<BFVarCube> &clusterCubes, BFVarCube &unclusteredCube);
+    BF enforceablePredecessor(BF const &transitions);
+    BF computeGoalFixedPoint(unsigned int goal, BF const &nu2Value, std::vector<std::pair<unsigned int,BF> > &strategyDumpingDataForGoal);
+    BF computeGoalFixedPointChained(unsigned int goal, BF const &nu2Value, std::vector<std::pair<unsigned int,BF> > &strategyDumpingDataForGoal);
+    void prepareGoalSolvingWorkers(std::vector<std::unique_ptr<GR1Context> > &workers);
+    BF computeGoalFixedPointsInParallel(BF const &nu2Value, std::vector<std::unique_ptr<GR1Context> > &workers);
+    void computeWinningPositionsWithPortfolio();
+    virtual void computeWinningPositionsWithoutPortfolio();
+    void reportRealizability();
+    //@}
+
+    //! The random number generator for the random choices of this context, seeded with the 'randomSeed' solver option
+    std::mt19937 randomGenerator{solverOptions.randomSeed};
+
+    /**
+     * @brief Records an iteration of a fixed point in the solver trace if it is enabled
+     * @param fixedPoint the name of the fixed point (such as "nu0")
+     * @param goal the liveness guarantee currently worked on (or -1 if not applicable)
+     * @param assumption the liveness assumption currently worked on (or -1 if not applicable)
+     * @param value the value of the fixed point after the iteration
+     * @param foundPaths the transitions computed in the iteration (or NULL if not applicable)
+     */
+    void traceFixedPointIteration(const char *fixedPoint, int goal, int assumption, BF const &value, BF const *foundPaths = NULL) {
+        if (solverTrace.isOpen()) solverTrace.record(mgr,fixedPoint,goal,assumption,value,foundPaths);
+    }
+
     //! A protected default constructor - to be used if input parsing is to be performed by
     //! the plugin, which must know what it is doing then!
     GR1Context() {}
 
 public:
+    static GR1SolverOptions solverOptions;
+    static GR1SolverTrace solverTrace;
+
+    //! Creates the contexts that race in "computeWinningPositionsWithPortfolio", with or without fixed point recycling.
+    //! Set by the caller so that the members use the same plugins as the context that runs the portfolio.
+    static std::function<GR1Context*(bool useFixedPointRecycling)> portfolioMemberFactory;
+
     GR1Context(std::list<std::string> &filenames);
     virtual ~GR1Context() {}
     virtual void computeWinningPositions();
     virtual void checkRealizability();
+    virtual bool initialPositionsAreWinning(BF const &positions);
     virtual void execute();
-    static BF determinize(BF in, std::vector<BF> vars);
-    static BF determinizeRandomized(BF in, std::vector<BF> vars);
+    static BF determinize(BF const &in, std::vector<BF> const &vars);
+    static BF determinize(BF const &in, std::vector<BF> const &vars, std::vector<bool> &valuation);
+    static BF determinizeRandomized(BF const &in, std::vector<BF> const &vars, std::mt19937 &generator);
     virtual void init(std::list<std::string> &filenames);
+    void saveCompiledSpecification(std::string const &filename) const;
+    static std::string computeFileContentHash(std::istream &inFile);
+    bool hasReportedRealizability() const { return realizabilityReported; }
+    bool isRealizable() const { return realizable; }
     
     static GR1Context* makeInstance(std::list<std::string> &filenames) {
         return new GR1Context(filenames);
@@ -109,24 +275,5 @@ public:
     BF getValue() { return currentValue; }
 };
 
-/**
- * @brief A customized class for Exceptions in Slugs - Can trigger printing the comman line parameters of Slugs
- */
-class SlugsException {
-private:
-    std::ostringstream message;
-    bool shouldPrintUsage;
-public:
-    SlugsException(bool _shouldPrintUsage) : shouldPrintUsage(_shouldPrintUsage) {}
-    SlugsException(bool _shouldPrintUsage, std::string msg) : shouldPrintUsage(_shouldPrintUsage) { message << msg; }
-    SlugsException(SlugsException const &other) : shouldPrintUsage(other.shouldPrintUsage) { message << other.message.str();}
-    bool getShouldPrintUsage() const { return shouldPrintUsage; }
-    SlugsException& operator<<(const std::string str) { message << str; return *this; }
-    SlugsException& operator<<(const double value) { message << value; return *this; }
-    SlugsException& operator<<(const int value) { message << value; return *this; }
-    SlugsException& operator<<(const unsigned int value) { message << value; return *this; }
-    std::string getMessage() { return message.str(); }
-};
-
 
 #endif
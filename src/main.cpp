@@ -35,6 +35,20 @@
 
 #include <fstream>
 #include <cstring>
+#include <cctype>
+#include <map>
+#include <algorithm>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+#include <chrono>
+#include <memory>
+#include <limits>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/asio.hpp>
+#include <boost/algorithm/string.hpp>
 #include "extensionComputeCNFFormOfTheSpecification.hpp"
 #include "extensionBiasForAction.hpp"
 #include "extensionExtractExplicitStrategy.hpp"
@@ -92,6 +106,50 @@ const char *commandLineArguments[] = {
     //-END-COMMAND-LINE-ARGUMENT-LIST
 };
 
+//===================================================================================
+// List of command line arguments that tune the solver
+//
+// -> These arguments do not select plugins and can be combined with all option
+//    combinations below. They are stored in "GR1Context::solverOptions", except
+//    for the "--bdd..." arguments, which are stored in
+//    "BFBddManager::defaultConfiguration".
+// -> The "--bdd..." arguments can also be given as environment variables, with
+//    the name derived from the argument (e.g., SLUGS_BDD_MAX_MEMORY for
+//    '--bddMaxMemory'). Command line arguments take precedence.
+// -> Every argument comes with the name of its value (or "" if there is none,
+//    otherwise the value is the next command line argument) and a description.
+//===================================================================================
+const char *solverTuningArguments[] = {
+    "--partitionedTransitions","","Keeps the safety assumptions and guarantees as clusters of constraints and computes the enforceable predecessor with early quantification instead of using monolithic transition relations. Only affects the standard realizability checking algorithm and '--fixedPointRecycling'.",
+    "--clusterSize","<nodes>","Maximal number of BDD nodes in a cluster when using '--partitionedTransitions'. The default value is 5000.",
+    "--threads","<n>","Solves the liveness guarantees in up to <n> parallel threads, each of which uses its own BDD manager. Only affects the standard realizability checking algorithm. The default value is 1.",
+    "--portfolio","<n>","Computes the winning positions with <n> solver configurations in parallel threads, each of which uses its own BDD manager, and continues with the result of the configuration that finishes first. The others are then cancelled. Every second configuration uses '--fixedPointRecycling' if the other options permit it, and all configurations use the plugins selected by the other options. The pairs of configurations take turns in using the reordering method chosen with '--bddReordering' and the methods 'sift', 'symmSift' and 'lazySift', and every second pair starts from a random variable order. The configuration that has finished first is reported. Only affects the standard realizability checking algorithm and '--fixedPointRecycling'. The default value is 1.",
+    "--chaining","","Adds the positions found for one liveness assumption to the target positions for the next liveness assumption right away, and only recomputes the innermost fixed points whose target positions have changed. Leads to a different (but still correct) strategy. Only affects the standard realizability checking algorithm.",
+    "--earlyExit","","Stops the realizability check as soon as the specification is known to be unrealizable. The winning positions are then not computed completely, so this option should only be used when only the realizability result is needed. Only affects the standard realizability checking algorithm.",
+    "--solverTrace","<file>","Writes a JSON record for every iteration of the fixed points computed during realizability checking to <file> (one per line), containing the goal and assumption worked on, the BDD sizes of the fixed point value and of the transitions found, the number of live BDD nodes, and the totals of the time since the start, the cache hit rate, and the number and duration of variable reorderings. Supported by the standard realizability checking algorithm and by '--fixedPointRecycling', '--counterStrategy', '--analyzeInterleaving' and '--IROSfastslow'.",
+    "--loadVariableOrder","<file>","Orders the BDD variables as given in <file> (one variable name per line, e.g., as written by '--saveVariableOrder') before using them. Variables that are not listed are placed after the variable declared before them. Dynamic reordering remains enabled.",
+    "--saveVariableOrder","<file>","Writes the final order of the BDD variables to <file> after the synthesis run.",
+    "--compileSpec","<file>","Parses the specification and writes the variables, the variable order and the BDDs of the specification to <file> in a binary format instead of performing synthesis. A compiled specification can be given to slugs instead of the specification itself. When <file> is the name of the specification with '.slugsin' replaced by '.slugsbin', later runs on the specification load <file> instead of parsing the specification as long as the specification has not been changed.",
+    "--groupVariables","","Uses group sifting for dynamic variable reordering, keeping every variable next to its primed copy and the bits of an integer variable together.",
+    "--symbolicExtraction","","Computes the reachable states of an explicit-state strategy ('--explicitStrategy') symbolically for all goals at once, and then enumerates the states and transitions from the resulting BDDs instead of computing the successors of every state one by one. The strategy is the same, but usually computed faster when it has many states.",
+    "--binaryStrategy","","Writes an explicit-state strategy ('--explicitStrategy') in a binary format instead of as text. The file consists of a table of the bit-packed states, the successor lists of the states, and an index for looking up states by their valuation and goal. It can be mapped into memory and read with the classes in 'src/binaryStrategy.hpp'. The script 'tools/convertExplicitStrategyToBinary.py' converts text and JSON strategies to this format.",
+    "--minimizeStrategy","","Minimizes an explicit-state strategy ('--explicitStrategy') before printing it, by merging the states that have the same valuation and whose successors can be merged as well. States that only differ in the goal that the system is currently working towards are often merged this way. The rank printed for a merged state is the one of the first merged state. The numbers of states before and after the minimization are reported.",
+    "--seed","<n>","Seed for the random choices made by '--computeInterestingRunOfTheSystem' and '--interactiveStrategy', so that runs can be reproduced. The default value is 1.",
+    "--bddMaxMemory","<MB>","Memory limit of every BDD manager in megabytes, which also bounds the growth of the unique table and the computed table. The default value is 3096.",
+    "--bddUniqueSlots","<n>","Initial number of slots of every subtable of the BDD unique table. The default value is 256.",
+    "--bddCacheSlots","<n>","Initial number of slots of the BDD computed table. The default value is 262144.",
+    "--bddMaxCacheSlots","<n>","Number of slots up to which the BDD computed table may grow. By default, this number is derived from the memory limit.",
+    "--bddMinHit","<percent>","Hit rate of the BDD computed table above which the table is grown. The default value is 1.",
+    "--bddLooseUpTo","<n>","Garbage collection threshold: up to this number of slots, the BDD unique table grows instead of collecting garbage when it fills up. By default, this number is derived from the memory limit.",
+    "--bddReordering","<method>","Method for dynamic BDD variable reordering: 'none', 'sift', 'siftConverge', 'symmSift', 'symmSiftConverge', 'groupSift', 'groupSiftConverge', 'window2', 'window3', 'window4', 'lazySift', 'annealing', 'genetic', 'linear', 'random' or 'exact'. The default value is 'sift'.",
+    "--bddReorderingThreshold","<nodes>","Number of BDD nodes at which the first dynamic variable reordering happens. The default value is 4004.",
+    "--bddAutoSizing","","Derives the BDD memory limit (3/4 of the physical memory), the initial table sizes and the first reordering threshold from the size of the specification file and the number of variables declared in it. Explicitly given '--bdd...' arguments take precedence.",
+    "--server","","Keeps slugs running and reads synthesis requests from stdin, one JSON object per line, each containing a specification (a file name in 'spec' or the specification itself in 'specText'), the plugin options in 'options', and further file names in 'files'. Every request is answered by one line of JSON on stdout that contains the realizability result and the output of the synthesizer. A request for a specification with the same contents as one of the 64 specifications processed most recently starts from the final variable order of the previous run for it. Plugin options and file names cannot be given on the command line in this mode.",
+    "--serverSocket","<file>","Like '--server', but reads the requests from the connections to the Unix domain socket <file> (one connection at a time), and writes the responses back to the connection.",
+    "--batch","<listfile>","Runs the chosen plugin options on all specifications listed in <listfile>, with one line per run that contains the input and output file names for the run (the specification first). Every run happens in a separate worker process. For every run, a line of JSON with the specification file name, the status ('ok', 'error' or 'crashed'), the realizability result, the time, the peak number of BDD nodes and the peak resident memory of the worker is written to stdout. The output of the synthesizer to stdout is discarded. No file names can be given on the command line in this mode.",
+    "--batchWorkers","<n>","Number of worker processes that perform runs in parallel with '--batch'. The default value is 1.",
+};
+
 //===================================================================================
 // List of combinations allowed
 //
@@ -252,6 +310,32 @@ OptionCombination optionCombinations[] = {
     //-END-OPTION-COMBINATION-LIST
 };
 
+/**
+ * @brief Prints a command line argument together with its description to stderr, wrapped
+ *        to 80 characters per line
+ */
+void printArgumentDescription(std::string argument, std::string description) {
+    unsigned int leftStuff = argument.size();
+    std::cerr << argument << " ";
+    std::istringstream is(description);
+    unsigned int left = 80-leftStuff-1;
+    while (!(is.eof())) {
+        std::string next;
+        is >> next;
+        if (next.size()<left) {
+            std::cerr << " " << next;
+            left -= next.size() + 1;
+        } else {
+            left = 80-leftStuff-1;
+            std::cerr << "\n";
+            for (unsigned int i=0;i<leftStuff+2;i++) std::cerr << " ";
+            std::cerr << next;
+            left -= next.size() + 1;
+        }
+    }
+    std::cerr << "\n";
+}
+
 /**
  * @brief Prints the help to stderr that the user sees when running "slugs --help" or when supplying
  *        incorrect parameters
@@ -261,27 +345,759 @@ void printToolUsageHelp() {
     std::cerr << "slugs [options] <FileNames> \n\n";
     std::cerr << "The first input file is supposed to be in 'slugs' format. The others are in the format required by the options used. \n\n";
     for (unsigned int i=0;i<sizeof(commandLineArguments)/sizeof(const char*);i+=2) {
-        unsigned int leftStuff = strlen(commandLineArguments[i]);
-        std::cerr << commandLineArguments[i] << " ";
-        std::istringstream is(commandLineArguments[i+1]);
-        unsigned int left = 80-leftStuff-1;
-        while (!(is.eof())) {
-            std::string next;
-            is >> next;
-            if (next.size()<left) {
-                std::cerr << " " << next;
-                left -= next.size() + 1;
+        printArgumentDescription(commandLineArguments[i],commandLineArguments[i+1]);
+    }
+    std::cerr << "\nThe following options tune the solver and can be combined with all of the above:\n\n";
+    for (unsigned int i=0;i<sizeof(solverTuningArguments)/sizeof(const char*);i+=3) {
+        std::string argument = solverTuningArguments[i];
+        if (strlen(solverTuningArguments[i+1])>0) argument = argument + " " + solverTuningArguments[i+1];
+        printArgumentDescription(argument,solverTuningArguments[i+2]);
+    }
+    std::cerr << "\n";
+}
+
+/**
+ * @brief Names of the methods for dynamic BDD variable reordering that can be given with '--bddReordering'
+ */
+const std::map<std::string,Cudd_ReorderingType> bddReorderingMethods = {
+    {"none",CUDD_REORDER_NONE},
+    {"sift",CUDD_REORDER_SIFT},
+    {"siftConverge",CUDD_REORDER_SIFT_CONVERGE},
+    {"symmSift",CUDD_REORDER_SYMM_SIFT},
+    {"symmSiftConverge",CUDD_REORDER_SYMM_SIFT_CONV},
+    {"groupSift",CUDD_REORDER_GROUP_SIFT},
+    {"groupSiftConverge",CUDD_REORDER_GROUP_SIFT_CONV},
+    {"window2",CUDD_REORDER_WINDOW2},
+    {"window3",CUDD_REORDER_WINDOW3},
+    {"window4",CUDD_REORDER_WINDOW4},
+    {"lazySift",CUDD_REORDER_LAZY_SIFT},
+    {"annealing",CUDD_REORDER_ANNEALING},
+    {"genetic",CUDD_REORDER_GENETIC},
+    {"linear",CUDD_REORDER_LINEAR},
+    {"random",CUDD_REORDER_RANDOM},
+    {"exact",CUDD_REORDER_EXACT}
+};
+
+/**
+ * @brief The "--bdd..." arguments that have been given on the command line or as environment variables (and are thus
+ *        not changed by '--bddAutoSizing')
+ */
+std::set<std::string> explicitBDDArguments;
+bool bddAutoSizing = false;
+
+/**
+ * @brief Whether slugs runs in server mode (see 'runServer'), and on which Unix domain socket (if not stdin/stdout)
+ */
+bool serverMode = false;
+std::string serverSocketFilename = "";
+
+/**
+ * @brief The list file for the batch mode (see 'runBatch'), if the batch mode is used, and the number of worker processes
+ */
+std::string batchListFilename = "";
+unsigned int batchWorkers = 1;
+
+/**
+ * @brief Applies a solver tuning argument (see 'solverTuningArguments') to the solver options
+ * @param arg the argument
+ * @param value the value of the argument (or "" if it does not take one)
+ */
+void applySolverTuningArgument(std::string arg, std::string value) {
+
+    // Parse numerical values
+    unsigned int numericalValue = 0;
+    if ((arg!="--solverTrace") && (arg!="--loadVariableOrder") && (arg!="--saveVariableOrder") && (arg!="--compileSpec") && (arg!="--bddReordering") && (arg!="--serverSocket") && (arg!="--batch")) {
+        // Stream extraction into an unsigned type accepts (and wraps around) negative numbers, so they are ruled
+        // out explicitly. The value is read into a wider type first to detect values that do not fit.
+        std::istringstream is(value);
+        unsigned long long wideValue = 0;
+        is >> wideValue;
+        numericalValue = static_cast<unsigned int>(wideValue);
+        if ((value!="") && (is.fail() || !is.eof() || (value.find('-')!=std::string::npos) || (wideValue>std::numeric_limits<unsigned int>::max()))) {
+            SlugsException e(true);
+            e << "Error: The value '" << value << "' given for the parameter '" << arg << "' is not a non-negative integer that fits into 32 bits.";
+            throw e;
+        }
+    }
+
+    if (arg=="--partitionedTransitions") {
+        GR1Context::solverOptions.partitionedTransitionRelation = true;
+    } else if (arg=="--clusterSize") {
+        GR1Context::solverOptions.clusterSizeThreshold = numericalValue;
+    } else if (arg=="--threads") {
+        GR1Context::solverOptions.nofGoalSolvingThreads = numericalValue;
+    } else if (arg=="--portfolio") {
+        GR1Context::solverOptions.portfolioSize = numericalValue;
+    } else if (arg=="--chaining") {
+        GR1Context::solverOptions.chainedGoalFixedPoint = true;
+    } else if (arg=="--earlyExit") {
+        GR1Context::solverOptions.earlyUnrealizabilityExit = true;
+    } else if (arg=="--solverTrace") {
+        GR1Context::solverTrace.open(value);
+    } else if (arg=="--loadVariableOrder") {
+        std::ifstream inFile(value.c_str());
+        if (inFile.fail()) {
+            SlugsException e(false);
+            e << "Error: Could not open the variable order file '" << value << "'.";
+            throw e;
+        }
+        std::string line;
+        while (std::getline(inFile,line)) {
+            boost::trim(line);
+            if (line!="") GR1Context::solverOptions.variableOrder.push_back(line);
+        }
+    } else if (arg=="--saveVariableOrder") {
+        GR1Context::solverOptions.variableOrderOutputFilename = value;
+    } else if (arg=="--compileSpec") {
+        GR1Context::solverOptions.compiledSpecificationOutputFilename = value;
+    } else if (arg=="--groupVariables") {
+        GR1Context::solverOptions.groupVariables = true;
+    } else if (arg=="--symbolicExtraction") {
+        GR1Context::solverOptions.symbolicFrontierExtraction = true;
+    } else if (arg=="--binaryStrategy") {
+        GR1Context::solverOptions.binaryStrategyOutput = true;
+    } else if (arg=="--minimizeStrategy") {
+        GR1Context::solverOptions.minimizeExplicitStrategy = true;
+    } else if (arg=="--seed") {
+        GR1Context::solverOptions.randomSeed = numericalValue;
+    } else if (arg=="--bddMaxMemory") {
+        BFBddManager::defaultConfiguration.maxMemoryInMB = numericalValue;
+    } else if (arg=="--bddUniqueSlots") {
+        BFBddManager::defaultConfiguration.uniqueSlots = numericalValue;
+    } else if (arg=="--bddCacheSlots") {
+        BFBddManager::defaultConfiguration.cacheSlots = numericalValue;
+    } else if (arg=="--bddMaxCacheSlots") {
+        BFBddManager::defaultConfiguration.maxCacheSlots = numericalValue;
+    } else if (arg=="--bddMinHit") {
+        BFBddManager::defaultConfiguration.minHit = numericalValue;
+    } else if (arg=="--bddLooseUpTo") {
+        BFBddManager::defaultConfiguration.looseUpTo = numericalValue;
+    } else if (arg=="--bddReordering") {
+        auto it = bddReorderingMethods.find(value);
+        if (it==bddReorderingMethods.end()) {
+            SlugsException e(true);
+            e << "Error: The value '" << value << "' given for the parameter '" << arg << "' is not a known reordering method.";
+            throw e;
+        }
+        BFBddManager::defaultConfiguration.reorderingMethod = it->second;
+    } else if (arg=="--bddReorderingThreshold") {
+        BFBddManager::defaultConfiguration.reorderingThreshold = numericalValue;
+    } else if (arg=="--bddAutoSizing") {
+        bddAutoSizing = true;
+    } else if (arg=="--server") {
+        serverMode = true;
+    } else if (arg=="--serverSocket") {
+        serverSocketFilename = value;
+    } else if (arg=="--batch") {
+        batchListFilename = value;
+    } else if (arg=="--batchWorkers") {
+        batchWorkers = numericalValue;
+    } else {
+        throw "Internal error: Solver tuning argument not handled.";
+    }
+    if (arg.substr(0,5)=="--bdd") explicitBDDArguments.insert(arg);
+}
+
+/**
+ * @brief Applies the "--bdd..." solver tuning arguments that are given as environment variables. The name of the
+ *        variable for an argument is "SLUGS_" followed by the argument in upper case, with an underscore in front of
+ *        every upper case letter of the argument (e.g., SLUGS_BDD_MAX_MEMORY for '--bddMaxMemory'). Arguments without
+ *        a value are applied if the variable is set to something else than "" or "0".
+ */
+void applySolverTuningEnvironmentVariables() {
+    for (unsigned int i=0;i<sizeof(solverTuningArguments)/sizeof(const char*);i+=3) {
+        std::string arg = solverTuningArguments[i];
+        if (arg.substr(0,5)!="--bdd") continue;
+        std::string variableName = "SLUGS_";
+        for (unsigned int j=2;j<arg.size();j++) {
+            if (isupper(arg[j])) variableName += "_";
+            variableName += toupper(arg[j]);
+        }
+        const char *value = getenv(variableName.c_str());
+        if (value==NULL) continue;
+        if (strlen(solverTuningArguments[i+1])>0) {
+            applySolverTuningArgument(arg,value);
+        } else if ((std::string(value)!="") && (std::string(value)!="0")) {
+            applySolverTuningArgument(arg,"");
+        }
+    }
+}
+
+/**
+ * @brief Chooses the configuration of the BDD managers from the size of the specification and the number of variables
+ *        declared in it (for '--bddAutoSizing'). Settings given explicitly by the user are left unchanged.
+ * @param specFilename the name of the specification file
+ */
+void autoSizeBDDManagers(std::string specFilename) {
+
+    std::ifstream inFile(specFilename.c_str());
+    if (inFile.fail()) return; // The error is reported when the specification is actually read
+    inFile.seekg(0,std::ios::end);
+    size_t fileSize = inFile.tellg();
+    inFile.seekg(0,std::ios::beg);
+
+    // Every line in an input or output section declares one Pre and one Post variable
+    size_t nofVariables = 0;
+    bool inDeclarationSection = false;
+    std::string line;
+    while (std::getline(inFile,line)) {
+        boost::trim(line);
+        if ((line.length()==0) || (line[0]=='#')) continue;
+        if (line[0]=='[') {
+            inDeclarationSection = (line.find("INPUT")!=std::string::npos) || (line.find("OUTPUT")!=std::string::npos);
+        } else if (inDeclarationSection) {
+            nofVariables += 2;
+        }
+    }
+
+    BFBddManagerConfiguration &configuration = BFBddManager::defaultConfiguration;
+    if (explicitBDDArguments.count("--bddMaxMemory")==0) {
+        size_t physicalMemoryInMB = (size_t)sysconf(_SC_PHYS_PAGES) / 1024 * (size_t)sysconf(_SC_PAGESIZE) / 1024;
+        configuration.maxMemoryInMB = std::max(configuration.maxMemoryInMB,physicalMemoryInMB / 4 * 3);
+    }
+    if (explicitBDDArguments.count("--bddUniqueSlots")==0) {
+        unsigned int slots = CUDD_UNIQUE_SLOTS;
+        while ((slots < (1U << 20)) && (slots < 4*fileSize/std::max(nofVariables,(size_t)1))) slots <<= 1;
+        configuration.uniqueSlots = slots;
+    }
+    if (explicitBDDArguments.count("--bddCacheSlots")==0) {
+        unsigned int slots = CUDD_CACHE_SLOTS;
+        while ((slots < (1U << 26)) && (slots < 8*fileSize)) slots <<= 1;
+        configuration.cacheSlots = slots;
+    }
+    if (explicitBDDArguments.count("--bddReorderingThreshold")==0) {
+        configuration.reorderingThreshold = std::max((size_t)4004,32*nofVariables);
+    }
+}
+
+/**
+ * @brief Information about a synthesis run (see 'runSynthesis') that is used by the server and batch modes
+ */
+struct SynthesisRunInformation {
+    std::vector<std::string> finalVariableOrder; //!< The names of the variables in their final BF variable order
+    long peakNofBDDNodes = 0; //!< The maximal number of BDD nodes allocated at the same time
+    std::string realizable = "null"; //!< The realizability result in JSON ("true" or "false"), or "null" if none has been reported
+};
+
+//! The type of the factories for the synthesizer objects in 'optionCombinations'
+typedef GR1Context* (*ContextFactory)(std::list<std::string> &filenames);
+
+/**
+ * @brief Looks up the factory for the synthesizer objects with the given combination of plugin parameters
+ * @param parameters the command line arguments that select the plugins (see 'commandLineArguments')
+ * @return the factory from 'optionCombinations', or NULL if the combination is not permissible
+ */
+ContextFactory findContextFactory(std::set<std::string> const &parameters) {
+
+    // Prepare list of parameters as string to look up the combination used in the list 'optionCombinations'
+    std::ostringstream os;
+    bool first = true;
+    for (auto it = parameters.begin();it!=parameters.end();it++) {
+        if (!first) {
+            os << " ";
+        } else {
+            first = false;
+        }
+        os << *it;
+    }
+    std::string totalParameters = os.str();
+    for (unsigned int i=0;i<sizeof(optionCombinations)/sizeof(OptionCombination);i++) {
+        if (optionCombinations[i].params==totalParameters) return optionCombinations[i].factory;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Instantiates a synthesizer object for the given plugin parameters and lets it process the given files.
+ *        Errors are reported on stderr.
+ * @param parameters the command line arguments that select the plugins (see 'commandLineArguments')
+ * @param filenames the names of the input and output files
+ * @param information if not NULL, information about the run is stored here if it has been successful
+ * @return the error code: >0 means that some error has occured. In case of realizability or unrealizability, a value of 0 is returned.
+ */
+int runSynthesis(std::set<std::string> const &parameters, std::list<std::string> filenames, SynthesisRunInformation *information = NULL) {
+
+    // Catch all errors from this point onwards
+    try {
+
+        if (bddAutoSizing && (filenames.size()>0)) autoSizeBDDManagers(filenames.front());
+
+        ContextFactory factory = findContextFactory(parameters);
+        if (factory==NULL) {
+            std::cerr << "Error: the chosen option combination is not permissible.\n";
+            return 1;
+        }
+
+        // The members of solver portfolios use the same plugins, with or without fixed point recycling if possible
+        GR1Context::portfolioMemberFactory = [parameters,factory](bool useFixedPointRecycling) {
+            std::set<std::string> memberParameters = parameters;
+            if (useFixedPointRecycling) {
+                memberParameters.insert("--fixedPointRecycling");
             } else {
-                left = 80-leftStuff-1;
-                std::cerr << "\n";
-                for (unsigned int i=0;i<leftStuff+2;i++) std::cerr << " ";
-                std::cerr << next;
-                left -= next.size() + 1;
+                memberParameters.erase("--fixedPointRecycling");
             }
+            ContextFactory memberFactory = findContextFactory(memberParameters);
+            std::list<std::string> noFilenames;
+            return (*((memberFactory!=NULL)?memberFactory:factory))(noFilenames);
+        };
+
+        // Instantiate context and perform synthesis.
+        std::unique_ptr<GR1Context> context((*factory)(filenames));
+        context->init(filenames);
+
+        // If after the "init" function chain of the context, there are
+        // some yet unused file names, then too many have been provided to the
+        // user.
+        if (filenames.size()>0) {
+            std::cerr << "Error: You provided too many file names!\n";
+            return 1;
+        }
+        context->computeVariableInformation();
+        if (GR1Context::solverOptions.variableOrder.size()>0) context->applyVariableOrder(GR1Context::solverOptions.variableOrder);
+        if (GR1Context::solverOptions.groupVariables) context->groupVariables();
+        if (GR1Context::solverOptions.compiledSpecificationOutputFilename!="") {
+            context->saveCompiledSpecification(GR1Context::solverOptions.compiledSpecificationOutputFilename);
+            return 0;
+        }
+        context->execute();
+        if (GR1Context::solverOptions.variableOrderOutputFilename!="") context->saveVariableOrder(GR1Context::solverOptions.variableOrderOutputFilename);
+        if (information!=NULL) {
+            information->finalVariableOrder = context->getVariableOrder();
+            information->peakNofBDDNodes = context->getPeakNofBDDNodes();
+            if (context->hasReportedRealizability()) information->realizable = context->isRealizable()?"true":"false";
         }
-        std::cerr << "\n";
+        return 0;
+
+    } catch (const char *error) {
+        std::cerr << "Error: " << error << std::endl;
+        return 1;
+    } catch (std::string error) {
+        std::cerr << "Error: " << error << std::endl;
+        return 1;
+    } catch (SlugsException e) {
+        std::cerr << "Error: " << e.getMessage() << std::endl;
+        if (e.getShouldPrintUsage()) {
+            std::cerr << std::endl;
+            printToolUsageHelp();
+        }
+        return 1;
+    } catch (BFDumpDotException e) {
+        std::cerr << "Error: " << e.getMessage() << std::endl;
+        return 1;
     }
-    std::cerr << "\n";
+}
+
+//===================================================================================
+// Server mode
+//
+// -> Every request is one line of JSON, and is answered by one line of JSON.
+// -> Requests: {"id": ..., "spec": <file name> or "specText": <specification>,
+//               "options": [<plugin options>], "files": [<further file names>]}
+//    or {"id": ..., "shutdown": true}.
+// -> Responses: {"id": ..., "status": "ok" or "error", "realizable": true, false
+//                or null, "time": <seconds>, "output": <what was written to
+//                stdout>, "messages": <what was written to stderr>}
+// -> The solver tuning arguments given on the command line apply to all requests.
+//===================================================================================
+
+/**
+ * @brief Escapes a string so that it can be written as a JSON string literal
+ * @param text the string to escape
+ * @return the escaped string, including the quotes
+ */
+std::string escapeJSONString(std::string const &text) {
+    std::ostringstream os;
+    os << "\"";
+    for (auto it = text.begin();it!=text.end();it++) {
+        switch (*it) {
+        case '"': os << "\\\""; break;
+        case '\\': os << "\\\\"; break;
+        case '\n': os << "\\n"; break;
+        case '\r': os << "\\r"; break;
+        case '\t': os << "\\t"; break;
+        default:
+            if ((unsigned char)(*it)<0x20) {
+                os << "\\u00" << "0123456789abcdef"[(*it)>>4] << "0123456789abcdef"[(*it) & 15];
+            } else {
+                os << *it;
+            }
+        }
+    }
+    os << "\"";
+    return os.str();
+}
+
+/**
+ * @brief The final variable orders of the previous requests in server mode, by the hash of the contents of the
+ *        specification (see 'GR1Context::computeFileContentHash'), so that a specification file that has changed
+ *        does not get the order of its old contents. Only the orders of the 'maxSize' specifications used most
+ *        recently are kept.
+ */
+class ServerVariableOrderCache {
+private:
+    static const unsigned int maxSize = 64;
+    std::list<std::pair<std::string,std::vector<std::string> > > orders; //!< Most recently used first
+    std::map<std::string,std::list<std::pair<std::string,std::vector<std::string> > >::iterator> ordersByHash;
+public:
+    //! Returns the order stored for the specification with the given hash (or NULL), which then counts as used most recently
+    std::vector<std::string> const *find(std::string const &hash) {
+        auto it = ordersByHash.find(hash);
+        if (it==ordersByHash.end()) return NULL;
+        orders.splice(orders.begin(),orders,it->second);
+        return &(it->second->second);
+    }
+    void store(std::string const &hash, std::vector<std::string> const &order) {
+        auto it = ordersByHash.find(hash);
+        if (it!=ordersByHash.end()) {
+            orders.erase(it->second);
+        } else if (orders.size()==maxSize) {
+            ordersByHash.erase(orders.back().first);
+            orders.pop_back();
+        }
+        orders.push_front(std::make_pair(hash,order));
+        ordersByHash[hash] = orders.begin();
+    }
+};
+
+/**
+ * @brief Processes a request in server mode. The output of the synthesizer is captured for the response.
+ * @param request the request (one line of JSON)
+ * @param variableOrders the final variable orders of the previous requests. A request starts with the order
+ *        that the previous request for a specification with the same contents ended with.
+ * @param shutdown is set to true if the request asks the server to shut down
+ * @return the response (one line of JSON)
+ */
+std::string processServerRequest(std::string const &request, ServerVariableOrderCache &variableOrders, bool &shutdown) {
+
+    std::ostringstream response;
+    boost::property_tree::ptree requestTree;
+    try {
+        std::istringstream is(request);
+        boost::property_tree::read_json(is,requestTree);
+    } catch (boost::property_tree::json_parser_error &e) {
+        response << "{\"status\": \"error\", \"messages\": " << escapeJSONString("Error: Cannot parse the request: "+e.message()) << "}";
+        return response.str();
+    }
+    response << "{\"id\": " << escapeJSONString(requestTree.get<std::string>("id","")) << ", ";
+
+    if (requestTree.get<bool>("shutdown",false)) {
+        shutdown = true;
+        response << "\"status\": \"ok\"}";
+        return response.str();
+    }
+
+    // Collect the options and file names
+    std::set<std::string> parameters;
+    std::list<std::string> filenames;
+    std::string errorMessage = "";
+    boost::property_tree::ptree noEntries;
+    for (auto &it : requestTree.get_child("options",noEntries)) {
+        std::string arg = it.second.data();
+        bool found = false;
+        for (unsigned int i=0;i<sizeof(commandLineArguments)/sizeof(const char*);i+=2) {
+            if (commandLineArguments[i] == arg) found = true;
+        }
+        if (!found) errorMessage = "Error: Parameter '" + arg + "' is unknown.";
+        parameters.insert(arg);
+    }
+    std::string specHash = "";
+    std::string temporarySpecFilename = "";
+    if (requestTree.count("spec")>0) {
+        filenames.push_back(requestTree.get<std::string>("spec"));
+        std::ifstream specFile(filenames.back().c_str());
+        if (!specFile.fail()) specHash = GR1Context::computeFileContentHash(specFile);
+    } else if (requestTree.count("specText")>0) {
+        std::string specText = requestTree.get<std::string>("specText");
+        std::istringstream specStream(specText);
+        specHash = GR1Context::computeFileContentHash(specStream);
+        char filename[] = "/tmp/slugsServerSpecXXXXXX";
+        int fd = mkstemp(filename);
+        if ((fd==-1) || (write(fd,specText.c_str(),specText.size())!=(ssize_t)specText.size())) {
+            errorMessage = "Error: Cannot write the specification to a temporary file.";
+        } else {
+            filenames.push_back(filename);
+        }
+        if (fd!=-1) {
+            close(fd);
+            temporarySpecFilename = filename;
+        }
+    } else {
+        errorMessage = "Error: The request contains neither 'spec' nor 'specText'.";
+    }
+    for (auto &it : requestTree.get_child("files",noEntries)) {
+        filenames.push_back(it.second.data());
+    }
+
+    if (errorMessage!="") {
+        if (temporarySpecFilename!="") unlink(temporarySpecFilename.c_str());
+        response << "\"status\": \"error\", \"messages\": " << escapeJSONString(errorMessage) << "}";
+        return response.str();
+    }
+
+    // Run the synthesizer, starting from the variable order of the previous request for the same specification
+    std::vector<std::string> commandLineVariableOrder = GR1Context::solverOptions.variableOrder;
+    std::vector<std::string> const *previousOrder = (specHash!="")?variableOrders.find(specHash):NULL;
+    if (previousOrder!=NULL) GR1Context::solverOptions.variableOrder = *previousOrder;
+
+    std::ostringstream capturedOutput;
+    std::ostringstream capturedMessages;
+    std::streambuf *coutBuffer = std::cout.rdbuf(capturedOutput.rdbuf());
+    std::streambuf *cerrBuffer = std::cerr.rdbuf(capturedMessages.rdbuf());
+    auto startTime = std::chrono::steady_clock::now();
+    int returnCode;
+    SynthesisRunInformation information;
+    try {
+        returnCode = runSynthesis(parameters,filenames,&information);
+    } catch (std::exception &e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        returnCode = 1;
+    }
+    std::chrono::duration<double> duration = std::chrono::steady_clock::now() - startTime;
+    std::cout.rdbuf(coutBuffer);
+    std::cerr.rdbuf(cerrBuffer);
+
+    GR1Context::solverOptions.variableOrder = commandLineVariableOrder;
+    if ((specHash!="") && (information.finalVariableOrder.size()>0)) variableOrders.store(specHash,information.finalVariableOrder);
+    if (temporarySpecFilename!="") unlink(temporarySpecFilename.c_str());
+
+    // Write the response
+    std::string messages = capturedMessages.str();
+    response << "\"status\": \"" << ((returnCode==0)?"ok":"error") << "\", \"realizable\": " << information.realizable;
+    response << ", \"time\": " << duration.count();
+    response << ", \"output\": " << escapeJSONString(capturedOutput.str());
+    response << ", \"messages\": " << escapeJSONString(messages) << "}";
+    return response.str();
+}
+
+/**
+ * @brief Answers the requests read from a stream, one per line, until the stream ends or a shutdown is requested
+ * @param in the stream to read from
+ * @param out the stream to write the responses to
+ * @param variableOrders the final variable orders of the previous requests
+ * @param shutdown is set to true if a request asks the server to shut down
+ */
+void serveRequests(std::istream &in, std::ostream &out, ServerVariableOrderCache &variableOrders, bool &shutdown) {
+    std::string line;
+    while (!shutdown && std::getline(in,line)) {
+        boost::trim(line);
+        if (line.length()==0) continue;
+        out << processServerRequest(line,variableOrders,shutdown) << std::endl;
+    }
+}
+
+/**
+ * @brief Runs the server mode - reads requests from stdin (for '--server') or from the connections to a Unix domain
+ *        socket (for '--serverSocket', one connection at a time).
+ * @return the error code: >0 means that some error has occured.
+ */
+int runServer() {
+    ServerVariableOrderCache variableOrders;
+    bool shutdown = false;
+
+    // The synthesizer writes to std::cout, which is redirected while processing a request
+    std::ostream responseStream(std::cout.rdbuf());
+    if (serverSocketFilename=="") {
+        serveRequests(std::cin,responseStream,variableOrders,shutdown);
+        return 0;
+    }
+
+    try {
+        boost::asio::io_context ioContext;
+        unlink(serverSocketFilename.c_str());
+        boost::asio::local::stream_protocol::acceptor acceptor(ioContext,boost::asio::local::stream_protocol::endpoint(serverSocketFilename));
+        while (!shutdown) {
+            boost::asio::local::stream_protocol::iostream connection;
+            acceptor.accept(connection.socket());
+            serveRequests(connection,connection,variableOrders,shutdown);
+        }
+        unlink(serverSocketFilename.c_str());
+    } catch (boost::system::system_error &e) {
+        std::cerr << "Error: Cannot serve requests on the socket '" << serverSocketFilename << "': " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+//===================================================================================
+// Batch mode
+//
+// -> Every line of the list file contains the file names for one run (the
+//    specification first, separated by whitespace). Empty lines and lines
+//    starting with '#' are ignored.
+// -> Every run happens in a separate worker process, so that crashes and
+//    memory exhaustion only affect the run in which they happen. Up to
+//    '--batchWorkers' runs happen at the same time.
+// -> A worker process is a fresh instance of slugs (started with 'execv'), so
+//    that its memory usage does not include the pages of the batch driver. It
+//    gets the command line arguments of the batch driver (without the batch
+//    mode arguments), preceded by '--batchWorkerResultFD <fd>', and followed
+//    by the file names of the run. It reports the result of the run to the
+//    batch driver over the file descriptor <fd>.
+// -> For every run, one line of JSON is written to stdout when it has
+//    finished: {"file": <specification>, "status": "ok", "error" or
+//    "crashed", "realizable": true, false or null, "time": <seconds>,
+//    "peakNodes": <BDD nodes>, "peakRSS": <kilobytes>, "message": <error
+//    message>}. What the synthesizer writes to stdout is discarded.
+//===================================================================================
+
+/**
+ * @brief Computes the peak resident set size of this process since it has been started with 'execv'. Unlike
+ *        'ru_maxrss', which Linux carries over from the process image before the 'execv' call (i.e., from the
+ *        batch driver that has forked the process), 'VmHWM' in '/proc/self/status' only covers the current image.
+ * @return the peak resident set size in kilobytes
+ */
+long getPeakRSSInKilobytes() {
+    std::ifstream statusFile("/proc/self/status");
+    std::string line;
+    while (std::getline(statusFile,line)) {
+        if (boost::starts_with(line,"VmHWM:")) {
+            std::istringstream is(line.substr(6));
+            long peakRSS = 0;
+            if (is >> peakRSS) return peakRSS;
+        }
+    }
+    struct rusage usage;
+    getrusage(RUSAGE_SELF,&usage);
+    return usage.ru_maxrss;
+}
+
+/**
+ * @brief Performs a run of the batch mode in a worker process and reports the result to the batch driver
+ * @param parameters the command line arguments that select the plugins
+ * @param filenames the file names for the run
+ * @param resultFD the file descriptor to write the result to, as the tab-separated list of the status, realizability
+ *        result, time, peak number of BDD nodes, and peak resident set size, followed by the error message (all in JSON)
+ */
+void runBatchWorker(std::set<std::string> const &parameters, std::list<std::string> const &filenames, int resultFD) {
+    std::ostringstream capturedOutput;
+    std::ostringstream capturedMessages;
+    std::cout.rdbuf(capturedOutput.rdbuf());
+    std::cerr.rdbuf(capturedMessages.rdbuf());
+    auto startTime = std::chrono::steady_clock::now();
+    int returnCode;
+    SynthesisRunInformation information;
+    try {
+        returnCode = runSynthesis(parameters,filenames,&information);
+    } catch (std::exception &e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        returnCode = 1;
+    }
+    std::chrono::duration<double> duration = std::chrono::steady_clock::now() - startTime;
+
+    std::string errorMessage = "";
+    if (returnCode!=0) {
+        errorMessage = capturedMessages.str().substr(0,1024);
+        boost::trim(errorMessage);
+    }
+    std::ostringstream result;
+    result << ((returnCode==0)?"ok":"error") << "\t" << information.realizable << "\t" << duration.count();
+    result << "\t" << information.peakNofBDDNodes << "\t" << getPeakRSSInKilobytes() << "\t" << escapeJSONString(errorMessage);
+    std::string resultString = result.str();
+    if (write(resultFD,resultString.c_str(),resultString.size())!=(ssize_t)resultString.size()) _exit(1);
+    close(resultFD);
+}
+
+/**
+ * @brief Runs the batch mode (see '--batch')
+ * @param workerArguments the command line arguments for the worker processes (all but the batch mode arguments)
+ * @return the error code: >0 means that some error has occured.
+ */
+int runBatch(std::vector<std::string> const &workerArguments) {
+
+    // Read the list of runs
+    std::vector<std::list<std::string> > runs;
+    std::ifstream listFile(batchListFilename.c_str());
+    if (listFile.fail()) {
+        std::cerr << "Error: Cannot open the batch list file '" << batchListFilename << "'." << std::endl;
+        return 1;
+    }
+    std::string line;
+    while (std::getline(listFile,line)) {
+        boost::trim(line);
+        if ((line.length()==0) || (line[0]=='#')) continue;
+        std::list<std::string> filenames;
+        boost::split(filenames,line,boost::is_any_of(" \t"),boost::token_compress_on);
+        runs.push_back(filenames);
+    }
+
+    // Start worker processes, and report the result of each one when it has terminated
+    struct RunningWorker {
+        unsigned int run;
+        int resultFD; // The file descriptor to read the result from
+    };
+    std::map<pid_t,RunningWorker> runningWorkers;
+    unsigned int nextRun = 0;
+    while ((nextRun<runs.size()) || (runningWorkers.size()>0)) {
+        while ((nextRun<runs.size()) && (runningWorkers.size()<std::max(batchWorkers,1U))) {
+
+            // The pipe is closed on 'execv' (so that the other workers do not inherit it), except for the
+            // end that the worker writes to
+            int resultPipe[2];
+            if (pipe2(resultPipe,O_CLOEXEC)!=0) {
+                std::cerr << "Error: Cannot create a pipe for a batch worker process." << std::endl;
+                return 1;
+            }
+            std::vector<std::string> arguments = {"slugs","--batchWorkerResultFD",std::to_string(resultPipe[1])};
+            arguments.insert(arguments.end(),workerArguments.begin(),workerArguments.end());
+            arguments.insert(arguments.end(),runs[nextRun].begin(),runs[nextRun].end());
+            std::vector<char*> argv;
+            for (auto &it : arguments) argv.push_back(const_cast<char*>(it.c_str()));
+            argv.push_back(NULL);
+
+            std::cout.flush();
+            std::cerr.flush();
+            pid_t pid = fork();
+            if (pid==0) {
+                fcntl(resultPipe[1],F_SETFD,0);
+                int nullFD = open("/dev/null",O_WRONLY);
+                if (nullFD!=-1) dup2(nullFD,STDOUT_FILENO);
+                execv("/proc/self/exe",&(argv[0]));
+                _exit(127);
+            }
+            close(resultPipe[1]);
+            if (pid<0) {
+                close(resultPipe[0]);
+                std::cerr << "Error: Cannot start a batch worker process." << std::endl;
+                return 1;
+            }
+            runningWorkers[pid] = RunningWorker{nextRun++,resultPipe[0]};
+        }
+
+        int status;
+        pid_t pid = waitpid(-1,&status,0);
+        if (pid<0) {
+            std::cerr << "Error: Waiting for the batch worker processes failed." << std::endl;
+            return 1;
+        }
+        auto worker = runningWorkers.find(pid);
+        if (worker==runningWorkers.end()) continue;
+
+        // Read the result
+        std::string result;
+        char buffer[4096];
+        ssize_t nofBytesRead;
+        while ((nofBytesRead = read(worker->second.resultFD,buffer,sizeof(buffer)))>0) result.append(buffer,nofBytesRead);
+        close(worker->second.resultFD);
+        std::vector<std::string> fields;
+        boost::split(fields,result,boost::is_any_of("\t"));
+
+        std::cout << "{\"file\": " << escapeJSONString(runs[worker->second.run].front());
+        if ((fields.size()==6) && WIFEXITED(status) && (WEXITSTATUS(status)==0)) {
+            std::cout << ", \"status\": \"" << fields[0] << "\", \"realizable\": " << fields[1] << ", \"time\": " << fields[2];
+            std::cout << ", \"peakNodes\": " << fields[3] << ", \"peakRSS\": " << fields[4] << ", \"message\": " << fields[5];
+        } else {
+            std::ostringstream message;
+            if (WIFSIGNALED(status)) {
+                message << "The worker process was terminated by signal " << WTERMSIG(status) << ".";
+            } else {
+                message << "The worker process did not report a result.";
+            }
+            std::cout << ", \"status\": \"crashed\", \"realizable\": null, \"message\": " << escapeJSONString(message.str());
+        }
+        std::cout << "}" << std::endl;
+        runningWorkers.erase(worker);
+    }
+    return 0;
 }
 
 /**
@@ -289,15 +1105,58 @@ void printToolUsageHelp() {
  * @return the error code: >0 means that some error has occured. In case of realizability or unrealizability, a value of 0 is returned.
  */
 int main(int argc, const char **args) {
-    std::cerr << "SLUGS: SmaLl bUt complete Gr(1) Synthesis tool (see the documentation for an author list).\n";
+
+    // Worker processes of the batch mode (see 'runBatch') get the file descriptor for the result first
+    int batchWorkerResultFD = -1;
+    int firstArgument = 1;
+    if ((argc>2) && (std::string(args[1])=="--batchWorkerResultFD")) {
+        batchWorkerResultFD = atoi(args[2]);
+        firstArgument = 3;
+    } else {
+        std::cerr << "SLUGS: SmaLl bUt complete Gr(1) Synthesis tool (see the documentation for an author list).\n";
+    }
 
     std::list<std::string> filenames;
     std::set<std::string> parameters;
 
+    // Environment variables come first, so that command line arguments can override them
+    try {
+        applySolverTuningEnvironmentVariables();
+    } catch (SlugsException e) {
+        std::cerr << e.getMessage() << "\n\n";
+        return 1;
+    }
+
     // Parse paramters
-    for (int i=1;i<argc;i++) {
+    for (int i=firstArgument;i<argc;i++) {
         std::string arg = args[i];
         if (arg[0]=='-') {
+
+            // Solver tuning arguments are not part of the option combination
+            bool isSolverTuningArgument = false;
+            for (unsigned int j=0;j<sizeof(solverTuningArguments)/sizeof(const char*);j+=3) {
+                if (solverTuningArguments[j] == arg) {
+                    isSolverTuningArgument = true;
+                    std::string value = "";
+                    if (strlen(solverTuningArguments[j+1])>0) {
+                        if (i+1==argc) {
+                            std::cerr << "Error: Parameter '" << arg << "' requires a value.\n\n";
+                            printToolUsageHelp();
+                            return 1;
+                        }
+                        value = args[++i];
+                    }
+                    try {
+                        applySolverTuningArgument(arg,value);
+                    } catch (SlugsException e) {
+                        std::cerr << e.getMessage() << "\n\n";
+                        if (e.getShouldPrintUsage()) printToolUsageHelp();
+                        return 1;
+                    }
+                }
+            }
+            if (isSolverTuningArgument) continue;
+
             bool found = false;
             for (unsigned int i=0;i<sizeof(commandLineArguments)/sizeof(const char*);i+=2) {
                 if (commandLineArguments[i] == arg) {
@@ -315,61 +1174,35 @@ int main(int argc, const char **args) {
         }
     }
 
-    // Catch all errors from this point onwards
-    try {
+    if (serverMode || (serverSocketFilename!="")) {
+        if ((filenames.size()>0) || (parameters.size()>0)) {
+            std::cerr << "Error: In server mode, the plugin options and file names are given in the requests.\n";
+            return 1;
+        }
+        return runServer();
+    }
 
-        // Prepare list of parameters as string to look up the combination used in the list 'optionCombinations'
-        std::ostringstream os;
-        bool first = true;
-        for (auto it = parameters.begin();it!=parameters.end();it++) {
-            if (!first) {
-                os << " ";
+    if (batchListFilename!="") {
+        if (filenames.size()>0) {
+            std::cerr << "Error: In batch mode, the file names are given in the batch list file.\n";
+            return 1;
+        }
+        std::vector<std::string> workerArguments;
+        for (int i=1;i<argc;i++) {
+            std::string arg = args[i];
+            if ((arg=="--batch") || (arg=="--batchWorkers")) {
+                i++;
             } else {
-                first = false;
+                workerArguments.push_back(arg);
             }
-            os << *it;
-        }
-        std::string totalParameters = os.str();
-        for (unsigned int i=0;i<sizeof(optionCombinations)/sizeof(OptionCombination);i++) {
-            if (optionCombinations[i].params==totalParameters) {
-
-                // Found the combination - then instantiate context and perform synthesis.
-                GR1Context *context = (*(optionCombinations[i].factory))(filenames);
-                context->init(filenames);
-
-                // If after the "init" function chain of the context, there are
-                // some yet unused file names, then too many have been provided to the
-                // user.
-                if (filenames.size()>0) {
-                    std::cerr << "Error: You provided too many file names!\n";
-                    return 1;
-                }
-                context->computeVariableInformation();
-                context->execute();
-                delete context;
-                return 0;
-            } // else { std::cerr << optionCombinations[i].params << ":" << totalParameters << "!\n"; }
         }
+        return runBatch(workerArguments);
+    }
 
-        std::cerr << "Error: the chosen option combination is not permissible.\n";
-        return 1;
-
-    } catch (const char *error) {
-        std::cerr << "Error: " << error << std::endl;
-        return 1;
-    } catch (std::string error) {
-        std::cerr << "Error: " << error << std::endl;
-        return 1;
-    } catch (SlugsException e) {
-        std::cerr << "Error: " << e.getMessage() << std::endl;
-        if (e.getShouldPrintUsage()) {
-            std::cerr << std::endl;
-            printToolUsageHelp();
-        }
-        return 1;
-    } catch (BFDumpDotException e) {
-        std::cerr << "Error: " << e.getMessage() << std::endl;
-        return 1;
+    if (batchWorkerResultFD!=-1) {
+        runBatchWorker(parameters,filenames,batchWorkerResultFD);
+        return 0;
     }
 
+    return runSynthesis(parameters,filenames);
 }
@@ -0,0 +1,29 @@
+//=====================================================================
+// The exception class of Slugs
+//=====================================================================
+#ifndef __SLUGS_EXCEPTION_HPP__
+#define __SLUGS_EXCEPTION_HPP__
+
+#include <string>
+#include <sstream>
+
+/**
+ * @brief A customized class for Exceptions in Slugs - Can trigger printing the comman line parameters of Slugs
+ */
+class SlugsException {
+private:
+    std::ostringstream message;
+    bool shouldPrintUsage;
+public:
+    SlugsException(bool _shouldPrintUsage) : shouldPrintUsage(_shouldPrintUsage) {}
+    SlugsException(bool _shouldPrintUsage, std::string msg) : shouldPrintUsage(_shouldPrintUsage) { message << msg; }
+    SlugsException(SlugsException const &other) : shouldPrintUsage(other.shouldPrintUsage) { message << other.message.str();}
+    bool getShouldPrintUsage() const { return shouldPrintUsage; }
+    SlugsException& operator<<(const std::string str) { message << str; return *this; }
+    SlugsException& operator<<(const double value) { message << value; return *this; }
+    SlugsException& operator<<(const int value) { message << value; return *this; }
+    SlugsException& operator<<(const unsigned int value) { message << value; return *this; }
+    std::string getMessage() { return message.str(); }
+};
+
+#endif
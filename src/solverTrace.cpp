@@ -0,0 +1,55 @@
+//=====================================================================
+// The JSON solver trace for the fixed point computations
+//=====================================================================
+#include "gr1context.hpp"
+
+#include <sstream>
+
+/**
+ * @brief The solver trace written by all contexts - see the "GR1SolverTrace" class.
+ */
+GR1SolverTrace GR1Context::solverTrace;
+
+/**
+ * @brief Opens the solver trace file. Times in the trace are given relative to the time of opening the file.
+ * @param filename the name of the trace file
+ */
+void GR1SolverTrace::open(std::string filename) {
+    file.open(filename.c_str());
+    if (file.fail()) {
+        SlugsException e(false);
+        e << "Error: Could not open the solver trace file '" << filename << "'.";
+        throw e;
+    }
+    startTime = std::chrono::steady_clock::now();
+}
+
+/**
+ * @brief Writes a record for an iteration of some fixed point. The statistics of the BF manager are those of the manager
+ *        that 'value' belongs to, i.e., they refer to the worker contexts when solving the goals in parallel. The time,
+ *        cache hit rate and reordering statistics are totals (since opening the trace file or since creating the manager,
+ *        respectively), which is why their fields are prefixed by "total".
+ * @param mgr the BF manager in which the fixed point is computed
+ * @param fixedPoint the name of the fixed point
+ * @param goal the liveness guarantee currently worked on (or -1 if not applicable)
+ * @param assumption the liveness assumption currently worked on (or -1 if not applicable)
+ * @param value the value of the fixed point after the iteration
+ * @param foundPaths the transitions computed in the iteration (or NULL if not applicable)
+ */
+void GR1SolverTrace::record(BFManager const &mgr, const char *fixedPoint, int goal, int assumption, BF const &value, BF const *foundPaths) {
+    std::ostringstream line;
+    line << "{\"fixedPoint\": \"" << fixedPoint << "\"";
+    if (goal>=0) line << ", \"goal\": " << goal;
+    if (assumption>=0) line << ", \"assumption\": " << assumption;
+    line << ", \"totalTime\": " << std::chrono::duration<double>(std::chrono::steady_clock::now()-startTime).count();
+    line << ", \"valueSize\": " << value.getSize();
+    if (foundPaths!=NULL) line << ", \"foundPathsSize\": " << foundPaths->getSize();
+    line << ", \"liveNodes\": " << mgr.getNofLiveNodes();
+    line << ", \"totalCacheHitRate\": " << mgr.getCacheHitRate();
+    line << ", \"totalReorderings\": " << mgr.getNofReorderings();
+    line << ", \"totalReorderingTime\": " << mgr.getReorderingTime() << "}\n";
+
+    std::lock_guard<std::mutex> lock(fileMutex);
+    file << line.str();
+    file.flush();
+}
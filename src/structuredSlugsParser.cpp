@@ -0,0 +1,527 @@
+//=====================================================================
+// Reading specifications in the structured slugs format
+//
+// -> Follows the translation of "tools/StructuredSlugsParser/compiler.py",
+//    but builds the BFs directly instead of writing a slugsin file:
+//    - Integer variables "x: min...max" are represented by the bits
+//      "x@0.min.max", "x@1", ..., "x@(n-1)", where n is the smallest number
+//      with 2^n > max-min.
+//    - Numbers are unsigned bit vectors (see "BFBitVector"), and every
+//      integer variable stands for its bits plus its minimal value.
+//    - Lines that are valid slugsin formulas are read as such.
+//    - Variable range constraints are added after the properties of the
+//      [ENV_INIT]/[SYS_INIT] and [ENV_TRANS]/[SYS_TRANS] sections.
+// -> In addition to the Python compiler, the exclusive disjunction "^" and
+//    the multiplication of numbers are supported.
+//=====================================================================
+#include "gr1context.hpp"
+#include <iostream>
+#include <functional>
+#include <cstdlib>
+#include <boost/algorithm/string.hpp>
+
+namespace {
+
+//! A token of a formula in the structured slugs format: a word, a number, or any other single character
+struct StructuredSlugsToken {
+    enum TokenType { Word, Number, Character } type;
+    std::string text;
+};
+
+//! An integer variable declared in a structured slugs specification
+struct StructuredSlugsIntegerVariable {
+    unsigned long minValue;
+    unsigned long maxValue;
+    std::vector<std::string> bitNames; //! Least significant bit first
+};
+
+/**
+ * @brief Recursive descent parser for the formulas in the structured slugs format. Uses the operator precedences
+ *        of "tools/StructuredSlugsParser/grammar.wi": from low to high, "<->", "->", "^", "|", "&", the temporal
+ *        operators "U" and "W", and the unary operators. Comparisons between numbers are atomic formulas.
+ */
+class StructuredSlugsFormulaParser {
+private:
+    BFManager const &mgr;
+    std::map<std::string,StructuredSlugsIntegerVariable> const &integerVariables;
+    std::function<BF(std::string const &)> lookupBooleanVariable;
+    unsigned int lineNumber;
+    std::vector<StructuredSlugsToken> tokens;
+    size_t position;
+
+    SlugsException error() const {
+        SlugsException e(false);
+        e << "Error reading line " << lineNumber << ". ";
+        return e;
+    }
+
+    //! Consumes the given sequence of character tokens if it comes next
+    bool acceptCharacters(const char *characters) {
+        size_t length = strlen(characters);
+        if (position+length>tokens.size()) return false;
+        for (size_t i=0;i<length;i++) {
+            if ((tokens[position+i].type!=StructuredSlugsToken::Character) || (tokens[position+i].text[0]!=characters[i])) return false;
+        }
+        position += length;
+        return true;
+    }
+
+    //! Consumes the given word if it comes next
+    bool acceptWord(const char *word) {
+        if ((position<tokens.size()) && (tokens[position].type==StructuredSlugsToken::Word) && (tokens[position].text==word)) {
+            position++;
+            return true;
+        }
+        return false;
+    }
+
+    static bool isKeyword(std::string const &word) {
+        return (word=="X") || (word=="F") || (word=="G") || (word=="U") || (word=="W") || (word=="FALSE") || (word=="TRUE")
+            || (word=="next") || (word=="LEASTSIGNIFICANTBITOVERWRITES");
+    }
+
+    SlugsException temporalOperatorError() const {
+        SlugsException e = error();
+        e << "Only GR(1) specification parts are supported - no temporal operators such as 'G', 'F', 'U', and 'W' can be used.";
+        return e;
+    }
+
+    BF parseBiimplication(bool isPrimed) {
+        BF result = parseImplication(isPrimed);
+        while (acceptCharacters("<-->") || acceptCharacters("<->")) {
+            result = !(result ^ parseImplication(isPrimed));
+        }
+        return result;
+    }
+
+    BF parseImplication(bool isPrimed) {
+        BF result = parseXor(isPrimed);
+        while (acceptCharacters("-->") || acceptCharacters("->")) {
+            // The overloaded (non-short-circuiting) '|' is intended - the right operand must always be parsed
+            result = (!result) | parseXor(isPrimed);
+        }
+        return result;
+    }
+
+    BF parseXor(bool isPrimed) {
+        BF result = parseDisjunction(isPrimed);
+        while (acceptCharacters("^")) {
+            result = result ^ parseDisjunction(isPrimed);
+        }
+        return result;
+    }
+
+    BF parseDisjunction(bool isPrimed) {
+        BF result = parseConjunction(isPrimed);
+        while (acceptCharacters("\\/") || acceptCharacters("||") || acceptCharacters("|")) {
+            result = result | parseConjunction(isPrimed);
+        }
+        return result;
+    }
+
+    BF parseConjunction(bool isPrimed) {
+        BF result = parseBinaryTemporalFormula(isPrimed);
+        while (acceptCharacters("/\\") || acceptCharacters("&&") || acceptCharacters("&")) {
+            result = result & parseBinaryTemporalFormula(isPrimed);
+        }
+        return result;
+    }
+
+    BF parseBinaryTemporalFormula(bool isPrimed) {
+        BF result = parseUnaryFormula(isPrimed);
+        if (acceptWord("U") || acceptWord("W")) throw temporalOperatorError();
+        return result;
+    }
+
+    BF parseUnaryFormula(bool isPrimed) {
+        if (acceptCharacters("!") || acceptCharacters("~")) return !parseUnaryFormula(isPrimed);
+        if (acceptWord("X") || acceptWord("next") || acceptCharacters("()")) {
+            if (isPrimed) {
+                SlugsException e = error();
+                e << "Nested next operators are not allowed.";
+                throw e;
+            }
+            return parseUnaryFormula(true);
+        }
+        if (acceptWord("F") || acceptWord("G") || acceptCharacters("<>") || acceptCharacters("[]")) throw temporalOperatorError();
+        return parseAtomicFormula(isPrimed);
+    }
+
+    BF parseAtomicFormula(bool isPrimed) {
+        if (acceptWord("TRUE")) return mgr.constantTrue();
+        if (acceptWord("FALSE")) return mgr.constantFalse();
+
+        // Comparison of numbers? Otherwise the tokens are read again as a Boolean formula.
+        size_t start = position;
+        BF result;
+        if (tryParseComparison(isPrimed,result)) return result;
+        position = start;
+
+        if (acceptCharacters("(")) {
+            result = parseBiimplication(isPrimed);
+            if (!acceptCharacters(")")) throw unexpectedTokenError("')'");
+            return result;
+        }
+        if (acceptCharacters("[")) {
+            result = parseBiimplication(isPrimed);
+            if (!acceptCharacters("]")) throw unexpectedTokenError("']'");
+            return result;
+        }
+        if ((position<tokens.size()) && (tokens[position].type==StructuredSlugsToken::Word) && !isKeyword(tokens[position].text)) {
+            std::string name = tokens[position++].text;
+            if (isPrimed) {
+                if (name.find('\'')!=std::string::npos) {
+                    SlugsException e = error();
+                    e << "The variable " << name << " is both primed and in the scope of a next operator.";
+                    throw e;
+                }
+                name = name + "'";
+            }
+            return lookupBooleanVariable(name);
+        }
+        throw unexpectedTokenError("a formula");
+    }
+
+    SlugsException unexpectedTokenError(const char *expected) const {
+        SlugsException e = error();
+        if (position<tokens.size()) {
+            e << "Expected " << expected << " but found '" << tokens[position].text << "'.";
+        } else {
+            e << "Expected " << expected << " but found the end of the line.";
+        }
+        return e;
+    }
+
+    /**
+     * @brief Parses a comparison of two numbers
+     * @return false if the next tokens do not start with a number expression that is followed by a comparison operator
+     */
+    bool tryParseComparison(bool isPrimed, BF &result) {
+        BFBitVector<BF> left(mgr.constantFalse());
+        if (!tryParseNumberExpression(isPrimed,left)) return false;
+        enum { Equal, Unequal, Smaller, SmallerEqual, Greater, GreaterEqual } comparison;
+        if (acceptCharacters("!=")) comparison = Unequal;
+        else if (acceptCharacters("<=")) comparison = SmallerEqual;
+        else if (acceptCharacters(">=")) comparison = GreaterEqual;
+        else if (acceptCharacters("<")) comparison = Smaller;
+        else if (acceptCharacters(">")) comparison = Greater;
+        else if (acceptCharacters("=")) comparison = Equal;
+        else return false;
+        BFBitVector<BF> right(mgr.constantFalse());
+        if (!tryParseNumberExpression(isPrimed,right)) throw unexpectedTokenError("a number expression");
+        switch (comparison) {
+        case Equal: result = (left==right); break;
+        case Unequal: result = (left!=right); break;
+        case Smaller: result = (left<right); break;
+        case SmallerEqual: result = (left<=right); break;
+        case Greater: result = (left>right); break;
+        case GreaterEqual: result = (left>=right); break;
+        }
+        return true;
+    }
+
+    //! Sums are read right-associatively, as in the Python compiler - this determines the number of bits of the result.
+    bool tryParseNumberExpression(bool isPrimed, BFBitVector<BF> &result) {
+        if (!tryParseMultiplicativeNumber(isPrimed,result)) return false;
+        if (acceptCharacters("+")) {
+            BFBitVector<BF> rest(mgr.constantFalse());
+            if (!tryParseNumberExpression(isPrimed,rest)) return false;
+            result = result + rest;
+        } else if ((position<tokens.size()) && (tokens[position].text=="-")) {
+            size_t start = position;
+            if (!acceptCharacters("->") && !acceptCharacters("-->")) {
+                SlugsException e = error();
+                e << "Subtraction is not supported.";
+                throw e;
+            }
+            position = start;
+        }
+        return true;
+    }
+
+    bool tryParseMultiplicativeNumber(bool isPrimed, BFBitVector<BF> &result) {
+        if (!tryParseLeastSignificantBitOverwriteExpression(isPrimed,result)) return false;
+        while (acceptCharacters("*")) {
+            BFBitVector<BF> factor(mgr.constantFalse());
+            if (!tryParseLeastSignificantBitOverwriteExpression(isPrimed,factor)) return false;
+            result = result * factor;
+        }
+        return true;
+    }
+
+    bool tryParseLeastSignificantBitOverwriteExpression(bool isPrimed, BFBitVector<BF> &result) {
+        if (!tryParseAtomicNumberExpression(isPrimed,result)) return false;
+        if (acceptWord("LEASTSIGNIFICANTBITOVERWRITES")) {
+            BFBitVector<BF> overwritten(mgr.constantFalse());
+            if (!tryParseAtomicNumberExpression(isPrimed,overwritten)) return false;
+            if (result.size()>=overwritten.size()) {
+                SlugsException e = error();
+                e << "The left operand of LEASTSIGNIFICANTBITOVERWRITES must have fewer bits than the right one.";
+                throw e;
+            }
+            result = result.overwriteLeastSignificantBits(overwritten);
+        }
+        return true;
+    }
+
+    bool tryParseAtomicNumberExpression(bool isPrimed, BFBitVector<BF> &result) {
+        if (position>=tokens.size()) return false;
+        StructuredSlugsToken const &token = tokens[position];
+        if (token.type==StructuredSlugsToken::Number) {
+            position++;
+            result = BFBitVector<BF>::constant(mgr,strtoul(token.text.c_str(),NULL,10));
+            return true;
+        }
+        if ((token.type==StructuredSlugsToken::Word) && !isKeyword(token.text)) {
+            std::string name = token.text;
+            bool primedLocally = boost::ends_with(name,"'");
+            if (primedLocally) name = name.substr(0,name.size()-1);
+            auto it = integerVariables.find(name);
+            if (it==integerVariables.end()) return false;
+            position++;
+            if (primedLocally && isPrimed) {
+                SlugsException e = error();
+                e << "The variable " << token.text << " is both primed and in the scope of a next operator.";
+                throw e;
+            }
+            std::vector<BF> bits;
+            for (auto const &bitName : it->second.bitNames) {
+                bits.push_back(lookupBooleanVariable((primedLocally || isPrimed) ? bitName+"'" : bitName));
+            }
+            result = BFBitVector<BF>(mgr.constantFalse(),bits) + BFBitVector<BF>::constant(mgr,it->second.minValue);
+            return true;
+        }
+        if (acceptCharacters("(")) {
+            if (!tryParseNumberExpression(isPrimed,result)) return false;
+            return acceptCharacters(")");
+        }
+        return false;
+    }
+
+public:
+    StructuredSlugsFormulaParser(BFManager const &_mgr, std::map<std::string,StructuredSlugsIntegerVariable> const &_integerVariables,
+        std::function<BF(std::string const &)> _lookupBooleanVariable, unsigned int _lineNumber, std::string const &line) :
+        mgr(_mgr), integerVariables(_integerVariables), lookupBooleanVariable(_lookupBooleanVariable), lineNumber(_lineNumber), position(0) {
+
+        // Tokenize the line
+        size_t i = 0;
+        while (i<line.size()) {
+            char c = line[i];
+            if (isspace((unsigned char)c)) {
+                i++;
+            } else if (isalpha((unsigned char)c) || (c=='_') || (c=='.') || (c=='\'') || (c=='@')) {
+                size_t start = i;
+                while ((i<line.size()) && (isalnum((unsigned char)line[i]) || (line[i]=='_') || (line[i]=='.') || (line[i]=='\'') || (line[i]=='@'))) i++;
+                tokens.push_back({StructuredSlugsToken::Word,line.substr(start,i-start)});
+            } else if (isdigit((unsigned char)c)) {
+                size_t start = i;
+                while ((i<line.size()) && isdigit((unsigned char)line[i])) i++;
+                tokens.push_back({StructuredSlugsToken::Number,line.substr(start,i-start)});
+            } else {
+                tokens.push_back({StructuredSlugsToken::Character,std::string(1,c)});
+                i++;
+            }
+        }
+    }
+
+    BF parse() {
+        BF result = parseBiimplication(false);
+        if (position<tokens.size()) {
+            SlugsException e = error();
+            e << "There are stray characters: '" << tokens[position].text << "'";
+            throw e;
+        }
+        return result;
+    }
+};
+
+}
+
+/**
+ * @brief Checks if a line in a structured slugs specification is a formula in slugsin format (like
+ *        "isValidRecursiveSlugsProperty" in the Python compiler does), so that it can be given to "parseBooleanFormula".
+ */
+bool GR1Context::isSlugsinFormula(std::string const &line) const {
+    std::vector<std::string> tokens;
+    boost::split(tokens,line,boost::is_space(),boost::token_compress_on);
+    int stackSize = 0;
+    for (auto it = tokens.rbegin();it!=tokens.rend();it++) {
+        std::string token = *it;
+        if (token=="") continue;
+        if (token=="$") return true;
+        if ((token=="|") || (token=="&") || (token=="^")) {
+            if (stackSize<2) return false;
+            stackSize--;
+        } else if ((token=="1") || (token=="0")) {
+            stackSize++;
+        } else if (token!="!") {
+            if (boost::ends_with(token,"'")) token = token.substr(0,token.size()-1);
+            if (lookupVariableNumber(token)<0) return false;
+            stackSize++;
+        }
+    }
+    return stackSize==1;
+}
+
+/**
+ * @brief Reads a specification in the structured slugs format - called by "init" for "*.structuredslugs" files
+ * @param inFile the input file
+ */
+void GR1Context::readStructuredSpecification(std::istream &inFile) {
+
+    // The sections that contain properties, in the order in which they are read, and the variable types that they may refer to
+    struct PropertySection { const char *name; std::vector<VariableType> allowedTypes; };
+    static const PropertySection propertySections[] = {
+        {"[ENV_TRANS]",{PreInput,PreOutput,PostInput}},
+        {"[ENV_INIT]",{PreInput}},
+        {"[SYS_TRANS]",{PreInput,PreOutput,PostInput,PostOutput}},
+        {"[SYS_INIT]",{PreInput,PreOutput}},
+        {"[ENV_LIVENESS]",{PreInput,PreOutput,PostInput,PostOutput}},
+        {"[SYS_LIVENESS]",{PreInput,PreOutput,PostInput,PostOutput}}
+    };
+
+    // Collect the lines of all sections first - properties may refer to variables declared further down
+    std::map<std::string,std::vector<std::pair<unsigned int,std::string> > > sectionLines;
+    std::string currentSection = "";
+    std::string currentLine;
+    lineNumberCurrentlyRead = 0;
+    while (std::getline(inFile,currentLine)) {
+        lineNumberCurrentlyRead++;
+        boost::trim(currentLine);
+        if ((currentLine.length()>0) && (currentLine[0]!='#')) {
+            if (currentLine[0]=='[') {
+                bool known = (currentLine=="[INPUT]") || (currentLine=="[OUTPUT]");
+                for (auto const &section : propertySections) known |= (currentLine==section.name);
+                if (!known) {
+                    std::cerr << "Sorry. Didn't recognize category " << currentLine << "\n";
+                    throw "Aborted.";
+                }
+                currentSection = currentLine;
+            } else if (currentSection=="") {
+                std::cerr << "Error with line " << lineNumberCurrentlyRead << "!";
+                throw "Found a line in the specification file that has no proper categorial context.";
+            } else {
+                sectionLines[currentSection].push_back(std::make_pair(lineNumberCurrentlyRead,currentLine));
+            }
+        }
+    }
+
+    // Declare the variables - inputs first
+    std::map<std::string,StructuredSlugsIntegerVariable> integerVariables;
+    std::vector<std::pair<std::string,std::string> > rangeConstraints; // Section and integer variable
+    for (int section=0;section<2;section++) {
+        bool isInput = (section==0);
+        for (auto const &line : sectionLines[isInput?"[INPUT]":"[OUTPUT]"]) {
+            lineNumberCurrentlyRead = line.first;
+            std::string name = line.second;
+            if ((name.find('\'')!=std::string::npos) || (name.find('@')!=std::string::npos)) {
+                SlugsException e(false);
+                e << "Error reading line " << lineNumberCurrentlyRead << ". The variable name " << name << " must not contain any \"'\" or \"@\" characters.";
+                throw e;
+            }
+
+            // Boolean variable?
+            size_t colon = name.find(':');
+            if (colon==std::string::npos) {
+                addVariable(isInput?PreInput:PreOutput,name);
+                addVariable(isInput?PostInput:PostOutput,name+"'");
+                continue;
+            }
+
+            // Integer variable "name:min...max"
+            std::string range = boost::trim_copy(name.substr(colon+1));
+            name = boost::trim_copy(name.substr(0,colon));
+            size_t dots = range.find("...");
+            StructuredSlugsIntegerVariable variable;
+            char *minEnd = NULL;
+            char *maxEnd = NULL;
+            std::string minString = boost::trim_copy(range.substr(0,dots));
+            std::string maxString = (dots==std::string::npos)?"":boost::trim_copy(range.substr(dots+3));
+            if ((dots!=std::string::npos) && (minString!="") && (maxString!="") && isdigit((unsigned char)minString[0]) && isdigit((unsigned char)maxString[0])) {
+                variable.minValue = strtoul(minString.c_str(),&minEnd,10);
+                variable.maxValue = strtoul(maxString.c_str(),&maxEnd,10);
+            }
+            if ((minEnd==NULL) || (*minEnd!=0) || (maxEnd==NULL) || (*maxEnd!=0) || (variable.minValue>variable.maxValue)) {
+                SlugsException e(false);
+                e << "Error reading line " << lineNumberCurrentlyRead << ". Integer variables must be declared as name:from...to, where the latter two are non-negative numbers and from<=to.";
+                throw e;
+            }
+
+            unsigned int nofBits = 0;
+            while ((nofBits<64) && ((1UL << nofBits) <= variable.maxValue-variable.minValue)) nofBits++;
+            for (unsigned int i=0;i<nofBits;i++) {
+                std::ostringstream bitName;
+                bitName << name << "@" << i;
+                if (i==0) bitName << "." << variable.minValue << "." << variable.maxValue;
+                variable.bitNames.push_back(bitName.str());
+                addVariable(isInput?PreInput:PreOutput,bitName.str());
+                addVariable(isInput?PostInput:PostOutput,bitName.str()+"'");
+            }
+            integerVariables[name] = variable;
+            if ((nofBits<64) && ((1UL << nofBits)!=variable.maxValue-variable.minValue+1)) {
+                rangeConstraints.push_back(std::make_pair(isInput?"ENV":"SYS",name));
+            }
+        }
+    }
+
+    // Read the properties
+    for (auto const &section : propertySections) {
+        std::set<VariableType> allowedTypes(section.allowedTypes.begin(),section.allowedTypes.end());
+        std::string sectionName = section.name;
+        std::vector<BF> parts;
+        for (auto const &line : sectionLines[sectionName]) {
+            lineNumberCurrentlyRead = line.first;
+            if (isSlugsinFormula(line.second)) {
+                parts.push_back(parseBooleanFormula(line.second,allowedTypes));
+            } else {
+                auto lookupBooleanVariable = [this,&allowedTypes](std::string const &name) {
+                    int varNumber = lookupVariableNumber(name);
+                    if (varNumber<0) {
+                        SlugsException e(false);
+                        e << "Error reading line " << lineNumberCurrentlyRead << ". The variable " << name << " has not been found.";
+                        throw e;
+                    }
+                    if (allowedTypes.count(variableTypes[varNumber])==0) {
+                        SlugsException e(false);
+                        e << "Error reading line " << lineNumberCurrentlyRead << ". The variable " << name << " is not allowed for this type of expression.";
+                        throw e;
+                    }
+                    return variables[varNumber];
+                };
+                parts.push_back(StructuredSlugsFormulaParser(mgr,integerVariables,lookupBooleanVariable,lineNumberCurrentlyRead,line.second).parse());
+            }
+        }
+
+        // Range constraints of integer variables: for the current values in the initialization, and for the next values in the transitions
+        bool isInit = boost::ends_with(sectionName,"_INIT]");
+        if (isInit || boost::ends_with(sectionName,"_TRANS]")) {
+            for (auto const &constraint : rangeConstraints) {
+                if (sectionName.substr(1,3)!=constraint.first) continue;
+                StructuredSlugsIntegerVariable const &variable = integerVariables[constraint.second];
+                std::vector<BF> bits;
+                for (auto const &bitName : variable.bitNames) {
+                    bits.push_back(variables[lookupVariableNumber(isInit ? bitName : bitName+"'")]);
+                }
+                parts.push_back(BFBitVector<BF>(mgr.constantFalse(),bits) < BFBitVector<BF>::constant(mgr,variable.maxValue-variable.minValue+1));
+            }
+        }
+
+        for (auto const &part : parts) {
+            if (sectionName=="[ENV_INIT]") {
+                initEnv &= part;
+            } else if (sectionName=="[SYS_INIT]") {
+                initSys &= part;
+            } else if (sectionName=="[ENV_TRANS]") {
+                safetyEnvParts.push_back(part);
+                safetyEnv &= part;
+            } else if (sectionName=="[SYS_TRANS]") {
+                safetySysParts.push_back(part);
+                safetySys &= part;
+            } else if (sectionName=="[ENV_LIVENESS]") {
+                livenessAssumptions.push_back(part);
+            } else {
+                livenessGuarantees.push_back(part);
+            }
+        }
+    }
+}
@@ -1,4 +1,12 @@
 #include "gr1context.hpp"
+#include <map>
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <exception>
+#include <iostream>
 
 /**
  * @brief Compute the winning positions. Stores the information that are later needed to
@@ -10,9 +18,32 @@
  *
  *        where the cox operator computes from which positions the system player can enforce that certain *transitions* are taken.
  *        the transitionTo function takes a set of target positions and computes the set of transitions that are allowed for
- *        the system and that lead to the set of target positions
+ *        the system and that lead to the set of target positions.
+ *        If the 'portfolioSize' solver option is greater than 1, several solver configurations are raced instead
+ *        (see 'computeWinningPositionsWithPortfolio').
  */
- void GR1Context::computeWinningPositions() {
+void GR1Context::computeWinningPositions() {
+    if (solverOptions.portfolioSize>1) {
+        computeWinningPositionsWithPortfolio();
+    } else {
+        computeWinningPositionsWithoutPortfolio();
+    }
+}
+
+/**
+ * @brief Computes the winning positions as described for 'computeWinningPositions' within this context alone.
+ *        Plugins that modify the fixed point computation itself (such as "extensionFixedPointRecycling.hpp")
+ *        override this function, so that their modification is also used by the members of solver portfolios.
+ */
+void GR1Context::computeWinningPositionsWithoutPortfolio() {
+
+    // Group the safety constraints into clusters if the enforceable predecessor is to be computed
+    // with a partitioned transition relation
+    if (solverOptions.partitionedTransitionRelation) computeTransitionRelationClusters();
+
+    // Prepare the contexts that solve the goals in parallel if multiple threads are to be used
+    std::vector<std::unique_ptr<GR1Context> > goalSolvingWorkers;
+    prepareGoalSolvingWorkers(goalSolvingWorkers);
 
     // The greatest fixed point - called "Z" in the GR(1) synthesis paper
     BFFixedPoint nu2(mgr.constantTrue());
@@ -30,81 +61,522 @@
         // Iterate over all of the liveness guarantees. Put the results into the variable 'nextContraintsForGoals' for every
         // goal. Then, after we have iterated over the goals, we can update nu2.
         BF nextContraintsForGoals = mgr.constantTrue();
-        for (unsigned int j=0;j<livenessGuarantees.size();j++) {
+        if (goalSolvingWorkers.size()>0) {
+            nextContraintsForGoals = computeGoalFixedPointsInParallel(nu2.getValue(),goalSolvingWorkers);
+        } else {
+            for (unsigned int j=0;j<livenessGuarantees.size();j++) {
+                nextContraintsForGoals &= computeGoalFixedPoint(j,nu2.getValue(),strategyDumpingData);
 
-            // Start computing the transitions that lead closer to the goal and lead to a position that is not yet known to be losing.
-            // Start with the ones that actually represent reaching the goal (which is a transition in this implementation as we can have
-            // nexts in the goal descriptions).
-            BF livetransitions = livenessGuarantees[j] & (nu2.getValue().SwapVariables(varVectorPre,varVectorPost));
+                // The greatest fixed point can only become smaller from now on. So if the initial positions
+                // are not all covered anymore, the remaining goals do not need to be analyzed.
+                if (solverOptions.earlyUnrealizabilityExit && !initialPositionsAreWinning(nextContraintsForGoals)) break;
+            }
+        }
 
-            // Compute the middle least-fixed point (called 'Y' in the GR(1) paper)
-            BFFixedPoint mu1(mgr.constantFalse());
-            for (;!mu1.isFixedPointReached();) {
+        // Stop if the specification is already known to be unrealizable. The winning positions are then only
+        // over-approximated, i.e., consumers of 'winningPositions' must not rely on them beyond the realizability result.
+        if (solverOptions.earlyUnrealizabilityExit && !initialPositionsAreWinning(nextContraintsForGoals)) {
+            winningPositions = nextContraintsForGoals;
+            return;
+        }
 
-                // Update the set of transitions that lead closer to the goal.
-                livetransitions |= mu1.getValue().SwapVariables(varVectorPre,varVectorPost);
+        // Update the outer-most fixed point
+        nu2.update(nextContraintsForGoals);
+        traceFixedPointIteration("nu2",-1,-1,nu2.getValue());
 
-                // Iterate over the liveness assumptions. Store the positions that are found to be winning for *any*
-                // of them into the variable 'goodForAnyLivenessAssumption'.
-                BF goodForAnyLivenessAssumption = mu1.getValue();
-                for (unsigned int i=0;i<livenessAssumptions.size();i++) {
+    }
 
-                    // Prepare the variable 'foundPaths' that contains the transitions that stay within the inner-most
-                    // greatest fixed point or get closer to the goal. Only used for strategy extraction
-                    BF foundPaths = mgr.constantTrue();
+    // We found the set of winning positions
+    winningPositions = nu2.getValue();
+}
 
-                    // Inner-most greatest fixed point. The corresponding variable in the paper would be 'X'.
-                    BFFixedPoint nu0(mgr.constantTrue());
-                    for (;!nu0.isFixedPointReached();) {
+/**
+ * @brief Computes the middle least fixed point (called 'Y' in the GR(1) synthesis paper) for one liveness guarantee,
+ *        i.e., the positions from which the system player can enforce reaching the goal (or violating some liveness
+ *        assumption) while staying within the positions given by the current value of the outermost greatest
+ *        fixed point.
+ * @param goal the number of the liveness guarantee
+ * @param nu2Value the current value of the outermost greatest fixed point (called 'Z' in the GR(1) synthesis paper)
+ * @param strategyDumpingDataForGoal the vector to which the strategy extraction data for this goal is appended
+ * @return the value of the middle least fixed point
+ */
+BF GR1Context::computeGoalFixedPoint(unsigned int goal, BF const &nu2Value, std::vector<std::pair<unsigned int,BF> > &strategyDumpingDataForGoal) {
+    if (solverOptions.chainedGoalFixedPoint) return computeGoalFixedPointChained(goal,nu2Value,strategyDumpingDataForGoal);
 
-                        // Compute a set of paths that are safe to take - used for the enforceable predecessor operator ('cox')
-                        foundPaths = livetransitions | (nu0.getValue().SwapVariables(varVectorPre,varVectorPost) & !(livenessAssumptions[i]));
-                        foundPaths &= safetySys;
+    // Start computing the transitions that lead closer to the goal and lead to a position that is not yet known to be losing.
+    // Start with the ones that actually represent reaching the goal (which is a transition in this implementation as we can have
+    // nexts in the goal descriptions).
+    BF livetransitions = livenessGuarantees[goal] & (nu2Value.unprimeToPrime());
 
-                        // Update the inner-most fixed point with the result of applying the enforcable predecessor operator
-                        nu0.update(safetyEnv.Implies(foundPaths).ExistAbstract(varCubePostOutput).UnivAbstract(varCubePostInput));
-                    }
+    // Compute the middle least-fixed point (called 'Y' in the GR(1) paper)
+    BFFixedPoint mu1(mgr.constantFalse());
+    for (;!mu1.isFixedPointReached();) {
 
-                    // Update the set of positions that are winning for some liveness assumption
-                    goodForAnyLivenessAssumption |= nu0.getValue();
+        // Update the set of transitions that lead closer to the goal.
+        livetransitions |= mu1.getValue().unprimeToPrime();
 
-                    // Dump the paths that we just wound into 'strategyDumpingData' - store the current goal long
-                    // with the BDD
-                    strategyDumpingData.push_back(std::pair<unsigned int,BF>(j,foundPaths));
-                }
+        // Iterate over the liveness assumptions. Store the positions that are found to be winning for *any*
+        // of them into the variable 'goodForAnyLivenessAssumption'.
+        BF goodForAnyLivenessAssumption = mu1.getValue();
+        for (unsigned int i=0;i<livenessAssumptions.size();i++) {
+
+            // Prepare the variable 'foundPaths' that contains the transitions that stay within the inner-most
+            // greatest fixed point or get closer to the goal. Only used for strategy extraction
+            BF foundPaths = mgr.constantTrue();
+
+            // Inner-most greatest fixed point. The corresponding variable in the paper would be 'X'.
+            BFFixedPoint nu0(mgr.constantTrue());
+            for (;!nu0.isFixedPointReached();) {
 
-                // Update the moddle fixed point
-                mu1.update(goodForAnyLivenessAssumption);
+                // Compute a set of paths that are safe to take - used for the enforceable predecessor operator ('cox')
+                foundPaths = livetransitions | (nu0.getValue().unprimeToPrime() & !(livenessAssumptions[i]));
+
+                // Update the inner-most fixed point with the result of applying the enforcable predecessor operator
+                nu0.update(enforceablePredecessor(foundPaths));
+                traceFixedPointIteration("nu0",goal,i,nu0.getValue(),&foundPaths);
             }
 
-            // Update the set of positions that are winning for any goal for the outermost fixed point
-            nextContraintsForGoals &= mu1.getValue();
+            // Only the paths that are allowed by the safety guarantees are used for strategy extraction
+            foundPaths &= safetySys;
+
+            // Update the set of positions that are winning for some liveness assumption
+            goodForAnyLivenessAssumption |= nu0.getValue();
+
+            // Dump the paths that we just wound into 'strategyDumpingData' - store the current goal long
+            // with the BDD
+            strategyDumpingDataForGoal.push_back(std::pair<unsigned int,BF>(goal,foundPaths));
         }
 
-        // Update the outer-most fixed point
-        nu2.update(nextContraintsForGoals);
+        // Update the moddle fixed point
+        mu1.update(goodForAnyLivenessAssumption);
+        traceFixedPointIteration("mu1",goal,-1,mu1.getValue());
+    }
+    return mu1.getValue();
+}
+
+/**
+ * @brief Variant of 'computeGoalFixedPoint' that is used when the 'chainedGoalFixedPoint' solver option is set.
+ *        Rather than computing the innermost greatest fixed points for all liveness assumptions in every iteration of
+ *        the middle least fixed point, the positions newly found for some liveness assumption are immediately
+ *        added to the target transitions for the next liveness assumption (chaining). An innermost fixed point is
+ *        only recomputed if the target transitions have changed since it was last computed for the same liveness
+ *        assumption, and the computation stops as soon as this is the case for none of them. As the
+ *        positions are only ever added if they are in the middle least fixed point, the result is the same as for
+ *        'computeGoalFixedPoint'. The strategy extraction data differs, but represents a strategy just as well: the
+ *        transitions in every element lead to positions found earlier or stay within the innermost fixed point.
+ *
+ *        Note that the innermost greatest fixed points cannot be started from their values in the previous
+ *        iteration, as these are under-approximations. Recycling over-approximations from previous iterations
+ *        of the outermost fixed point is what the '--fixedPointRecycling' plugin does.
+ * @param goal the number of the liveness guarantee
+ * @param nu2Value the current value of the outermost greatest fixed point (called 'Z' in the GR(1) synthesis paper)
+ * @param strategyDumpingDataForGoal the vector to which the strategy extraction data for this goal is appended
+ * @return the value of the middle least fixed point
+ */
+BF GR1Context::computeGoalFixedPointChained(unsigned int goal, BF const &nu2Value, std::vector<std::pair<unsigned int,BF> > &strategyDumpingDataForGoal) {
+
+    // Transitions that reach the goal or lead to a position already found to be in the middle fixed point
+    BF livetransitions = livenessGuarantees[goal] & (nu2Value.unprimeToPrime());
 
+    // The positions found so far and, for every liveness assumption, the transitions that the innermost fixed point
+    // has last been computed for.
+    BF mu1Value = mgr.constantFalse();
+    std::vector<BF> livetransitionsLastUsed(livenessAssumptions.size());
+
+    bool foundNewPositions = true;
+    while (foundNewPositions) {
+        foundNewPositions = false;
+        for (unsigned int i=0;i<livenessAssumptions.size();i++) {
+
+            // Nothing to do if the innermost fixed point would not change
+            if (livetransitionsLastUsed[i].isValid() && (livetransitionsLastUsed[i]==livetransitions)) continue;
+            livetransitionsLastUsed[i] = livetransitions;
+
+            // Inner-most greatest fixed point. The corresponding variable in the paper would be 'X'.
+            BF foundPaths = mgr.constantTrue();
+            BFFixedPoint nu0(mgr.constantTrue());
+            for (;!nu0.isFixedPointReached();) {
+                foundPaths = livetransitions | (nu0.getValue().unprimeToPrime() & !(livenessAssumptions[i]));
+                nu0.update(enforceablePredecessor(foundPaths));
+                traceFixedPointIteration("nu0",goal,i,nu0.getValue(),&foundPaths);
+            }
+            strategyDumpingDataForGoal.push_back(std::pair<unsigned int,BF>(goal,foundPaths & safetySys));
+
+            // Chaining: Only the new positions need to be added to the target transitions
+            BF newPositions = nu0.getValue() & !mu1Value;
+            if (!(newPositions.isFalse())) {
+                mu1Value |= newPositions;
+                livetransitions |= newPositions.unprimeToPrime();
+                foundNewPositions = true;
+            }
+        }
+        traceFixedPointIteration("mu1",goal,-1,mu1Value);
     }
+    return mu1Value;
+}
 
-    // We found the set of winning positions
-    winningPositions = nu2.getValue();
+/**
+ * @brief Prepares the contexts that solve the goals in parallel threads if the 'nofGoalSolvingThreads' solver
+ *        option is greater than 1. Every worker is a GR1Context with its own BF manager that holds the same
+ *        variables (see 'cloneVariablesInto'), safety constraints and liveness constraints as this context.
+ *        No workers are created if there is only a single goal. The workers get the termination flag of this
+ *        context's BF manager, so that they are cancelled along with it (e.g., when racing in a portfolio).
+ * @param workers where to store the workers
+ */
+void GR1Context::prepareGoalSolvingWorkers(std::vector<std::unique_ptr<GR1Context> > &workers) {
+    unsigned int nofWorkers = std::min(solverOptions.nofGoalSolvingThreads,(unsigned int)livenessGuarantees.size());
+    if (nofWorkers<2) return;
+
+    for (unsigned int w=0;w<nofWorkers;w++) {
+        std::unique_ptr<GR1Context> worker(new GR1Context());
+        cloneVariablesInto(*worker);
+        if (solverOptions.groupVariables) worker->groupVariables();
+        std::vector<int> correspondence = computeVariableCorrespondence(*worker);
+        worker->safetyEnv = safetyEnv.transferTo(worker->mgr,correspondence);
+        worker->safetySys = safetySys.transferTo(worker->mgr,correspondence);
+        for (auto &it : safetyEnvParts) worker->safetyEnvParts.push_back(it.transferTo(worker->mgr,correspondence));
+        for (auto &it : safetySysParts) worker->safetySysParts.push_back(it.transferTo(worker->mgr,correspondence));
+        for (auto &it : livenessAssumptions) worker->livenessAssumptions.push_back(it.transferTo(worker->mgr,correspondence));
+        for (auto &it : livenessGuarantees) worker->livenessGuarantees.push_back(it.transferTo(worker->mgr,correspondence));
+        if (solverOptions.partitionedTransitionRelation) worker->computeTransitionRelationClusters();
+        worker->mgr.setTerminationFlag(mgr.getTerminationFlag());
+        workers.push_back(std::move(worker));
+    }
 }
 
+/**
+ * @brief Computes the middle least fixed points for all goals in parallel, using the given worker contexts
+ *        (see 'prepareGoalSolvingWorkers'). Every worker runs in its own thread, copies over the current value
+ *        of the greatest fixed point, and takes the next goal that has not been taken yet until all goals have
+ *        been solved. The results are copied back by the calling thread once the workers are done, as BFs of
+ *        this context must not be created or freed by the workers. The strategy extraction data is then appended
+ *        to 'strategyDumpingData' in the order of the goals, so that it represents the same sequence of BFs
+ *        as when solving the goals one after the other. If the 'earlyUnrealizabilityExit' solver option is set,
+ *        copying back the results stops at the first goal after which the initial positions are no longer covered.
+ * @param nu2Value the current value of the outermost greatest fixed point (called 'Z' in the GR(1) synthesis paper)
+ * @param workers the workers
+ * @return the conjunction of the middle least fixed points of all goals
+ */
+BF GR1Context::computeGoalFixedPointsInParallel(BF const &nu2Value, std::vector<std::unique_ptr<GR1Context> > &workers) {
 
-void GR1Context::checkRealizability() {
+    // Solve the goals. The results are still stored in the managers of the workers.
+    std::vector<BF> goalResults(livenessGuarantees.size());
+    std::vector<unsigned int> workerOfGoal(livenessGuarantees.size());
+    std::vector<std::vector<std::pair<unsigned int,BF> > > goalStrategyDumpingData(livenessGuarantees.size());
+    std::atomic<unsigned int> nextGoal(0);
+    std::vector<std::exception_ptr> errors(workers.size());
+    std::vector<std::thread> threads;
+    for (unsigned int w=0;w<workers.size();w++) {
+        threads.push_back(std::thread([&,w]() {
+            try {
+                BF nu2ValueInWorker = nu2Value.transferTo(workers[w]->mgr,computeVariableCorrespondence(*(workers[w])));
+                for (unsigned int j=nextGoal++;j<livenessGuarantees.size();j=nextGoal++) {
+                    workerOfGoal[j] = w;
+                    goalResults[j] = workers[w]->computeGoalFixedPoint(j,nu2ValueInWorker,goalStrategyDumpingData[j]);
+                }
+            } catch (...) {
+                errors[w] = std::current_exception();
+            }
+        }));
+    }
+    for (auto &thread : threads) thread.join();
 
-    computeWinningPositions();
+    // Pass on the first error of a worker (e.g., if a BF manager ran out of memory)
+    for (auto &error : errors) {
+        if (error) std::rethrow_exception(error);
+    }
 
-    // Check if for every possible environment initial position the system has a good system initial position
-    BF result;
-    result = initEnv.Implies((winningPositions & initSys).ExistAbstract(varCubePreOutput)).UnivAbstract(varCubePreInput);
+    // Copy the results back in the order of the goals
+    std::vector<std::vector<int> > correspondences;
+    for (auto &worker : workers) correspondences.push_back(worker->computeVariableCorrespondence(*this));
+    BF nextContraintsForGoals = mgr.constantTrue();
+    for (unsigned int j=0;j<livenessGuarantees.size();j++) {
+        std::vector<int> const &correspondence = correspondences[workerOfGoal[j]];
+        nextContraintsForGoals &= goalResults[j].transferTo(mgr,correspondence);
+        for (auto &it : goalStrategyDumpingData[j]) {
+            strategyDumpingData.push_back(std::pair<unsigned int,BF>(it.first,it.second.transferTo(mgr,correspondence)));
+        }
+        if (solverOptions.earlyUnrealizabilityExit && !initialPositionsAreWinning(nextContraintsForGoals)) break;
+    }
+    return nextContraintsForGoals;
+}
+
+
+/**
+ * @brief Computes the winning positions with a portfolio of solver configurations, if the 'portfolioSize' solver
+ *        option is greater than 1. The running times of the configurations on a specification often differ by an
+ *        order of magnitude, and which one is the fastest is hard to predict. Every member of the portfolio is a context
+ *        created by 'portfolioMemberFactory' with its own BF manager that holds the same variables (see 'cloneVariablesInto')
+ *        and constraints as this context, and runs in its own thread. The members are built with the same plugins as this
+ *        context, so that plugin modifications such as the check of the initial positions for the 'earlyUnrealizabilityExit'
+ *        solver option remain in effect. The members differ as follows:
+ *        - Every second member uses fixed point recycling (see "extensionFixedPointRecycling.hpp").
+ *        - The pairs of members take turns in using the reordering methods in 'reorderingMethods' below, starting
+ *          with the one configured for all BF managers.
+ *        - Every second pair of members starts from a random variable order (see 'shuffleVariableOrder') rather
+ *          than from the current variable order of this context.
+ *        As soon as one member has computed the winning positions, the others are cancelled using CUDD's termination
+ *        callback. The winning positions and the strategy extraction data of the winner are then copied to this
+ *        context. If no member succeeds, the error of the first member is passed on.
+ */
+void GR1Context::computeWinningPositionsWithPortfolio() {
+
+    std::vector<Cudd_ReorderingType> reorderingMethods = {BFBddManager::defaultConfiguration.reorderingMethod};
+    for (Cudd_ReorderingType method : {CUDD_REORDER_SIFT,CUDD_REORDER_SYMM_SIFT,CUDD_REORDER_LAZY_SIFT}) {
+        if (method!=reorderingMethods[0]) reorderingMethods.push_back(method);
+    }
+
+    // Prepare the members
+    std::atomic<bool> raceFinished(false);
+    std::vector<std::unique_ptr<GR1Context> > members;
+    for (unsigned int i=0;i<solverOptions.portfolioSize;i++) {
+        std::unique_ptr<GR1Context> member(portfolioMemberFactory ? portfolioMemberFactory(i%2==1) : new GR1Context());
+        cloneVariablesInto(*member);
+        unsigned int pair = i/2;
+        member->mgr.setReorderingMethod(reorderingMethods[pair % reorderingMethods.size()]);
+        if (pair%2==1) {
+            member->shuffleVariableOrder(i);
+            if (variableGroupsInPlace) member->groupVariables();
+        }
+        std::vector<int> correspondence = computeVariableCorrespondence(*member);
+        member->initEnv = initEnv.transferTo(member->mgr,correspondence);
+        member->initSys = initSys.transferTo(member->mgr,correspondence);
+        member->safetyEnv = safetyEnv.transferTo(member->mgr,correspondence);
+        member->safetySys = safetySys.transferTo(member->mgr,correspondence);
+        for (auto &it : safetyEnvParts) member->safetyEnvParts.push_back(it.transferTo(member->mgr,correspondence));
+        for (auto &it : safetySysParts) member->safetySysParts.push_back(it.transferTo(member->mgr,correspondence));
+        for (auto &it : livenessAssumptions) member->livenessAssumptions.push_back(it.transferTo(member->mgr,correspondence));
+        for (auto &it : livenessGuarantees) member->livenessGuarantees.push_back(it.transferTo(member->mgr,correspondence));
+        member->mgr.setTerminationFlag(&raceFinished);
+        members.push_back(std::move(member));
+    }
+
+    // Race them. Cancelled members end with an exception.
+    std::mutex winnerMutex;
+    int winner = -1;
+    std::vector<std::exception_ptr> errors(members.size());
+    std::vector<std::thread> threads;
+    for (unsigned int i=0;i<members.size();i++) {
+        threads.push_back(std::thread([&,i]() {
+            try {
+                members[i]->computeWinningPositionsWithoutPortfolio();
+                std::lock_guard<std::mutex> lock(winnerMutex);
+                if (winner<0) winner = i;
+                raceFinished = true;
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        }));
+    }
+    for (auto &thread : threads) thread.join();
+    if (winner<0) std::rethrow_exception(errors[0]);
+    std::cerr << "Portfolio member " << winner << " has computed the winning positions first.\n";
+
+    // Copy the results of the winner
+    GR1Context &winningMember = *(members[winner]);
+    winningMember.mgr.setTerminationFlag(NULL);
+    std::vector<int> correspondence = winningMember.computeVariableCorrespondence(*this);
+    winningPositions = winningMember.winningPositions.transferTo(mgr,correspondence);
+    strategyDumpingData.clear();
+    for (auto &it : winningMember.strategyDumpingData) {
+        strategyDumpingData.push_back(std::pair<unsigned int,BF>(it.first,it.second.transferTo(mgr,correspondence)));
+    }
+}
+
+/**
+ * @brief Computes the set of positions from which the system player can enforce that the next transition
+ *        is in "transitions" and satisfies the safety guarantees, or the safety assumptions are violated, i.e.,
+ *
+ *        forall PostInput. (safetyEnv -> exists PostOutput. (safetySys /\ transitions))
+ *
+ *        If the 'partitionedTransitionRelation' solver option is set, the clusters computed by
+ *        'computeTransitionRelationClusters' are conjoined one-by-one, and the post-variables are
+ *        quantified away as early as possible. The monolithic 'safetySys' and 'safetyEnv' BFs are
+ *        then not touched.
+ * @param transitions the transitions that the system player wants to take.
+ * @return the set of positions (over the pre-variables)
+ */
+BF GR1Context::enforceablePredecessor(BF const &transitions) {
+    if (!solverOptions.partitionedTransitionRelation) {
+        return BF::cox(safetyEnv,safetySys,transitions,varCubePostOutput,varCubePostInput);
+    }
+
+    // Existential part: exists PostOutput. (safetySys /\ transitions)
+    BF sysPart = transitions.ExistAbstract(safetySysUnclusteredCube);
+    for (unsigned int i=0;i<safetySysClusters.size();i++) {
+        sysPart = sysPart.AndAbstract(safetySysClusters[i],safetySysClusterCubes[i]);
+    }
+
+    // Universal part - computed as the dual: !exists PostInput. (safetyEnv /\ !sysPart)
+    BF envPart = (!sysPart).ExistAbstract(safetyEnvUnclusteredCube);
+    for (unsigned int i=0;i<safetyEnvClusters.size();i++) {
+        envPart = envPart.AndAbstract(safetyEnvClusters[i],safetyEnvClusterCubes[i]);
+    }
+    return !envPart;
+}
+
+/**
+ * @brief Prepares the clusters of safety assumptions and guarantees for 'enforceablePredecessor'. The
+ *        clusters are only recomputed when 'safetyEnv' or 'safetySys' have changed since the last call.
+ *        If the parts of the safety constraints recorded during parsing do not make up 'safetyEnv'/'safetySys'
+ *        (e.g., because some plugin has modified the safety constraints), the monolithic BF is used as
+ *        the only part.
+ */
+void GR1Context::computeTransitionRelationClusters() {
+
+    if ((clusteredSafetyEnv.isValid()) && (clusteredSafetyEnv==safetyEnv) && (clusteredSafetySys==safetySys)) return;
+
+    std::vector<BF> envParts = safetyEnvParts;
+    if (!(mgr.multiAnd(envParts)==safetyEnv)) envParts = std::vector<BF>(1,safetyEnv);
+    std::vector<BF> sysParts = safetySysParts;
+    if (!(mgr.multiAnd(sysParts)==safetySys)) sysParts = std::vector<BF>(1,safetySys);
+
+    // The universal quantification over the PostInput variables can only be pulled
+    // inwards if the safety assumptions do not refer to the next output values
+    for (auto it = envParts.begin();it!=envParts.end();it++) {
+        std::vector<unsigned int> support = it->getSupportIndices();
+        for (unsigned int i=0;i<variables.size();i++) {
+            if (doesVariableInheritType(i,PostOutput) && std::binary_search(support.begin(),support.end(),variables[i].readNodeIndex())) {
+                throw SlugsException(false,"Error: A partitioned transition relation can only be used if the safety assumptions do not refer to the next values of the output variables.");
+            }
+        }
+    }
+
+    computeClustersForQuantification(envParts,PostInput,safetyEnvClusters,safetyEnvClusterCubes,safetyEnvUnclusteredCube);
+    computeClustersForQuantification(sysParts,PostOutput,safetySysClusters,safetySysClusterCubes,safetySysUnclusteredCube);
+    clusteredSafetyEnv = safetyEnv;
+    clusteredSafetySys = safetySys;
+}
+
+/**
+ * @brief Groups a conjunction of BFs into clusters for early quantification of the variables of some type.
+ *        The parts are ordered greedily such that many variables can be quantified after each part (i.e., they do
+ *        not occur in the remaining parts). Parts that do not contain variables to be quantified are put
+ *        at the end. Then, consecutive parts are merged into clusters while the size of a cluster stays
+ *        below the "clusterSizeThreshold" solver option.
+ * @param parts the BFs whose conjunction is partitioned
+ * @param quantifiedType the type of the variables to be quantified
+ * @param clusters where to store the clusters
+ * @param clusterCubes where to store, for every cluster, the cube of variables that can be quantified after conjoining the cluster
+ * @param unclusteredCube where to store the cube of variables to be quantified that do not occur in any cluster
+ */
+void GR1Context::computeClustersForQuantification(std::vector<BF> const &parts, VariableType quantifiedType, std::vector<BF> &clusters, std::vector<BFVarCube> &clusterCubes, BFVarCube &unclusteredCube) {
+
+    // Map the BDD variable indices of the variables to be quantified to the variables
+    std::map<unsigned int,unsigned int> quantifiedVariables;
+    for (unsigned int i=0;i<variables.size();i++) {
+        if (doesVariableInheritType(i,quantifiedType)) quantifiedVariables[variables[i].readNodeIndex()] = i;
+    }
+
+    // Compute which variables to be quantified occur in which part
+    std::vector<std::set<unsigned int> > supports(parts.size());
+    std::map<unsigned int,unsigned int> nofRemainingOccurrences;
+    std::list<unsigned int> remainingParts;
+    std::vector<unsigned int> partsWithoutQuantifiedVariables;
+    for (unsigned int i=0;i<parts.size();i++) {
+        std::vector<unsigned int> support = parts[i].getSupportIndices();
+        for (auto it = support.begin();it!=support.end();it++) {
+            if (quantifiedVariables.count(*it)>0) {
+                supports[i].insert(*it);
+                nofRemainingOccurrences[*it]++;
+            }
+        }
+        if (supports[i].size()==0) {
+            partsWithoutQuantifiedVariables.push_back(i);
+        } else {
+            remainingParts.push_back(i);
+        }
+    }
+
+    // Greedy ordering: Prefer the part after which the most variables can be quantified away. Break ties by
+    // taking the part that introduces the fewest other variables.
+    std::vector<unsigned int> order;
+    while (remainingParts.size()>0) {
+        auto best = remainingParts.end();
+        int bestNofQuantifiable = -1;
+        int bestNofOthers = 0;
+        for (auto it = remainingParts.begin();it!=remainingParts.end();it++) {
+            int nofQuantifiable = 0;
+            for (auto it2 = supports[*it].begin();it2!=supports[*it].end();it2++) {
+                if (nofRemainingOccurrences[*it2]==1) nofQuantifiable++;
+            }
+            int nofOthers = supports[*it].size()-nofQuantifiable;
+            if ((nofQuantifiable>bestNofQuantifiable) || ((nofQuantifiable==bestNofQuantifiable) && (nofOthers<bestNofOthers))) {
+                best = it;
+                bestNofQuantifiable = nofQuantifiable;
+                bestNofOthers = nofOthers;
+            }
+        }
+        for (auto it2 = supports[*best].begin();it2!=supports[*best].end();it2++) {
+            nofRemainingOccurrences[*it2]--;
+        }
+        order.push_back(*best);
+        remainingParts.erase(best);
+    }
+    order.insert(order.end(),partsWithoutQuantifiedVariables.begin(),partsWithoutQuantifiedVariables.end());
+
+    // Merge consecutive parts into clusters
+    clusters.clear();
+    std::vector<std::set<unsigned int> > clusterSupports;
+    for (auto it = order.begin();it!=order.end();it++) {
+        if (clusters.size()>0) {
+            BF merged = clusters.back() & parts[*it];
+            if ((unsigned int)merged.getSize()<=solverOptions.clusterSizeThreshold) {
+                clusters.back() = merged;
+                clusterSupports.back().insert(supports[*it].begin(),supports[*it].end());
+                continue;
+            }
+        }
+        clusters.push_back(parts[*it]);
+        clusterSupports.push_back(supports[*it]);
+    }
+
+    // Compute the quantification cubes - a variable can be quantified after the last cluster in which it occurs
+    clusterCubes.clear();
+    std::set<unsigned int> occurringLater;
+    std::vector<std::vector<BF> > cubeVariables(clusters.size());
+    for (int i=clusters.size()-1;i>=0;i--) {
+        for (auto it = clusterSupports[i].begin();it!=clusterSupports[i].end();it++) {
+            if (occurringLater.count(*it)==0) {
+                cubeVariables[i].push_back(variables[quantifiedVariables[*it]]);
+                occurringLater.insert(*it);
+            }
+        }
+    }
+    for (unsigned int i=0;i<clusters.size();i++) {
+        clusterCubes.push_back(mgr.computeCube(cubeVariables[i]));
+    }
+    std::vector<BF> unclusteredVariables;
+    for (auto it = quantifiedVariables.begin();it!=quantifiedVariables.end();it++) {
+        if (occurringLater.count(it->first)==0) unclusteredVariables.push_back(variables[it->second]);
+    }
+    unclusteredCube = mgr.computeCube(unclusteredVariables);
+}
+
+/**
+ * @brief Checks if the initialization constraints are satisfied for a given set of winning positions, i.e.,
+ *        if for every initial input the system player can choose an initial output such that the initial
+ *        position is in the set. Plugins that change the semantics of the initialization constraints
+ *        override this function. As the check is monotone in 'positions', it can also be applied to an
+ *        over-approximation of the winning positions to detect unrealizability early.
+ * @param positions the set of (possibly over-approximated) winning positions
+ * @return true if all initial positions are covered
+ */
+bool GR1Context::initialPositionsAreWinning(BF const &positions) {
+    BF result = BF::cox(initEnv,initSys,positions,varCubePreOutput,varCubePreInput);
 
     // Check if the result is well-defind. Might fail after an incorrect modification of the above algorithm
     if (!result.isConstant()) {
         BF_newDumpDot(*this,result,NULL,"/tmp/isRealizable.dot");
         throw "Internal error: Could not establish realizability/unrealizability of the specification.";
     }
+    return result.isTrue();
+}
+
+void GR1Context::checkRealizability() {
+
+    computeWinningPositions();
 
-    // Return the result in Boolean form.
-    realizable = result.isTrue();
+    // Check if for every possible environment initial position the system has a good system initial position
+    realizable = initialPositionsAreWinning(winningPositions);
 }
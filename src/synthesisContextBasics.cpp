@@ -2,8 +2,21 @@
 #include <fstream>
 #include <iostream>
 #include <sstream>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <memory>
 #include <boost/algorithm/string.hpp>
 
+/**
+ * @brief The solver options used by all contexts - see the "GR1SolverOptions" class.
+ */
+GR1SolverOptions GR1Context::solverOptions;
+
+/**
+ * @brief Creates the members of solver portfolios - see "computeWinningPositionsWithPortfolio". If not set, the members are plain GR1Contexts.
+ */
+std::function<GR1Context*(bool useFixedPointRecycling)> GR1Context::portfolioMemberFactory;
 
 /**
  * @brief Constructor that reads the problem instance from file and prepares the BFManager, the BFVarCubes, and the BFVarVectors
@@ -13,106 +26,224 @@ GR1Context::GR1Context(std::list<std::string> &filenames) {
     (void)filenames;
 }
 
+namespace {
+    //! An operator of a formula that is being parsed and that still waits for some of its operands.
+    struct FormulaParsingFrame {
+        char operation; //! '&', '|', '^', '!', '$' for a memory buffer, or 'R' for the formula as a whole
+        size_t firstOperand; //! The position of the first operand on the operand stack
+        unsigned int nofOperandsMissing;
+        unsigned int nofOperandsRead;
+    };
+}
+
 /**
- * @brief Recurse internal function to parse a Boolean formula from a line in the input file
- * @param is the input stream from which the tokens in the line are read
+ * @brief Internal function for parsing a Boolean formula from a line in the input file.
+ *        The prefix notation is parsed with an explicit operator/operand stack, so that arbitrarily
+ *        deep formulas can be read. Chains of conjunctions and disjunctions are collected into a
+ *        single operator whose operands are combined as a balanced tree.
+ * @param currentLine the line to parse
  * @param allowedTypes a list of allowed variable types - this allows to check that assumptions do not refer to 'next' output values.
+ * @param namedBFs BFs that can be referred to by name in addition to the variables (or NULL if there are none)
  * @return a BF that represents the transition constraint read from the line
  */
-BF GR1Context::parseBooleanFormulaRecurse(std::istringstream &is,std::set<VariableType> &allowedTypes, std::vector<BF> &memory) {
-    std::string operation = "";
-    is >> operation;
-    if (operation=="") {
-        SlugsException e(false);
-        e << "Error reading line " << lineNumberCurrentlyRead << ". Premature end of line.";
-        throw e;
-    }
-    if (operation=="|") return parseBooleanFormulaRecurse(is,allowedTypes,memory) | parseBooleanFormulaRecurse(is,allowedTypes,memory);
-    if (operation=="^") return parseBooleanFormulaRecurse(is,allowedTypes,memory) ^ parseBooleanFormulaRecurse(is,allowedTypes,memory);
-    if (operation=="&") return parseBooleanFormulaRecurse(is,allowedTypes,memory) & parseBooleanFormulaRecurse(is,allowedTypes,memory);
-    if (operation=="!") return !parseBooleanFormulaRecurse(is,allowedTypes,memory);
-    if (operation=="1") return mgr.constantTrue();
-    if (operation=="0") return mgr.constantFalse();
-
-    // Memory Functionality - Create Buffer
-    if (operation=="$") {
-        unsigned nofElements;
-        is >> nofElements;
-        if (is.fail()) {
-            SlugsException e(false);
-            e << "Error reading line " << lineNumberCurrentlyRead << ". Expected number of memory elements.";
-            throw e;
-        }
-        std::vector<BF> memoryNew(nofElements);
-        for (unsigned int i=0;i<nofElements;i++) {
-            memoryNew[i] = parseBooleanFormulaRecurse(is,allowedTypes,memoryNew);
-        }
-        return memoryNew[nofElements-1];
-    }
+BF GR1Context::parseBooleanFormula(std::string const &currentLine, std::set<VariableType> &allowedTypes, const std::map<std::string,BF> *namedBFs) {
+
+    // Put newly added variables into place before they are used in BFs
+    if (solverOptions.variableOrder.size()>0) applyVariableOrder(solverOptions.variableOrder);
+    if (solverOptions.groupVariables) groupVariables();
+
+    SlugsFormulaTokenizer tokenizer(currentLine,lineNumberCurrentlyRead);
+    std::vector<FormulaParsingFrame> frames;
+    std::vector<BF> operands;
+    std::vector<size_t> memoryFrames; // Positions of the memory buffers in "frames" - the last one is used for recalling
+    frames.push_back({'R',0,1,0});
 
-    // Memory Functionality - Recall from Buffer
-    if (operation=="?") {
-        unsigned int element;
-        is >> element;
-        if (is.fail()) {
+    while (true) {
+        if (!tokenizer.next()) {
             SlugsException e(false);
-            e << "Error reading line " << lineNumberCurrentlyRead << ". Expected number after memory recall operator '?'.";
+            e << "Error reading line " << lineNumberCurrentlyRead << ". Premature end of line.";
             throw e;
         }
-        if (element>=memory.size()) {
-            SlugsException e(false);
-            e << "Error reading line " << lineNumberCurrentlyRead << ". Trying to recall a memory element that has not been stored (yet).";
-            throw e;
+        std::string const &token = tokenizer.current();
+
+        BF value;
+        switch ((token.size()==1) ? token[0] : '\0') {
+        case '&':
+        case '|':
+            // An operand of a conjunction that is a conjunction adds its operands to the outer one.
+            if (frames.back().operation==token[0]) {
+                frames.back().nofOperandsMissing++;
+            } else {
+                frames.push_back({token[0],operands.size(),2,0});
+            }
+            continue;
+        case '^':
+            frames.push_back({'^',operands.size(),2,0});
+            continue;
+        case '!':
+            frames.push_back({'!',operands.size(),1,0});
+            continue;
+        case '1':
+            value = mgr.constantTrue();
+            break;
+        case '0':
+            value = mgr.constantFalse();
+            break;
+
+        // Memory Functionality - Create Buffer
+        case '$': {
+            unsigned int nofElements;
+            if ((!tokenizer.nextNumber(nofElements)) || (nofElements==0)) {
+                SlugsException e(false);
+                e << "Error reading line " << lineNumberCurrentlyRead << ". Expected number of memory elements.";
+                throw e;
+            }
+            memoryFrames.push_back(frames.size());
+            frames.push_back({'$',operands.size(),nofElements,0});
+            continue;
         }
-        return memory[element];
-    }
 
-    // Has to be a variable!
-    for (unsigned int i=0;i<variableNames.size();i++) {
-        if (variableNames[i]==operation) {
-            if (allowedTypes.count(variableTypes[i])==0) {
+        // Memory Functionality - Recall from Buffer
+        case '?': {
+            unsigned int element;
+            if (!tokenizer.nextNumber(element)) {
                 SlugsException e(false);
-                e << "Error reading line " << lineNumberCurrentlyRead << ". The variable " << operation << " is not allowed for this type of expression.";
+                e << "Error reading line " << lineNumberCurrentlyRead << ". Expected number after memory recall operator '?'.";
                 throw e;
             }
-            return variables[i];
+            if ((memoryFrames.size()==0) || (element>=frames[memoryFrames.back()].nofOperandsRead)) {
+                SlugsException e(false);
+                e << "Error reading line " << lineNumberCurrentlyRead << ". Trying to recall a memory element that has not been stored (yet).";
+                throw e;
+            }
+            value = operands[frames[memoryFrames.back()].firstOperand+element];
+            break;
         }
-    }
-    SlugsException e(false);
-    e << "Error reading line " << lineNumberCurrentlyRead << ". The variable " << operation << " has not been found.";
-    throw e;
-}
 
-/**
- * @brief Internal function for parsing a Boolean formula from a line in the input file - calls the recursive function to do all the work.
- * @param currentLine the line to parse
- * @param allowedTypes a list of allowed variable types - this allows to check that assumptions do not refer to 'next' output values.
- * @return a BF that represents the transition constraint read from the line
- */
-BF GR1Context::parseBooleanFormula(std::string currentLine, std::set<VariableType> &allowedTypes) {
+        default: {
+            // Named BF?
+            if (namedBFs!=NULL) {
+                auto it = namedBFs->find(token);
+                if (it!=namedBFs->end()) {
+                    value = it->second;
+                    break;
+                }
+            }
 
-    std::istringstream is(currentLine);
+            // Has to be a variable!
+            int varNumber = lookupVariableNumber(token);
+            if (varNumber<0) {
+                SlugsException e(false);
+                e << "Error reading line " << lineNumberCurrentlyRead << ". The variable " << token << " has not been found.";
+                throw e;
+            }
+            if (allowedTypes.count(variableTypes[varNumber])==0) {
+                SlugsException e(false);
+                e << "Error reading line " << lineNumberCurrentlyRead << ". The variable " << token << " is not allowed for this type of expression.";
+                throw e;
+            }
+            value = variables[varNumber];
+        }
+        }
 
-    std::vector<BF> memory;
-    BF result = parseBooleanFormulaRecurse(is,allowedTypes,memory);
-    assert(memory.size()==0);
-    std::string nextPart = "";
-    is >> nextPart;
-    if (nextPart=="") return result;
+        // Hand the value to the innermost operator. Operators that have all of their operands then
+        // become values themselves.
+        while (true) {
+            FormulaParsingFrame &frame = frames.back();
+            operands.push_back(value);
+            frame.nofOperandsRead++;
+            if (--frame.nofOperandsMissing>0) break;
 
-    SlugsException e(false);
-    e << "Error reading line " << lineNumberCurrentlyRead << ". There are stray characters: '" << nextPart << "'";
-    throw e;
+            switch (frame.operation) {
+            case '&':
+                value = mgr.multiAnd(std::vector<BF>(operands.begin()+frame.firstOperand,operands.end()));
+                break;
+            case '|':
+                value = mgr.multiOr(std::vector<BF>(operands.begin()+frame.firstOperand,operands.end()));
+                break;
+            case '^':
+                value = operands[frame.firstOperand] ^ operands[frame.firstOperand+1];
+                break;
+            case '!':
+                value = !operands[frame.firstOperand];
+                break;
+            case '$':
+                memoryFrames.pop_back();
+                break;
+            case 'R':
+                if (!tokenizer.next()) return value;
+                {
+                    SlugsException e(false);
+                    e << "Error reading line " << lineNumberCurrentlyRead << ". There are stray characters: '" << tokenizer.current() << "'";
+                    throw e;
+                }
+            }
+            operands.resize(frame.firstOperand);
+            frames.pop_back();
+        }
+    }
 }
 
 
 void GR1Context::execute() {
     checkRealizability();
+    reportRealizability();
+}
+
+/**
+ * @brief Reports the result of the realizability check on stderr, and records that it has been reported
+ */
+void GR1Context::reportRealizability() {
     if (realizable) {
         std::cerr << "RESULT: Specification is realizable.\n";
     } else {
         std::cerr << "RESULT: Specification is unrealizable.\n";
     }
+    realizabilityReported = true;
+}
+
+/**
+ * @brief Computes a hash (64 bit FNV-1a) of the contents of a file, which is used to detect if a compiled
+ *        specification is still up-to-date. The file is rewound afterwards.
+ * @param inFile the file to be hashed
+ * @return the hash as a hexadecimal string
+ */
+std::string GR1Context::computeFileContentHash(std::istream &inFile) {
+    uint64_t hash = 14695981039346656037ULL;
+    std::vector<char> buffer(1 << 20);
+    while (inFile.read(buffer.data(),buffer.size()) || (inFile.gcount()>0)) {
+        std::streamsize nofBytesRead = inFile.gcount();
+        for (std::streamsize i=0;i<nofBytesRead;i++) {
+            hash = (hash ^ (unsigned char)buffer[i]) * 1099511628211ULL;
+        }
+    }
+    inFile.clear();
+    inFile.seekg(0);
+    std::ostringstream os;
+    os << std::hex << hash;
+    return os.str();
+}
+
+/**
+ * @brief Computes where the compiled version of a specification file is looked for: the name of the
+ *        file with ".slugsin" replaced by ".slugsbin" (or with ".slugsbin" appended for other file names).
+ */
+static std::string getCompiledSpecificationFilename(std::string const &inFileName) {
+    if (boost::ends_with(inFileName,".slugsin")) return inFileName.substr(0,inFileName.size()-8)+".slugsbin";
+    return inFileName+".slugsbin";
+}
+
+/**
+ * @brief Reads a line of the header of a compiled specification file
+ */
+static bool readCompiledSpecificationLine(FILE *file, std::string &line) {
+    line.clear();
+    int c;
+    while ((c = fgetc(file))!=EOF) {
+        if (c=='\n') return true;
+        line.push_back((char)c);
+    }
+    return false;
 }
 
 void GR1Context::init(std::list<std::string> &filenames) {
@@ -123,6 +254,16 @@ void GR1Context::init(std::list<std::string> &filenames) {
     std::string inFileName = filenames.front();
     filenames.pop_front();
 
+    // Compiled specifications can be given instead of the specification itself
+    if (boost::ends_with(inFileName,".slugsbin")) {
+        if (!loadCompiledSpecification(inFileName,"")) {
+            std::ostringstream errorMessage;
+            errorMessage << "Cannot read the compiled specification '" << inFileName << "'";
+            throw errorMessage.str();
+        }
+        return;
+    }
+
     // Open input file or produce error message if that does not work
     std::ifstream inFile(inFileName.c_str());
     if (inFile.fail()) {
@@ -131,87 +272,99 @@ void GR1Context::init(std::list<std::string> &filenames) {
         throw errorMessage.str();
     }
 
+    // Use the compiled specification next to the input file instead of parsing if it has been compiled
+    // from the same file contents
+    specificationSourceHash = computeFileContentHash(inFile);
+    if (loadCompiledSpecification(getCompiledSpecificationFilename(inFileName),specificationSourceHash)) return;
+
     // Prepare safety and initialization constraints
     initEnv = mgr.constantTrue();
     initSys = mgr.constantTrue();
     safetyEnv = mgr.constantTrue();
     safetySys = mgr.constantTrue();
-    
-    // The readmode variable stores in which chapter of the input file we are
-    int readMode = -1;
-    std::string currentLine;
-    lineNumberCurrentlyRead = 0;
-    while (std::getline(inFile,currentLine)) {
-        lineNumberCurrentlyRead++;
-        boost::trim(currentLine);
-        if ((currentLine.length()>0) && (currentLine[0]!='#')) {
-            if (currentLine[0]=='[') {
-                if (currentLine=="[INPUT]") {
-                    readMode = 0;
-                } else if (currentLine=="[OUTPUT]") {
-                    readMode = 1;
-                } else if (currentLine=="[ENV_INIT]") {
-                    readMode = 2;
-                } else if (currentLine=="[SYS_INIT]") {
-                    readMode = 3;
-                } else if (currentLine=="[ENV_TRANS]") {
-                    readMode = 4;
-                } else if (currentLine=="[SYS_TRANS]") {
-                    readMode = 5;
-                } else if (currentLine=="[ENV_LIVENESS]") {
-                    readMode = 6;
-                } else if (currentLine=="[SYS_LIVENESS]") {
-                    readMode = 7;
-                } else {
-                    std::cerr << "Sorry. Didn't recognize category " << currentLine << "\n";
-                    throw "Aborted.";
-                }
-            } else {
-                if (readMode==0) {
-                    addVariable(PreInput,currentLine);
-                    addVariable(PostInput,currentLine+"'");
-                } else if (readMode==1) {
-                    addVariable(PreOutput,currentLine);
-                    addVariable(PostOutput,currentLine+"'");
-                } else if (readMode==2) {
-                    std::set<VariableType> allowedTypes;
-                    allowedTypes.insert(PreInput);
-                    initEnv &= parseBooleanFormula(currentLine,allowedTypes);
-                } else if (readMode==3) {
-                    std::set<VariableType> allowedTypes;
-                    allowedTypes.insert(PreInput);
-                    allowedTypes.insert(PreOutput);
-                    initSys &= parseBooleanFormula(currentLine,allowedTypes);
-                } else if (readMode==4) {
-                    std::set<VariableType> allowedTypes;
-                    allowedTypes.insert(PreInput);
-                    allowedTypes.insert(PreOutput);
-                    allowedTypes.insert(PostInput);
-                    safetyEnv &= parseBooleanFormula(currentLine,allowedTypes);
-                } else if (readMode==5) {
-                    std::set<VariableType> allowedTypes;
-                    allowedTypes.insert(PreInput);
-                    allowedTypes.insert(PreOutput);
-                    allowedTypes.insert(PostInput);
-                    allowedTypes.insert(PostOutput);
-                    safetySys &= parseBooleanFormula(currentLine,allowedTypes);
-                } else if (readMode==6) {
-                    std::set<VariableType> allowedTypes;
-                    allowedTypes.insert(PreInput);
-                    allowedTypes.insert(PreOutput);
-                    allowedTypes.insert(PostOutput);
-                    allowedTypes.insert(PostInput);
-                    livenessAssumptions.push_back(parseBooleanFormula(currentLine,allowedTypes));
-                } else if (readMode==7) {
-                    std::set<VariableType> allowedTypes;
-                    allowedTypes.insert(PreInput);
-                    allowedTypes.insert(PreOutput);
-                    allowedTypes.insert(PostInput);
-                    allowedTypes.insert(PostOutput);
-                    livenessGuarantees.push_back(parseBooleanFormula(currentLine,allowedTypes));
+
+    // Structured slugs specifications are translated while reading them
+    if (boost::ends_with(inFileName,".structuredslugs")) {
+        readStructuredSpecification(inFile);
+    } else {
+        // The readmode variable stores in which chapter of the input file we are
+        int readMode = -1;
+        std::string currentLine;
+        lineNumberCurrentlyRead = 0;
+        while (std::getline(inFile,currentLine)) {
+            lineNumberCurrentlyRead++;
+            boost::trim(currentLine);
+            if ((currentLine.length()>0) && (currentLine[0]!='#')) {
+                if (currentLine[0]=='[') {
+                    if (currentLine=="[INPUT]") {
+                        readMode = 0;
+                    } else if (currentLine=="[OUTPUT]") {
+                        readMode = 1;
+                    } else if (currentLine=="[ENV_INIT]") {
+                        readMode = 2;
+                    } else if (currentLine=="[SYS_INIT]") {
+                        readMode = 3;
+                    } else if (currentLine=="[ENV_TRANS]") {
+                        readMode = 4;
+                    } else if (currentLine=="[SYS_TRANS]") {
+                        readMode = 5;
+                    } else if (currentLine=="[ENV_LIVENESS]") {
+                        readMode = 6;
+                    } else if (currentLine=="[SYS_LIVENESS]") {
+                        readMode = 7;
+                    } else {
+                        std::cerr << "Sorry. Didn't recognize category " << currentLine << "\n";
+                        throw "Aborted.";
+                    }
                 } else {
-                    std::cerr << "Error with line " << lineNumberCurrentlyRead << "!";
-                    throw "Found a line in the specification file that has no proper categorial context.";
+                    if (readMode==0) {
+                        addVariable(PreInput,currentLine);
+                        addVariable(PostInput,currentLine+"'");
+                    } else if (readMode==1) {
+                        addVariable(PreOutput,currentLine);
+                        addVariable(PostOutput,currentLine+"'");
+                    } else if (readMode==2) {
+                        std::set<VariableType> allowedTypes;
+                        allowedTypes.insert(PreInput);
+                        initEnv &= parseBooleanFormula(currentLine,allowedTypes);
+                    } else if (readMode==3) {
+                        std::set<VariableType> allowedTypes;
+                        allowedTypes.insert(PreInput);
+                        allowedTypes.insert(PreOutput);
+                        initSys &= parseBooleanFormula(currentLine,allowedTypes);
+                    } else if (readMode==4) {
+                        std::set<VariableType> allowedTypes;
+                        allowedTypes.insert(PreInput);
+                        allowedTypes.insert(PreOutput);
+                        allowedTypes.insert(PostInput);
+                        safetyEnvParts.push_back(parseBooleanFormula(currentLine,allowedTypes));
+                        safetyEnv &= safetyEnvParts.back();
+                    } else if (readMode==5) {
+                        std::set<VariableType> allowedTypes;
+                        allowedTypes.insert(PreInput);
+                        allowedTypes.insert(PreOutput);
+                        allowedTypes.insert(PostInput);
+                        allowedTypes.insert(PostOutput);
+                        safetySysParts.push_back(parseBooleanFormula(currentLine,allowedTypes));
+                        safetySys &= safetySysParts.back();
+                    } else if (readMode==6) {
+                        std::set<VariableType> allowedTypes;
+                        allowedTypes.insert(PreInput);
+                        allowedTypes.insert(PreOutput);
+                        allowedTypes.insert(PostOutput);
+                        allowedTypes.insert(PostInput);
+                        livenessAssumptions.push_back(parseBooleanFormula(currentLine,allowedTypes));
+                    } else if (readMode==7) {
+                        std::set<VariableType> allowedTypes;
+                        allowedTypes.insert(PreInput);
+                        allowedTypes.insert(PreOutput);
+                        allowedTypes.insert(PostInput);
+                        allowedTypes.insert(PostOutput);
+                        livenessGuarantees.push_back(parseBooleanFormula(currentLine,allowedTypes));
+                    } else {
+                        std::cerr << "Error with line " << lineNumberCurrentlyRead << "!";
+                        throw "Found a line in the specification file that has no proper categorial context.";
+                    }
                 }
             }
         }
@@ -227,3 +380,155 @@ void GR1Context::init(std::list<std::string> &filenames) {
     if (livenessGuarantees.size()==0) livenessGuarantees.push_back(mgr.constantTrue());
 }
 
+//===================================================================================
+// Compiled specifications
+//
+// -> A compiled specification ("*.slugsbin") contains everything that GR1Context::init
+//    obtains from parsing a specification. It starts with a text header:
+//      SLUGSBIN 1
+//      source <content hash of the specification file, or "-" if not known>
+//      variables <n>
+//      <variable type> <CUDD index of the variable> <variable name>   (n lines)
+//      order <n>
+//      <variable name>   (n lines, in the order of the BDD variables)
+//      bdds <nof. ENV_TRANS lines> <nof. SYS_TRANS lines> <nof. ENV_LIVENESS> <nof. SYS_LIVENESS>
+// -> The BDDs follow in the binary DDDMP format, with the CUDD indices given in the header:
+//    initEnv, initSys, safetyEnv, safetySys, and then the lines of the transition
+//    constraints, the liveness assumptions and the liveness guarantees.
+// -> The file ends with a trailer line, which is used to detect incomplete files.
+//===================================================================================
+
+static const char *compiledSpecificationTrailer = "SLUGSBIN END\n";
+
+/**
+ * @brief Writes everything that has been read from the specification to a compiled specification file
+ * @param filename the name of the file
+ */
+void GR1Context::saveCompiledSpecification(std::string const &filename) const {
+
+    // Write to a temporary file first so that no incomplete file can be found at "filename"
+    std::string temporaryFilename = filename+".tmp";
+    FILE *file = fopen(temporaryFilename.c_str(),"wb");
+    if (file==NULL) {
+        std::ostringstream errorMessage;
+        errorMessage << "Cannot write the compiled specification '" << filename << "'";
+        throw errorMessage.str();
+    }
+
+    bool success = true;
+    try {
+        fprintf(file,"SLUGSBIN 1\nsource %s\nvariables %zu\n",(specificationSourceHash=="")?"-":specificationSourceHash.c_str(),variables.size());
+        for (unsigned int i=0;i<variables.size();i++) {
+            fprintf(file,"%d %d %s\n",(int)variableTypes[i],(int)variables[i].readNodeIndex(),variableNames[i].c_str());
+        }
+        std::vector<std::string> order = getVariableOrder();
+        fprintf(file,"order %zu\n",order.size());
+        for (auto const &name : order) fprintf(file,"%s\n",name.c_str());
+        fprintf(file,"bdds %zu %zu %zu %zu\n",safetyEnvParts.size(),safetySysParts.size(),livenessAssumptions.size(),livenessGuarantees.size());
+
+        std::vector<BF> bdds = {initEnv, initSys, safetyEnv, safetySys};
+        bdds.insert(bdds.end(),safetyEnvParts.begin(),safetyEnvParts.end());
+        bdds.insert(bdds.end(),safetySysParts.begin(),safetySysParts.end());
+        bdds.insert(bdds.end(),livenessAssumptions.begin(),livenessAssumptions.end());
+        bdds.insert(bdds.end(),livenessGuarantees.begin(),livenessGuarantees.end());
+        mgr.writeBDDsToFile(file,bdds);
+        fprintf(file,"%s",compiledSpecificationTrailer);
+    } catch (const std::runtime_error &) {
+        success = false;
+    }
+    success = (ferror(file)==0) && success;
+    success = (fclose(file)==0) && success;
+
+    // Do not leave the temporary file behind if anything went wrong
+    if ((!success) || (std::rename(temporaryFilename.c_str(),filename.c_str())!=0)) {
+        std::remove(temporaryFilename.c_str());
+        std::ostringstream errorMessage;
+        errorMessage << "Cannot write the compiled specification '" << filename << "'";
+        throw errorMessage.str();
+    }
+}
+
+/**
+ * @brief Reads a compiled specification written by "saveCompiledSpecification". Must be called before
+ *        any variable has been added.
+ * @param filename the name of the file
+ * @param expectedSourceHash the content hash of the specification file (or "" if any content hash is to be accepted)
+ * @return false if the file does not exist, is no compiled specification, or has been compiled from a different specification
+ */
+bool GR1Context::loadCompiledSpecification(std::string const &filename, std::string const &expectedSourceHash) {
+
+    FILE *file = fopen(filename.c_str(),"rb");
+    if (file==NULL) return false;
+    std::unique_ptr<FILE,int(*)(FILE*)> fileCloser(file,fclose);
+
+    std::string line;
+    if ((!readCompiledSpecificationLine(file,line)) || (line!="SLUGSBIN 1")) return false;
+    if ((!readCompiledSpecificationLine(file,line)) || (line.substr(0,7)!="source ")) return false;
+    if ((expectedSourceHash!="") && (line.substr(7)!=expectedSourceHash)) return false;
+    specificationSourceHash = line.substr(7);
+
+    std::ostringstream errorMessage;
+    errorMessage << "The compiled specification '" << filename << "' is corrupt.";
+
+    // Variables
+    unsigned int nofVariables;
+    if ((!readCompiledSpecificationLine(file,line)) || (sscanf(line.c_str(),"variables %u",&nofVariables)!=1)) throw errorMessage.str();
+    std::vector<int> storedIndices;
+    for (unsigned int i=0;i<nofVariables;i++) {
+        int type, storedIndex, nameStart = 0;
+        if ((!readCompiledSpecificationLine(file,line)) || (sscanf(line.c_str(),"%d %d %n",&type,&storedIndex,&nameStart)!=2) || (nameStart==0) || (storedIndex<0)) throw errorMessage.str();
+        if ((type<0) || (type>=NoneVariableType)) throw errorMessage.str();
+        addVariable(static_cast<VariableType>(type),line.substr(nameStart));
+        storedIndices.push_back(storedIndex);
+    }
+
+    // Variable order - an order given by the user takes precedence
+    unsigned int nofVariablesInOrder;
+    if ((!readCompiledSpecificationLine(file,line)) || (sscanf(line.c_str(),"order %u",&nofVariablesInOrder)!=1)) throw errorMessage.str();
+    std::vector<std::string> order;
+    for (unsigned int i=0;i<nofVariablesInOrder;i++) {
+        if (!readCompiledSpecificationLine(file,line)) throw errorMessage.str();
+        order.push_back(line);
+    }
+    applyVariableOrder((solverOptions.variableOrder.size()>0)?solverOptions.variableOrder:order);
+    if (solverOptions.groupVariables) groupVariables();
+
+    // BDDs
+    unsigned int nofSafetyEnvParts, nofSafetySysParts, nofLivenessAssumptions, nofLivenessGuarantees;
+    if ((!readCompiledSpecificationLine(file,line)) || (sscanf(line.c_str(),"bdds %u %u %u %u",&nofSafetyEnvParts,&nofSafetySysParts,&nofLivenessAssumptions,&nofLivenessGuarantees)!=4)) throw errorMessage.str();
+    std::vector<BF> varsByStoredIndex;
+    for (unsigned int i=0;i<nofVariables;i++) {
+        if ((unsigned int)storedIndices[i]>=varsByStoredIndex.size()) varsByStoredIndex.resize(storedIndices[i]+1,variables[i]);
+        varsByStoredIndex[storedIndices[i]] = variables[i];
+    }
+    // Check that the file is complete before reading the BDDs - DDDMP does not handle truncated files gracefully
+    long bddStart = ftell(file);
+    size_t trailerLength = strlen(compiledSpecificationTrailer);
+    std::vector<char> trailer(trailerLength);
+    if ((fseek(file,-(long)trailerLength,SEEK_END)!=0) || (fread(trailer.data(),1,trailerLength,file)!=trailerLength)
+            || (memcmp(trailer.data(),compiledSpecificationTrailer,trailerLength)!=0) || (fseek(file,bddStart,SEEK_SET)!=0)) {
+        throw errorMessage.str();
+    }
+
+    std::vector<BF> bdds;
+    try {
+        bdds = mgr.readBDDsFromFile(file,varsByStoredIndex);
+    } catch (const std::runtime_error &) {
+        throw errorMessage.str();
+    }
+    if (bdds.size()!=4+nofSafetyEnvParts+nofSafetySysParts+nofLivenessAssumptions+nofLivenessGuarantees) throw errorMessage.str();
+
+    auto it = bdds.begin();
+    initEnv = *(it++);
+    initSys = *(it++);
+    safetyEnv = *(it++);
+    safetySys = *(it++);
+    safetyEnvParts.assign(it,it+nofSafetyEnvParts);
+    it += nofSafetyEnvParts;
+    safetySysParts.assign(it,it+nofSafetySysParts);
+    it += nofSafetySysParts;
+    livenessAssumptions.assign(it,it+nofLivenessAssumptions);
+    it += nofLivenessAssumptions;
+    livenessGuarantees.assign(it,bdds.end());
+    return true;
+}
@@ -0,0 +1,89 @@
+//=====================================================================
+// Tests copying BDDs between two BF managers in which the same
+// variables have different indices (see "BFBdd::transferTo"). The
+// target manager gets an extra variable first and a different variable
+// order. Random BDDs are built in both managers in the same way, and
+// every BDD must be copied to its counterpart in the other manager and
+// back to itself. A BDD that depends on the extra variable must not be
+// copied back.
+//=====================================================================
+#include "BF.h"
+#include <iostream>
+#include <random>
+#include <stdexcept>
+
+//! Builds the same random BDD over the given variables for the same generator state
+BFBdd buildRandomBDD(BFBddManager &mgr, std::vector<BFBdd> const &vars, std::mt19937 &generator, unsigned int depth) {
+    if (depth==0) {
+        BFBdd var = vars[generator() % vars.size()];
+        return (generator()%2==0)?var:!var;
+    }
+    unsigned int operation = generator() % 3;
+    BFBdd left = buildRandomBDD(mgr,vars,generator,depth-1);
+    BFBdd right = buildRandomBDD(mgr,vars,generator,depth-1);
+    if (operation==0) return left & right;
+    if (operation==1) return left | right;
+    return left ^ right;
+}
+
+int main(int, const char **) {
+    const unsigned int nofVariables = 12;
+    BFBddManager source;
+    BFBddManager target;
+    BFBdd extraVariable = target.newVariable();
+    std::vector<BFBdd> sourceVars;
+    std::vector<BFBdd> targetVars;
+    for (unsigned int i=0;i<nofVariables;i++) {
+        sourceVars.push_back(source.newVariable());
+        targetVars.push_back(target.newVariable());
+    }
+
+    // Reverse the order of the variables in the target manager
+    std::vector<unsigned int> order;
+    for (unsigned int i=0;i<nofVariables;i++) order.push_back(targetVars[nofVariables-1-i].readNodeIndex());
+    order.push_back(extraVariable.readNodeIndex());
+    target.setVariableOrder(order);
+
+    std::vector<int> sourceToTarget(nofVariables,-1);
+    std::vector<int> targetToSource(nofVariables+1,-1);
+    for (unsigned int i=0;i<nofVariables;i++) {
+        sourceToTarget[sourceVars[i].readNodeIndex()] = targetVars[i].readNodeIndex();
+        targetToSource[targetVars[i].readNodeIndex()] = sourceVars[i].readNodeIndex();
+    }
+
+    try {
+        for (unsigned int test=0;test<100;test++) {
+            std::mt19937 sourceGenerator(test);
+            std::mt19937 targetGenerator(test);
+            BFBdd original = buildRandomBDD(source,sourceVars,sourceGenerator,test%8);
+            BFBdd counterpart = buildRandomBDD(target,targetVars,targetGenerator,test%8);
+            BFBdd copy = original.transferTo(target,sourceToTarget);
+            if (!(copy==counterpart)) {
+                std::cerr << "Error: BDD " << test << " has not been copied to its counterpart in the target manager.\n";
+                return 1;
+            }
+            if (!(copy.transferTo(source,targetToSource)==original)) {
+                std::cerr << "Error: BDD " << test << " has changed when copying it back from the target manager.\n";
+                return 1;
+            }
+        }
+    } catch (const std::runtime_error &e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    bool copiedBack = true;
+    try {
+        BFBdd dependent = targetVars[0] & extraVariable;
+        dependent.transferTo(source,targetToSource);
+    } catch (const std::runtime_error &) {
+        copiedBack = false;
+    }
+    if (copiedBack) {
+        std::cerr << "Error: A BDD that depends on a variable without counterpart has been copied.\n";
+        return 1;
+    }
+
+    std::cerr << "BDD transfer test passed.\n";
+    return 0;
+}
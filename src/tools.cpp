@@ -12,20 +12,26 @@
 /**
  * @brief A function that takes a BF "in" over the set of variables "var" and returns a new BF over the same variables
  *        that only represents one concrete variable valuation in "in" to the variables in "var"
+ *        Variables earlier in "vars" are set to false whenever possible.
  * @param in a BF to determinize
  * @param vars the care set of variables
  * @return the determinized BF
  */
-BF GR1Context::determinize(BF in, std::vector<BF> vars) {
-    for (auto it = vars.begin();it!=vars.end();it++) {
-        BF res = in & !(*it);
-        if (res.isFalse()) {
-            in = in & *it;
-        } else {
-            in = res;
-        }
-    }
-    return in;
+BF GR1Context::determinize(BF const &in, std::vector<BF> const &vars) {
+    std::vector<bool> valuation;
+    return in.pickMinterm(vars,NULL,valuation);
+}
+
+/**
+ * @brief Like the other "determinize" function, but also returns the chosen valuation, so that the caller does
+ *        not need to test the variables in the result one by one.
+ * @param in a BF to determinize
+ * @param vars the care set of variables
+ * @param valuation is filled with the values of the variables in "vars" in the determinized BF
+ * @return the determinized BF
+ */
+BF GR1Context::determinize(BF const &in, std::vector<BF> const &vars, std::vector<bool> &valuation) {
+    return in.pickMinterm(vars,NULL,valuation);
 }
 
 /**
@@ -34,27 +40,15 @@ BF GR1Context::determinize(BF in, std::vector<BF> vars) {
  *        This version tries to randomize everything!
  * @param in a BF to determinize
  * @param vars the care set of variables
+ * @param generator the random number generator that chooses the values of the variables
  * @return the determinized BF
  */
-BF GR1Context::determinizeRandomized(BF in, std::vector<BF> vars) {
-    for (auto it = vars.begin();it!=vars.end();it++) {
-        if (rand()%2) {
-            BF res = in & !(*it);
-            if (res.isFalse()) {
-                in = in & *it;
-            } else {
-                in = res;
-            }
-        } else {
-            BF res = in & (*it);
-            if (res.isFalse()) {
-                in = in & !(*it);
-            } else {
-                in = res;
-            }
-        }
+BF GR1Context::determinizeRandomized(BF const &in, std::vector<BF> const &vars, std::mt19937 &generator) {
+    std::bernoulli_distribution coin;
+    std::vector<bool> preferredValues(vars.size());
+    for (unsigned int i=0;i<vars.size();i++) {
+        preferredValues[i] = coin(generator);
     }
-    return in;
+    std::vector<bool> valuation;
+    return in.pickMinterm(vars,&preferredValues,valuation);
 }
-
-
@@ -37,6 +37,10 @@
 #include <map>
 #include <set>
 #include <string>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <random>
 
 // Before loading "variableTypes", we define some classes and macros that build a list of variable
 // types at the start of the program. These macros are then used in the "variableTypes.hpp" and thus
@@ -87,6 +91,7 @@ public:
 // be registered
 #include "variableTypes.hpp"
 #include "variableManager.hpp"
+#include "slugsException.hpp"
 
 // =================================================
 // Variable manager functions
@@ -119,6 +124,7 @@ int SlugsVariableManager::addVariable(VariableType type, std::string name) {
     variables.push_back(mgr.newVariable());
     variableNames.push_back(name);
     variableTypes.push_back(type);
+    variableNumbersByName.insert(std::make_pair(name,varNumber));
     return varNumber;
 }
 
@@ -146,14 +152,7 @@ void SlugsVariableManager::computeVariableInformation() {
 
     // Compute Variable Vectors
     for (auto it = varVectorsToConstruct.begin();it!=varVectorsToConstruct.end();it++) {
-        std::vector<BF> varsInThisVector;
-        for (auto it2 = it->second.begin();it2!=it->second.end();it2++) {
-            for (unsigned int i=0;i<variables.size();i++) {
-                if (variableTypesAll[i].count(*it2)>0) {
-                    varsInThisVector.push_back(variables[i]);
-                }
-            }
-        }
+        std::vector<BF> varsInThisVector = getVariablesOfTypes(it->second);
 
         // Debug check: No variable occurring twice?
 #ifndef NDEBUG
@@ -202,4 +201,225 @@ void SlugsVariableManager::computeVariableInformation() {
         *(it->first) = mgr.computeCube(varsInThisCube);
     }
 
+    // Register the standard mapping between the pre- and the post-variables (in the order of the
+    // pre- and post-variable vectors of the GR(1) context) for "primeToUnprime" and "unprimeToPrime".
+    // Contexts without the same number of pre- and post-variables cannot use these functions, so a map
+    // registered earlier is removed to make them fail instead of using the old map.
+    std::vector<BF> preVars = getVariablesOfTypes({PreInput,PreOutput});
+    std::vector<BF> postVars = getVariablesOfTypes({PostInput,PostOutput});
+    if (preVars.size()==postVars.size()) {
+        mgr.setVariableMap(mgr.computeVarVector(preVars),mgr.computeVarVector(postVars));
+    } else {
+        mgr.clearVariableMap();
+    }
+}
+
+/**
+ * @brief Gives another variable manager, which must not have any variables yet and will usually be used by
+ *        another thread, the same variables as this one. The variable vectors and cubes that have been registered
+ *        with the other variable manager (by the "SlugsVarVector" and "SlugsVarCube" objects of its context) are then
+ *        computed, so for a context of the same class they consist of the same variables as here. The other BF manager
+ *        also gets the same variable order and, if they are used here, the same variable groups. BFs can afterwards be
+ *        copied between the two BF managers with "transferTo" and the tables computed by "computeVariableCorrespondence".
+ * @param target the variable manager to add the variables to
+ */
+void SlugsVariableManager::cloneVariablesInto(SlugsVariableManager &target) const {
+    assert(target.variables.size()==0);
+    for (unsigned int i=0;i<variables.size();i++) {
+        target.addVariable(variableTypes[i],variableNames[i]);
+    }
+    target.computeVariableInformation();
+
+    std::vector<int> correspondence = computeVariableCorrespondence(target);
+    std::vector<unsigned int> order;
+    for (unsigned int index : mgr.getVariableOrder()) {
+        if ((index<correspondence.size()) && (correspondence[index]>=0)) order.push_back(correspondence[index]);
+    }
+    target.mgr.setVariableOrder(order);
+    if (variableGroupsInPlace) target.groupVariables();
+}
+
+/**
+ * @brief Computes the table needed to copy BFs from this variable manager to another one with "transferTo". The
+ *        variables of the two managers correspond to each other by their numbers, as after "cloneVariablesInto".
+ * @param target the variable manager to copy BFs to
+ * @return for every BF variable index of this manager the index of the corresponding variable in the other manager,
+ *         or -1 for BF variables that are not known to this variable manager or have no counterpart
+ */
+std::vector<int> SlugsVariableManager::computeVariableCorrespondence(SlugsVariableManager const &target) const {
+    std::vector<int> correspondence(mgr.getVariableOrder().size(),-1);
+    for (unsigned int i=0;(i<variables.size()) && (i<target.variables.size());i++) {
+        correspondence[variables[i].readNodeIndex()] = target.variables[i].readNodeIndex();
+    }
+    return correspondence;
+}
+
+/**
+ * @brief Collects the variables that have one of the given types (or a subtype of it), ordered by their types
+ *        first and their numbers second.
+ */
+std::vector<BF> SlugsVariableManager::getVariablesOfTypes(std::vector<int> const &types) const {
+    std::vector<BF> result;
+    for (auto it = types.begin();it!=types.end();it++) {
+        for (unsigned int i=0;i<variables.size();i++) {
+            if (variableTypesAll[i].count(*it)>0) {
+                result.push_back(variables[i]);
+            }
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Changes the order of the BF variables such that the variables named in "names" come first, in the given order.
+ *        Names that do not belong to any variable are ignored, and every variable that is not named is placed right
+ *        after the variable that has been added before it. Nothing is done if no variable has been added since the
+ *        last call, so the function can cheaply be called before building any BF.
+ * @param names the variable names, from the top-most level to the bottom-most level
+ */
+void SlugsVariableManager::applyVariableOrder(std::vector<std::string> const &names) {
+    if (variables.size()==nofVariablesInAppliedOrder) return;
+    nofVariablesInAppliedOrder = variables.size();
+
+    std::map<std::string,unsigned int> variableNumbers;
+    for (unsigned int i=0;i<variables.size();i++) variableNumbers[variableNames[i]] = i;
+
+    // Named variables first
+    std::vector<unsigned int> order;
+    std::vector<bool> placed(variables.size(),false);
+    for (auto it = names.begin();it!=names.end();it++) {
+        auto varIt = variableNumbers.find(*it);
+        if ((varIt!=variableNumbers.end()) && !placed[varIt->second]) {
+            order.push_back(varIt->second);
+            placed[varIt->second] = true;
+        }
+    }
+
+    // Then the others. Every run of consecutively declared variables that are not named follows the named variable
+    // declared right before the run (or comes first if there is none).
+    std::vector<std::vector<unsigned int> > followers(variables.size()+1);
+    unsigned int anchor = 0;
+    for (unsigned int i=0;i<variables.size();i++) {
+        if (placed[i]) {
+            anchor = i+1;
+        } else {
+            followers[anchor].push_back(i);
+        }
+    }
+
+    std::vector<unsigned int> indices;
+    for (auto it = followers[0].begin();it!=followers[0].end();it++) indices.push_back(variables[*it].readNodeIndex());
+    for (auto it = order.begin();it!=order.end();it++) {
+        indices.push_back(variables[*it].readNodeIndex());
+        std::vector<unsigned int> const &runAfter = followers[*it+1];
+        for (auto it2 = runAfter.begin();it2!=runAfter.end();it2++) indices.push_back(variables[*it2].readNodeIndex());
+    }
+    mgr.setVariableOrder(indices);
+    variableGroupsInPlace = false;
+}
+
+/**
+ * @brief Changes the order of the BF variables to a random one, as a starting point for dynamic reordering that
+ *        is different from the order in which the variables have been declared. Every variable stays next to its
+ *        primed copy, and the bits of an integer variable (whose names contain an '@') stay together, so only the
+ *        blocks of consecutively declared variables with the same name (up to the prime and the bit) are shuffled.
+ * @param seed the seed for the random number generator, so that the same seed leads to the same order
+ */
+void SlugsVariableManager::shuffleVariableOrder(unsigned int seed) {
+    std::vector<std::vector<std::string> > blocks;
+    std::string lastBlockName = "";
+    for (unsigned int i=0;i<variables.size();i++) {
+        std::string blockName = variableNames[i];
+        if ((blockName.size()>0) && (blockName.back()=='\'')) blockName.pop_back();
+        blockName = blockName.substr(0,blockName.find('@'));
+        if ((i==0) || (blockName!=lastBlockName)) blocks.push_back(std::vector<std::string>());
+        blocks.back().push_back(variableNames[i]);
+        lastBlockName = blockName;
+    }
+
+    std::mt19937 generator(seed);
+    std::shuffle(blocks.begin(),blocks.end(),generator);
+    std::vector<std::string> names;
+    for (auto it = blocks.begin();it!=blocks.end();it++) names.insert(names.end(),it->begin(),it->end());
+    nofVariablesInAppliedOrder = 0;
+    applyVariableOrder(names);
+}
+
+/**
+ * @brief Groups the BF variables such that dynamic reordering keeps them together. Every variable is grouped with
+ *        its primed copy, and the bits of an integer variable (whose names contain an '@') form a group around
+ *        these pairs. Groups whose variables are not at consecutive levels at the time of grouping are left out.
+ *        Nothing is done if no variable has been added and the variable order has not been applied since the last call.
+ */
+void SlugsVariableManager::groupVariables() {
+    if ((variables.size()==nofVariablesInGroups) && variableGroupsInPlace) return;
+
+    // Pairs of a variable and its primed copy
+    for (unsigned int i=std::max((size_t)1,nofVariablesInGroups);i<variables.size();i++) {
+        if (variableNames[i]==variableNames[i-1]+"'") {
+            variableGroups.push_back({i-1,i});
+        }
+    }
+
+    // Consecutively declared bits of the same integer variable
+    unsigned int i = nofVariablesInGroups;
+    while (i<variables.size()) {
+        unsigned int j = i+1;
+        size_t atPos = variableNames[i].find('@');
+        if (atPos!=std::string::npos) {
+            std::string prefix = variableNames[i].substr(0,atPos+1);
+            while ((j<variables.size()) && (variableNames[j].compare(0,prefix.size(),prefix)==0)) j++;
+            if (j-i>2) {
+                std::vector<unsigned int> group;
+                for (unsigned int k=i;k<j;k++) group.push_back(k);
+                variableGroups.push_back(group);
+            }
+        }
+        i = j;
+    }
+    nofVariablesInGroups = variables.size();
+
+    mgr.ungroupVariables();
+    for (auto it = variableGroups.begin();it!=variableGroups.end();it++) {
+        std::vector<BF> groupVars;
+        for (auto it2 = it->begin();it2!=it->end();it2++) groupVars.push_back(variables[*it2]);
+        mgr.groupVariables(groupVars);
+    }
+    variableGroupsInPlace = true;
+}
+
+/**
+ * @brief Computes the names of the variables in the current order of the BF variables
+ * @return the variable names, from the top-most level to the bottom-most level
+ */
+std::vector<std::string> SlugsVariableManager::getVariableOrder() const {
+    std::map<unsigned int,unsigned int> variableNumbers;
+    for (unsigned int i=0;i<variables.size();i++) variableNumbers[variables[i].readNodeIndex()] = i;
+    std::vector<std::string> names;
+    std::vector<unsigned int> order = mgr.getVariableOrder();
+    for (auto it = order.begin();it!=order.end();it++) {
+        auto varIt = variableNumbers.find(*it);
+        if (varIt!=variableNumbers.end()) names.push_back(variableNames[varIt->second]);
+    }
+    return names;
+}
+
+/**
+ * @brief Writes the names of the variables to a file (one per line), in the current order of the BF variables
+ * @param filename the name of the file
+ */
+void SlugsVariableManager::saveVariableOrder(std::string filename) const {
+    std::ofstream outFile(filename.c_str());
+    if (outFile.fail()) {
+        SlugsException e(false);
+        e << "Error: Could not open the variable order file '" << filename << "' for writing.";
+        throw e;
+    }
+    std::vector<std::string> names = getVariableOrder();
+    for (auto it = names.begin();it!=names.end();it++) outFile << *it << "\n";
+    if (outFile.fail()) {
+        SlugsException e(false);
+        e << "Error: Could not write the variable order file '" << filename << "'.";
+        throw e;
+    }
 }
@@ -40,6 +40,7 @@
 
 #include "bddDump.h"
 #include <map>
+#include <unordered_map>
 #include <vector>
 #include <utility>
 #include <boost/noncopyable.hpp>
@@ -56,10 +57,17 @@ protected:
     std::vector<BF> variables;
     std::vector<std::string> variableNames;
     std::vector<VariableType> variableTypes;
+    std::unordered_map<std::string,unsigned int> variableNumbersByName; //! Is updated when calling addVariable()
     std::vector<std::set<int> > variableTypesAll; //! Is computed when calling computeVariableInformation()
+    size_t nofVariablesInAppliedOrder = 0; //! Is updated when calling applyVariableOrder()
+    std::vector<std::vector<unsigned int> > variableGroups; //! Is updated when calling groupVariables()
+    size_t nofVariablesInGroups = 0; //! Is updated when calling groupVariables()
+    bool variableGroupsInPlace = false; //! Variable groups are removed by applyVariableOrder()
     //@}
 
 
+    std::vector<BF> getVariablesOfTypes(std::vector<int> const &types) const;
+
 public: // To be changed later
     std::map<BFVarVector*,std::vector<int> >  varVectorsToConstruct;
     std::map<BFVarCube*,std::set<int> >  varCubesToConstruct;
@@ -68,6 +76,14 @@ public: // To be changed later
 public:
 
     void computeVariableInformation();
+    void cloneVariablesInto(SlugsVariableManager &target) const;
+    std::vector<int> computeVariableCorrespondence(SlugsVariableManager const &target) const;
+    void applyVariableOrder(std::vector<std::string> const &names);
+    void shuffleVariableOrder(unsigned int seed);
+    std::vector<std::string> getVariableOrder() const;
+    long getPeakNofBDDNodes() const { return mgr.getPeakNofNodes(); }
+    void saveVariableOrder(std::string filename) const;
+    void groupVariables();
     bool doesVariableInheritType(int variableNumber, VariableType type) const {
         assert(variableTypesAll.size()>0); // computeVariableInformation must have been called already
         return variableTypesAll[variableNumber].count(type)>0;
@@ -88,13 +104,18 @@ public:
         return variableNames[number];
     }
     virtual unsigned int findVariableNumber(std::string nameString) const {
-        for (unsigned int i=0;i<variables.size();i++) {
-            if (nameString==variableNames[i]) return i;
-        }
-        assert(false);
-        return (unsigned int)(-1);
+        int number = lookupVariableNumber(nameString);
+        assert(number>=0);
+        return (unsigned int)number;
     }
     //@}
+
+    //! Returns the number of the first variable with the given name, or -1 if there is none
+    int lookupVariableNumber(std::string const &name) const {
+        auto it = variableNumbersByName.find(name);
+        if (it==variableNumbersByName.end()) return -1;
+        return it->second;
+    }
 };
 
 // Template class to simplify building variable vectors
@@ -0,0 +1,132 @@
+#!/usr/bin/env python3
+#
+# Converts the output of "slugs --explicitStrategy ...other options..." (in the text format or, with
+# "--jsonOutput", in the JSON format) to the binary strategy format that slugs writes with "--binaryStrategy".
+# The format is described in "src/binaryStrategy.hpp". The file is written in little-endian byte order.
+#
+# Usage: convertExplicitStrategyToBinary.py [--goals <number>] <inputFile> <outputFile>
+#
+# The number of goals of the specification is not part of the text and JSON formats. Unless it is given with
+# "--goals", the largest rank of a state plus one is used.
+import sys, json, struct
+
+MAGIC = b"SLUGSBST"
+VERSION = 1
+BYTE_ORDER_MARK = 0x01020304
+HEADER_FORMAT = "<8sIIIIII" + "Q"*10
+MASK64 = (1 << 64)-1
+
+def readTextStrategy(lines):
+    variables = None
+    states = []
+    for line in lines:
+        if line.startswith("State"):
+            assert line.count("<")==1
+            linePart1 = line[0:line.index("<")].split(" ")
+            assert int(linePart1[1])==len(states)
+            rank = int(linePart1[4])
+            linePart2 = line[line.index("<"):].strip()
+            assert linePart2[0]=="<" and linePart2[-1]==">"
+            linePart2 = [a.strip().split(":") for a in linePart2[1:-1].split(",") if a.strip()!=""]
+            theseVariables = [a[0] for a in linePart2]
+            if not variables is None:
+                assert variables == theseVariables
+            variables = theseVariables
+            states.append((rank,[a[1]=="1" for a in linePart2],[]))
+        elif line.strip().startswith("With successors :"):
+            successors = line.strip()[17:]
+            states[-1][2].extend([int(a) for a in successors.split(",") if a.strip()!=""])
+    return (variables if not variables is None else [],states)
+
+def readJSONStrategy(text):
+    data = json.loads(text)
+    nodes = data["nodes"]
+    states = []
+    for i in range(0,len(nodes)):
+        node = nodes[str(i)]
+        states.append((node["rank"],[a==1 for a in node["state"]],node["trans"]))
+    return (data["variables"],states)
+
+def computeHash(words,goal):
+    # FNV-1a, as in "computeBinaryStrategyHash"
+    hashValue = 14695981039346656037
+    for word in words:
+        hashValue = ((hashValue ^ word) * 1099511628211) & MASK64
+    return ((hashValue ^ goal) * 1099511628211) & MASK64
+
+def align(offset):
+    return (offset+7) & ~7
+
+def writeBinaryStrategy(outFile,variables,states,nofGoals):
+    nofWordsPerState = (len(variables)+63)//64
+    valuations = []
+    for (rank,values,successors) in states:
+        words = [0]*nofWordsPerState
+        for (i,value) in enumerate(values):
+            if value:
+                words[i//64] |= 1 << (i%64)
+        valuations.append(words)
+
+    successorOffsets = [0]
+    for (rank,values,successors) in states:
+        successorOffsets.append(successorOffsets[-1]+len(successors))
+
+    nofIndexSlots = 1
+    while nofIndexSlots<2*len(states):
+        nofIndexSlots *= 2
+    index = [0]*nofIndexSlots
+    for (state,(rank,values,successors)) in enumerate(states):
+        slot = computeHash(valuations[state],rank) & (nofIndexSlots-1)
+        while index[slot]!=0:
+            slot = (slot+1) & (nofIndexSlots-1)
+        index[slot] = state+1
+
+    names = b"".join([a.encode("utf-8")+b"\0" for a in variables])
+    nofTransitions = successorOffsets[-1]
+    headerSize = struct.calcsize(HEADER_FORMAT)
+    variableNamesOffset = headerSize
+    valuationsOffset = align(variableNamesOffset+len(names))
+    goalsOffset = valuationsOffset+8*nofWordsPerState*len(states)
+    successorOffsetsOffset = align(goalsOffset+4*len(states))
+    successorsOffset = successorOffsetsOffset+8*len(successorOffsets)
+    indexOffset = align(successorsOffset+4*nofTransitions)
+    fileSize = indexOffset+4*nofIndexSlots
+
+    parts = [
+        (0,struct.pack(HEADER_FORMAT,MAGIC,VERSION,BYTE_ORDER_MARK,len(variables),nofWordsPerState,nofGoals,0,
+            len(states),nofTransitions,nofIndexSlots,variableNamesOffset,valuationsOffset,goalsOffset,
+            successorOffsetsOffset,successorsOffset,indexOffset,fileSize)),
+        (variableNamesOffset,names),
+        (valuationsOffset,struct.pack("<"+str(nofWordsPerState*len(states))+"Q",*[w for words in valuations for w in words])),
+        (goalsOffset,struct.pack("<"+str(len(states))+"I",*[rank for (rank,values,successors) in states])),
+        (successorOffsetsOffset,struct.pack("<"+str(len(successorOffsets))+"Q",*successorOffsets)),
+        (successorsOffset,struct.pack("<"+str(nofTransitions)+"I",*[s for (rank,values,successors) in states for s in successors])),
+        (indexOffset,struct.pack("<"+str(nofIndexSlots)+"I",*index))]
+    position = 0
+    for (offset,data) in parts:
+        outFile.write(b"\0"*(offset-position))
+        outFile.write(data)
+        position = offset+len(data)
+    assert position==fileSize
+
+# Parse command line
+arguments = sys.argv[1:]
+nofGoals = None
+if len(arguments)>=2 and arguments[0]=="--goals":
+    nofGoals = int(arguments[1])
+    arguments = arguments[2:]
+if len(arguments)!=2:
+    print("Usage: convertExplicitStrategyToBinary.py [--goals <number>] <inputFile> <outputFile>",file=sys.stderr)
+    sys.exit(1)
+
+with open(arguments[0],"r") as inFile:
+    text = inFile.read()
+if text.lstrip().startswith("{"):
+    (variables,states) = readJSONStrategy(text)
+else:
+    (variables,states) = readTextStrategy(text.splitlines())
+if nofGoals is None:
+    nofGoals = max([rank for (rank,values,successors) in states]+[-1])+1
+
+with open(arguments[1],"wb") as outFile:
+    writeBinaryStrategy(outFile,variables,states,nofGoals)
@@ -0,0 +1,106 @@
+#!/usr/bin/env python3
+#
+# Measures how many BDD references and operations the lazily evaluated BDD expressions of the BF library
+# (see "src/BFAbstractionLibrary/BFCuddExpressions.h") save. Slugs is built twice in a copy of the "src"
+# directory with "-DBF_COUNT_OPERATIONS": once with "-DBF_EAGER_EXPRESSIONS" (before, i.e., every operator
+# computes its result right away) and once without it (after). Both builds are then run on the examples,
+# and the counts of the calls to Cudd_Ref made by BFBdd objects and of the BFBdd objects created for the
+# result of a CUDD call are reported.
+#
+# Usage: countBDDOperations.py [--buildDir <directory>] [--slugsOptions "<options>"] [<example> ...]
+#
+# The examples are given relative to the "examples" directory (by default, all "*.slugsin" files in it). The
+# builds are kept in the build directory (by default, a temporary directory that is deleted afterwards), so
+# that giving the same build directory again only recompiles what has changed.
+import os, sys, re, glob, shutil, subprocess, tempfile
+
+repositoryDir = os.path.abspath(os.path.join(os.path.dirname(os.path.abspath(__file__)),".."))
+variants = [("before","-DBF_COUNT_OPERATIONS -DBF_EAGER_EXPRESSIONS"),("after","-DBF_COUNT_OPERATIONS")]
+countsPattern = re.compile(r"^BF operation counts: (\d+) references, (\d+) operations$")
+
+
+def buildSlugs(buildDir,defines):
+    '''
+    Builds slugs with the given additional preprocessor definitions in a copy of the "src" directory in "buildDir",
+    next to a link to the "lib" directory of the repository. Returns the name of the slugs executable.
+    '''
+    srcDir = os.path.join(buildDir,"src")
+    if not os.path.exists(os.path.join(buildDir,"lib")):
+        os.makedirs(buildDir,exist_ok=True)
+        os.symlink(os.path.join(repositoryDir,"lib"),os.path.join(buildDir,"lib"))
+    for sourceFile in glob.glob(os.path.join(repositoryDir,"src","*"))+glob.glob(os.path.join(repositoryDir,"src","BFAbstractionLibrary","*")):
+        if os.path.splitext(sourceFile)[1] in [".cpp",".hpp",".h",".c"] or os.path.basename(sourceFile)=="Makefile":
+            targetFile = os.path.join(srcDir,os.path.relpath(sourceFile,os.path.join(repositoryDir,"src")))
+            os.makedirs(os.path.dirname(targetFile),exist_ok=True)
+            if not os.path.exists(targetFile) or open(sourceFile,"rb").read()!=open(targetFile,"rb").read():
+                shutil.copy2(sourceFile,targetFile)
+    subprocess.check_call(["make","-C",srcDir,"slugs","DEFINES=-DUSE_CUDD -DNDEBUG "+defines],stdout=subprocess.DEVNULL)
+    return os.path.join(srcDir,"slugs")
+
+
+def countOperations(slugs,options,specificationFile):
+    '''
+    Runs slugs on a specification and returns the numbers of references and operations that it reports.
+    '''
+    process = subprocess.run([slugs]+options+[specificationFile],stdout=subprocess.DEVNULL,stderr=subprocess.PIPE,universal_newlines=True)
+    if process.returncode!=0:
+        raise Exception("Slugs terminated with error code "+str(process.returncode)+" on "+specificationFile+":\n"+process.stderr)
+    for line in process.stderr.splitlines():
+        match = countsPattern.match(line)
+        if match:
+            return (int(match.group(1)),int(match.group(2)))
+    raise Exception("Slugs did not report the operation counts on "+specificationFile)
+
+
+def formatChange(before,after):
+    if before==0:
+        return "-"
+    return "%+.1f%%" % (100.0*(after-before)/before)
+
+
+#==========================================
+# Main entry point
+#==========================================
+buildDir = None
+slugsOptions = ["--explicitStrategy"]
+examples = []
+arguments = sys.argv[1:]
+while len(arguments)>0:
+    if arguments[0]=="--buildDir" and len(arguments)>1:
+        buildDir = os.path.abspath(arguments[1])
+        arguments = arguments[2:]
+    elif arguments[0]=="--slugsOptions" and len(arguments)>1:
+        slugsOptions = arguments[1].split()
+        arguments = arguments[2:]
+    elif arguments[0].startswith("-"):
+        print("Usage: countBDDOperations.py [--buildDir <directory>] [--slugsOptions \"<options>\"] [<example> ...]",file=sys.stderr)
+        sys.exit(1)
+    else:
+        examples.append(arguments[0])
+        arguments = arguments[1:]
+examplesDir = os.path.join(repositoryDir,"examples")
+if len(examples)==0:
+    examples = sorted([os.path.basename(a) for a in glob.glob(os.path.join(examplesDir,"*.slugsin"))])
+
+temporaryBuildDir = None
+if buildDir==None:
+    temporaryBuildDir = tempfile.mkdtemp()
+    buildDir = temporaryBuildDir
+try:
+    executables = {}
+    for (name,defines) in variants:
+        print("Building slugs ("+name+": "+defines+")...",file=sys.stderr)
+        executables[name] = buildSlugs(os.path.join(buildDir,name),defines)
+
+    print("%-55s %14s %14s %8s %14s %14s %8s" % ("Example","Refs before","Refs after","Change","Ops before","Ops after","Change"))
+    totals = {"before":(0,0),"after":(0,0)}
+    for example in examples:
+        counts = {}
+        for (name,defines) in variants:
+            counts[name] = countOperations(executables[name],slugsOptions,os.path.join(examplesDir,example))
+            totals[name] = (totals[name][0]+counts[name][0],totals[name][1]+counts[name][1])
+        print("%-55s %14d %14d %8s %14d %14d %8s" % (example,counts["before"][0],counts["after"][0],formatChange(counts["before"][0],counts["after"][0]),counts["before"][1],counts["after"][1],formatChange(counts["before"][1],counts["after"][1])))
+    print("%-55s %14d %14d %8s %14d %14d %8s" % ("Total",totals["before"][0],totals["after"][0],formatChange(totals["before"][0],totals["after"][0]),totals["before"][1],totals["after"][1],formatChange(totals["before"][1],totals["after"][1])))
+finally:
+    if temporaryBuildDir!=None:
+        shutil.rmtree(temporaryBuildDir)
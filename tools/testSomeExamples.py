@@ -3,11 +3,394 @@
 # Tests for some examples from the "example" directory if slugs
 # computes the expected realizability/unrealizability result.
 
-import os, sys, subprocess,tempfile
+import os, sys, subprocess,tempfile,shutil
 
 realizableBenchmarks = ["networks.slugsin","optimisticRecoveryTest.slugsin","semantics_diference.slugsin","simple_safety_example.slugsin","water_reservoir.structuredslugs","firefighting.slugsin","maximallyPermissiveTestPre.structuredslugs","maximallyPermissiveTest.structuredslugs"]
 unrealizableBenchmarks = ["baby_network.slugsin","example_outermost_fixed_point_unrealizability.slugsin"]
 
+# Pairs of parameters with which slugs must write the same output for all realizable benchmarks
+equivalentParameters = [("--explicitStrategy","--explicitStrategy --symbolicExtraction"),("--explicitStrategy --jsonOutput","--explicitStrategy --jsonOutput --symbolicExtraction"),("--explicitStrategy --simpleRecovery","--explicitStrategy --simpleRecovery --symbolicExtraction"),("--explicitStrategy","--explicitStrategy --partitionedTransitions"),("--explicitStrategy --fixedPointRecycling","--explicitStrategy --fixedPointRecycling --partitionedTransitions"),("--explicitStrategy","--explicitStrategy --threads 4"),("--explicitStrategy --fixedPointRecycling","--explicitStrategy --fixedPointRecycling --threads 4")]
+
+# Parameters with which slugs must report the same realizability result as without them for all benchmarks
+realizabilityPreservingParameters = ["--earlyExit","--chaining","--portfolio 4"]
+
+# Parameters with which the explicit strategies computed by slugs must be winning for all realizable benchmarks
+validatedStrategyParameters = ["--explicitStrategy","--explicitStrategy --chaining"]
+
+# Parameters of a solver portfolio, and the parameters of its member configurations. The explicit strategy computed by
+# the portfolio must be the same as the one computed by one of the members on their own for all realizable benchmarks.
+portfolioParameters = [("--explicitStrategy --portfolio 4",["--explicitStrategy","--explicitStrategy --fixedPointRecycling"]),("--explicitStrategy --portfolio 4 --threads 2",["--explicitStrategy","--explicitStrategy --fixedPointRecycling"])]
+
+# Structured specifications for which slugs must compute the same explicit strategy when reading them natively and
+# when reading their translation to slugsin by the translator script.
+structuredBenchmarks = ["water_reservoir.structuredslugs","maximallyPermissiveTestPre.structuredslugs","maximallyPermissiveTest.structuredslugs","specification_debugging_examples/error_resilience_exampleA.structuredslugs","specification_debugging_examples/error_resilience_exampleB.structuredslugs","specification_debugging_examples/section_3_2_errorneous_spec.structuredslugs","specification_debugging_examples/single_robot_scenario.structuredslugs"]
+
+# Safety guarantees that consist of a chain of prefix operators that is repeated many times, for testing that deeply
+# nested formulas can be parsed. Every entry consists of the chain and whether the specification is realizable.
+deeplyNestedFormulas = [("& y' ",True),("| x' ",True),("& x' ",False),("| x & y' ",True),("& x' | y ",False)]
+nofChainRepetitions = 300000
+
+
+def translateStructuredSpecification(translatorName,specificationFile):
+    '''
+    Translates a structured slugs specification to a temporary slugsin file with the given translator script.
+    Returns the name of the temporary file and None, or None and an error message if the translation failed.
+    '''
+    (handle,tempfilename) = tempfile.mkstemp()
+    outFile = os.fdopen(handle, "w")
+    translatorProcess = subprocess.Popen(translatorName+" "+specificationFile, shell=True, bufsize=1048000, stdout=subprocess.PIPE,stderr=subprocess.STDOUT)
+    allLines = []
+    for line in translatorProcess.stdout.readlines():
+        print >>outFile,line
+        allLines.append(line)
+    errorCode = translatorProcess.wait()
+    outFile.close()
+    if (errorCode!=0):
+        os.unlink(tempfilename)
+        errorMessage = "Translator script terminated with a non-zero error code: "+str(errorCode)+", the messages were:"
+        for line in allLines:
+            errorMessage = errorMessage + "\nM:" + line
+        return (None,errorMessage)
+    return (tempfilename,None)
+
+
+def runProgram(scriptName,parameter):
+    '''
+    Calls a program (such as slugs) with the given parameters. Returns the error code, the lines written to stdout, and the lines
+    written to stderr.
+    '''
+    slugsProcess = subprocess.Popen(scriptName+" "+parameter, shell=True, bufsize=1048000, stdout=subprocess.PIPE,stderr=subprocess.PIPE)
+    (output,errors) = slugsProcess.communicate()
+    return (slugsProcess.returncode,output.splitlines(),errors.splitlines())
+
+
+def compareOutputs(scriptName,parameterA,parameterB):
+    '''
+    Calls slugs with two different sets of parameters and compares what it writes to stdout.
+    Returns None if slugs terminated successfully both times and the outputs are the same, and an error message otherwise.
+    '''
+    outputs = []
+    for parameter in [parameterA,parameterB]:
+        (errorCode,output,errors) = runProgram(scriptName,parameter)
+        if errorCode!=0:
+            return "Slugs terminated with a non-zero error code "+str(errorCode)+" for the parameters '"+parameter+"':\n"+"\n".join(errors[-100:])
+        outputs.append(output)
+    for i in range(0,min(len(outputs[0]),len(outputs[1]))):
+        if outputs[0][i]!=outputs[1][i]:
+            return "The outputs differ in line "+str(i+1)+":\n"+outputs[0][i]+"\n"+outputs[1][i]
+    if len(outputs[0])!=len(outputs[1]):
+        return "The outputs have different lengths: "+str(len(outputs[0]))+" and "+str(len(outputs[1]))+" lines"
+    return None
+
+
+def checkCompiledSpecification(scriptName,specificationFile):
+    '''
+    Compiles a copy of a specification with "--compileSpec" to the file that slugs loads automatically for it (with
+    ".slugsin" replaced by ".slugsbin", or with ".slugsbin" appended), and then computes the explicit strategy from
+    the copy (so that the compiled specification is loaded automatically) and from the compiled specification itself.
+    Returns None if both strategies are the same as the one computed from the specification, and an error message otherwise.
+    '''
+    tempdir = tempfile.mkdtemp()
+    copiedFilename = tempdir+"/"+os.path.basename(specificationFile)
+    shutil.copy(specificationFile,copiedFilename)
+    if copiedFilename.endswith(".slugsin"):
+        compiledFilename = copiedFilename[0:len(copiedFilename)-8]+".slugsbin"
+    else:
+        compiledFilename = copiedFilename+".slugsbin"
+
+    (errorCode,output,errors) = runProgram(scriptName,"--compileSpec "+compiledFilename+" "+copiedFilename)
+    if errorCode!=0:
+        errorMessage = "Compiling the specification failed with error code "+str(errorCode)+":\n"+"\n".join(errors[-100:])
+    elif not os.path.exists(compiledFilename):
+        errorMessage = "Slugs did not write the compiled specification"
+    else:
+        errorMessage = compareOutputs(scriptName,"--explicitStrategy "+specificationFile,"--explicitStrategy "+copiedFilename)
+        if errorMessage==None:
+            errorMessage = compareOutputs(scriptName,"--explicitStrategy "+specificationFile,"--explicitStrategy "+compiledFilename)
+    shutil.rmtree(tempdir)
+    return errorMessage
+
+
+def checkBinaryStrategies(scriptName,readerName,converterName,specificationFile):
+    '''
+    Writes the explicit strategy for a specification as text, as a binary file with "--binaryStrategy", and as a
+    binary file converted from the text by the converter script. Both binary files are then read back with the
+    reader program, which prints them in the text format. Returns None if both are read back as the text,
+    and an error message otherwise.
+    '''
+    (errorCode,textStrategy,errors) = runProgram(scriptName,"--explicitStrategy "+specificationFile)
+    if errorCode!=0:
+        return "Slugs terminated with a non-zero error code "+str(errorCode)+":\n"+"\n".join(errors[-100:])
+    (handle,textFilename) = tempfile.mkstemp()
+    outFile = os.fdopen(handle, "w")
+    for line in textStrategy:
+        print >>outFile,line
+    outFile.close()
+    (handle,slugsBinaryFilename) = tempfile.mkstemp()
+    os.close(handle)
+    (handle,convertedBinaryFilename) = tempfile.mkstemp()
+    os.close(handle)
+
+    errorMessage = None
+    for (description,programName,parameter,binaryFilename) in [("slugs",scriptName,"--explicitStrategy --binaryStrategy "+specificationFile+" "+slugsBinaryFilename,slugsBinaryFilename),("The converter script",converterName,textFilename+" "+convertedBinaryFilename,convertedBinaryFilename)]:
+        (errorCode,output,errors) = runProgram(programName,parameter)
+        if errorCode!=0:
+            errorMessage = description+" terminated with a non-zero error code "+str(errorCode)+":\n"+"\n".join(errors[-100:])
+            break
+        (errorCode,readStrategy,errors) = runProgram(readerName,binaryFilename)
+        if errorCode!=0:
+            errorMessage = "Reading the binary strategy written by "+description+" failed:\n"+"\n".join(errors[-100:])
+            break
+        if readStrategy!=textStrategy:
+            errorMessage = "The binary strategy written by "+description+" differs from the text strategy"
+            break
+
+    for filename in [textFilename,slugsBinaryFilename,convertedBinaryFilename]:
+        os.unlink(filename)
+    return errorMessage
+
+
+def parseTextStrategy(lines):
+    '''
+    Reads an explicit strategy in the text format of "slugs --explicitStrategy".
+    Returns the list of the valuations of the states (as strings) and the list of their successor lists.
+    '''
+    valuations = []
+    successors = []
+    for line in lines:
+        if line.startswith("State "):
+            valuations.append(line[line.index("<"):])
+            successors.append([])
+        elif line.strip().startswith("With successors"):
+            successors[-1] = [int(a) for a in line.split(":")[1].split(",") if a.strip()!=""]
+    return (valuations,successors)
+
+
+def areBisimilar(strategyA,strategyB):
+    '''
+    Computes the coarsest bisimulation on the disjoint union of two strategies (as returned by "parseTextStrategy")
+    by partition refinement, where the states are labeled with their valuations. Returns True if every state of
+    each strategy is bisimilar to some state of the other strategy.
+    '''
+    (valuationsA,successorsA) = strategyA
+    (valuationsB,successorsB) = strategyB
+    offset = len(valuationsA)
+    valuations = valuationsA+valuationsB
+    successors = successorsA+[[a+offset for a in successorList] for successorList in successorsB]
+
+    # Start with one block per valuation, and split the blocks until the successors of all states in a block are
+    # in the same blocks
+    blockNumbers = {}
+    blocks = [blockNumbers.setdefault(valuation,len(blockNumbers)) for valuation in valuations]
+    nofBlocks = len(blockNumbers)
+    while True:
+        blockNumbers = {}
+        blocks = [blockNumbers.setdefault((blocks[i],frozenset([blocks[a] for a in successors[i]])),len(blockNumbers)) for i in range(0,len(valuations))]
+        if len(blockNumbers)==nofBlocks:
+            break
+        nofBlocks = len(blockNumbers)
+    return set(blocks[0:offset])==set(blocks[offset:])
+
+
+def parseSlugsinSpecification(lines):
+    '''
+    Reads a specification in the slugsin format. Returns a dictionary that maps the section names (such as
+    "INPUT" or "SYS_TRANS") to the lists of the non-empty lines in them, with comments removed.
+    '''
+    sections = {}
+    currentSection = None
+    for line in lines:
+        line = line.split("#")[0].strip()
+        if line=="":
+            continue
+        if line.startswith("[") and line.endswith("]"):
+            currentSection = line[1:-1]
+            sections.setdefault(currentSection,[])
+        elif currentSection!=None:
+            sections[currentSection].append(line)
+    return sections
+
+
+def parseSlugsinFormula(line):
+    '''
+    Parses a formula in the prefix notation of the slugsin format. Returns it as a tree of tuples, with the
+    operator first, in which variables are ("v",name) and memory buffers ("$",elements).
+    '''
+    tokens = line.split()
+    position = [0]
+    def parse():
+        token = tokens[position[0]]
+        position[0] += 1
+        if token in ["&","|","^"]:
+            return (token,parse(),parse())
+        if token=="!":
+            return ("!",parse())
+        if token in ["0","1"]:
+            return ("c",token=="1")
+        if token=="$":
+            nofElements = int(tokens[position[0]])
+            position[0] += 1
+            return ("$",[parse() for i in range(0,nofElements)])
+        if token=="?":
+            element = int(tokens[position[0]])
+            position[0] += 1
+            return ("?",element)
+        return ("v",token)
+    formula = parse()
+    assert position[0]==len(tokens)
+    return formula
+
+
+def evaluateSlugsinFormula(formula,valuation,memory=None):
+    '''
+    Evaluates a formula returned by "parseSlugsinFormula" for a valuation, which maps the variable names (with
+    a "'" for the next values) to truth values.
+    '''
+    operator = formula[0]
+    if operator=="&":
+        return evaluateSlugsinFormula(formula[1],valuation,memory) & evaluateSlugsinFormula(formula[2],valuation,memory)
+    if operator=="|":
+        return evaluateSlugsinFormula(formula[1],valuation,memory) | evaluateSlugsinFormula(formula[2],valuation,memory)
+    if operator=="^":
+        return evaluateSlugsinFormula(formula[1],valuation,memory) ^ evaluateSlugsinFormula(formula[2],valuation,memory)
+    if operator=="!":
+        return not evaluateSlugsinFormula(formula[1],valuation,memory)
+    if operator=="c":
+        return formula[1]
+    if operator=="v":
+        return valuation[formula[1]]
+    if operator=="?":
+        return memory[formula[1]]
+    newMemory = []
+    for element in formula[1]:
+        newMemory.append(evaluateSlugsinFormula(element,valuation,newMemory))
+    return newMemory[-1]
+
+
+def checkExplicitStrategy(specificationLines,strategyLines):
+    '''
+    Checks if an explicit strategy (in the text format of "slugs --explicitStrategy") is winning for a specification
+    in the slugsin format. The strategy must have an initial state for every initial input valuation allowed by the
+    environment, and contain, for every state, a successor for every next input valuation allowed by the environment.
+    All transitions must satisfy the safety assumptions and guarantees. Finally, for every liveness guarantee, there
+    must not be a cycle that never satisfies it but satisfies all liveness assumptions. Returns None if the
+    strategy is winning, and an error message otherwise.
+    '''
+    specification = parseSlugsinSpecification(specificationLines)
+    inputs = specification.get("INPUT",[])
+    formulas = {}
+    for section in ["ENV_INIT","SYS_INIT","ENV_TRANS","SYS_TRANS","ENV_LIVENESS","SYS_LIVENESS"]:
+        formulas[section] = [parseSlugsinFormula(line) for line in specification.get(section,[])]
+    def holds(section,valuation):
+        for formula in formulas[section]:
+            if not evaluateSlugsinFormula(formula,valuation):
+                return False
+        return True
+
+    # Read the strategy
+    valuations = []
+    successors = []
+    for line in strategyLines:
+        if line.startswith("State "):
+            valuation = {}
+            for part in line[line.index("<")+1:line.rindex(">")].split(","):
+                (name,value) = part.strip().split(":")
+                valuation[name] = (value=="1")
+            valuations.append(valuation)
+            successors.append([])
+        elif line.strip().startswith("With successors"):
+            successors[-1] = [int(a) for a in line.split(":")[1].split(",") if a.strip()!=""]
+    def transitionValuation(state,successor):
+        valuation = dict(valuations[state])
+        for (name,value) in valuations[successor].items():
+            valuation[name+"'"] = value
+        return valuation
+    allInputValuations = [dict([(inputs[i],((bits >> i) & 1)==1) for i in range(0,len(inputs))]) for bits in range(0,1 << len(inputs))]
+
+    # Initial states
+    for inputValuation in allInputValuations:
+        if holds("ENV_INIT",inputValuation):
+            found = False
+            for valuation in valuations:
+                if all([valuation[a]==inputValuation[a] for a in inputs]) and holds("ENV_INIT",valuation) and holds("SYS_INIT",valuation):
+                    found = True
+            if not found:
+                return "There is no initial state for the input valuation "+str(inputValuation)
+
+    # Safety
+    for state in range(0,len(valuations)):
+        for successor in successors[state]:
+            if not holds("ENV_TRANS",transitionValuation(state,successor)):
+                return "The transition from state "+str(state)+" to state "+str(successor)+" violates the safety assumptions"
+            if not holds("SYS_TRANS",transitionValuation(state,successor)):
+                return "The transition from state "+str(state)+" to state "+str(successor)+" violates the safety guarantees"
+        for inputValuation in allInputValuations:
+            valuation = dict(valuations[state])
+            for (name,value) in inputValuation.items():
+                valuation[name+"'"] = value
+            if holds("ENV_TRANS",valuation) and not any([all([valuations[a][name]==inputValuation[name] for name in inputs]) for a in successors[state]]):
+                return "State "+str(state)+" has no successor for the next input valuation "+str(inputValuation)
+
+    # Liveness - for every guarantee, look for a strongly connected component of the transitions that do not satisfy
+    # it in which every liveness assumption is satisfied by some transition
+    for guarantee in formulas["SYS_LIVENESS"]:
+        edges = [[a for a in successors[state] if not evaluateSlugsinFormula(guarantee,transitionValuation(state,a))] for state in range(0,len(valuations))]
+        components = computeStronglyConnectedComponents(edges)
+        for component in set(components):
+            transitionsInComponent = [(state,a) for state in range(0,len(valuations)) for a in edges[state] if components[state]==component and components[a]==component]
+            if len(transitionsInComponent)>0 and all([any([evaluateSlugsinFormula(assumption,transitionValuation(state,a)) for (state,a) in transitionsInComponent]) for assumption in formulas["ENV_LIVENESS"]]):
+                return "The states "+str(sorted(set([state for (state,a) in transitionsInComponent])))+" form a cycle that satisfies the liveness assumptions, but not the liveness guarantee "+str(formulas["SYS_LIVENESS"].index(guarantee))
+    return None
+
+
+def computeStronglyConnectedComponents(edges):
+    '''
+    Computes the strongly connected components of a graph, given as the list of the successor lists of its nodes,
+    with Tarjan's algorithm (without recursion). Returns the number of the component for every node.
+    '''
+    nofNodes = len(edges)
+    index = [None]*nofNodes
+    lowLink = [0]*nofNodes
+    onStack = [False]*nofNodes
+    components = [None]*nofNodes
+    stack = []
+    nextIndex = 0
+    nofComponents = 0
+    for root in range(0,nofNodes):
+        if index[root]!=None:
+            continue
+        callStack = [(root,0)]
+        index[root] = lowLink[root] = nextIndex
+        nextIndex += 1
+        stack.append(root)
+        onStack[root] = True
+        while len(callStack)>0:
+            (node,nextEdge) = callStack[-1]
+            if nextEdge<len(edges[node]):
+                callStack[-1] = (node,nextEdge+1)
+                successor = edges[node][nextEdge]
+                if index[successor]==None:
+                    index[successor] = lowLink[successor] = nextIndex
+                    nextIndex += 1
+                    stack.append(successor)
+                    onStack[successor] = True
+                    callStack.append((successor,0))
+                elif onStack[successor]:
+                    lowLink[node] = min(lowLink[node],index[successor])
+            else:
+                callStack.pop()
+                if len(callStack)>0:
+                    lowLink[callStack[-1][0]] = min(lowLink[callStack[-1][0]],lowLink[node])
+                if lowLink[node]==index[node]:
+                    while True:
+                        member = stack.pop()
+                        onStack[member] = False
+                        components[member] = nofComponents
+                        if member==node:
+                            break
+                    nofComponents += 1
+    return components
+
 
 def checkRealizability(scriptName,translatorName,parameter):
     '''
@@ -19,20 +402,8 @@ def checkRealizability(scriptName,translatorName,parameter):
     # Call translator script
     deleteFileName = None
     if parameter.endswith(".structuredslugs"):
-        (handle,tempfilename) = tempfile.mkstemp()
-        outFile = os.fdopen(handle, "w")
-        translatorProcess = subprocess.Popen(translatorName+" "+parameter.split(" ")[-1], shell=True, bufsize=1048000, stdout=subprocess.PIPE,stderr=subprocess.STDOUT)
-        allLines = []
-        for line in translatorProcess.stdout.readlines():
-            print >>outFile,line
-            allLines.append(line)
-        errorCode = translatorProcess.wait()
-        outFile.close()
-        if (errorCode!=0):
-            os.unlink(tempfilename)
-            errorMessage = "Translator script terminated with a non-zero error code: "+str(errorCode)+", the messages were:"
-            for line in allLines:
-                errorMessage = errorMessage + "\nM:" + line
+        (tempfilename,errorMessage) = translateStructuredSpecification(translatorName,parameter.split(" ")[-1])
+        if tempfilename==None:
             return errorMessage
         parameter = parameter.split(" ")
         parameter = parameter[0:len(parameter)-1]
@@ -75,6 +446,39 @@ def checkRealizability(scriptName,translatorName,parameter):
         raise Exception("Internal error. Should not be able to happen.")
 
 
+def writeDeeplyNestedSpecification(chain):
+    '''
+    Writes a specification with the input "x", the output "y" and a safety guarantee in which the given chain of
+    prefix operators is repeated "nofChainRepetitions" times before the final "y'". Returns the name of the file.
+    '''
+    (handle,tempfilename) = tempfile.mkstemp(suffix=".slugsin")
+    outFile = os.fdopen(handle, "w")
+    print >>outFile, "[INPUT]\nx\n\n[OUTPUT]\ny\n\n[SYS_TRANS]"
+    print >>outFile, chain*nofChainRepetitions+"y'"
+    outFile.close()
+    return tempfilename
+
+
+def reportWrongRealizabilityResult(benchmark,realizable,isRealizable):
+    '''
+    Prints that the given benchmark has been found to be realizable/unrealizable (or that some error
+    occurred) although the expected result is different, and terminates the script.
+    '''
+    print >>sys.stderr, "Error: Benchmark ",benchmark," was found to be ",
+    if realizable==True:
+        print >>sys.stderr, "realizable",
+    elif realizable==False:
+        print >>sys.stderr, "unrealizable",
+    else:
+        print >>sys.stderr, "unknown (",realizable,")",
+    print >>sys.stderr, "but it should be",
+    if isRealizable:
+        print >>sys.stderr, "realizable"
+    else:
+        print >>sys.stderr, "unrealizable"
+    sys.exit(1)
+
+
 #==========================================
 # Main entry point
 #==========================================
@@ -89,6 +493,16 @@ if exampleDir==None:
     sys.exit(1)
 slugsDir = exampleDir+"/../src/slugs"
 translatorScriptDir = exampleDir+"/../tools/StructuredSlugsParser/compiler.py"
+binaryStrategyReaderDir = exampleDir+"/../src/binaryStrategyToText"
+binaryStrategyConverterDir = exampleDir+"/../tools/convertExplicitStrategyToBinary.py"
+bddTransferTestDir = exampleDir+"/../src/testBFTransfer"
+
+# Copying BDDs between BF managers in which the variables have different indices
+print >>sys.stderr, "Processing: BDD transfer test"
+(errorCode,output,errors) = runProgram(bddTransferTestDir,"")
+if errorCode!=0:
+    print >>sys.stderr, "Error: The BDD transfer test terminated with a non-zero error code",errorCode,":\n"+"\n".join(errors[-100:])
+    sys.exit(1)
 
 
 for (isRealizable,benchmarks) in [(False,unrealizableBenchmarks),(True,realizableBenchmarks)]:
@@ -97,18 +511,118 @@ for (isRealizable,benchmarks) in [(False,unrealizableBenchmarks),(True,realizabl
         print >>sys.stderr, "Processing:",benchmark
         realizable = checkRealizability(slugsDir,translatorScriptDir,benchmarkDir)
         if realizable!=isRealizable:
-            print >>sys.stderr, "Error: Benchmark ",benchmark," was found to be ",
-            if realizable==True:
-                print >>sys.stderr, "realizable",
-            elif realizable==False:
-                print >>sys.stderr, "unrealizable",
-            else:
-                print >>sys.stderr, "unknown (",realizable,")",
-            print >>sys.stderr, "but it should be",
-            if isRealizable:
-                print >>sys.stderr, "realizable"
-            else:
-                print >>sys.stderr, "unrealizable"
+            reportWrongRealizabilityResult(benchmark,realizable,isRealizable)
+
+# Parameters that must lead to the same realizability result
+for parameter in realizabilityPreservingParameters:
+    for (isRealizable,benchmarks) in [(False,unrealizableBenchmarks),(True,realizableBenchmarks)]:
+        for benchmark in benchmarks:
+            print >>sys.stderr, "Processing ("+parameter+"):",benchmark
+            realizable = checkRealizability(slugsDir,translatorScriptDir,parameter+" "+exampleDir+"/"+benchmark)
+            if realizable!=isRealizable:
+                reportWrongRealizabilityResult(benchmark+" (with '"+parameter+"')",realizable,isRealizable)
+
+# Deeply nested formulas
+for (chain,isRealizable) in deeplyNestedFormulas:
+    benchmark = "safety guarantee with "+str(nofChainRepetitions)+" times '"+chain.strip()+"'"
+    print >>sys.stderr, "Processing:",benchmark
+    specificationFile = writeDeeplyNestedSpecification(chain)
+    realizable = checkRealizability(slugsDir,translatorScriptDir,specificationFile)
+    os.unlink(specificationFile)
+    if realizable!=isRealizable:
+        reportWrongRealizabilityResult(benchmark,realizable,isRealizable)
+
+# Parameters that must lead to the same output
+for (parameterA,parameterB) in equivalentParameters:
+    for benchmark in realizableBenchmarks:
+        print >>sys.stderr, "Processing ("+parameterA+" vs. "+parameterB+"):",benchmark
+        errorMessage = compareOutputs(slugsDir,parameterA+" "+exampleDir+"/"+benchmark,parameterB+" "+exampleDir+"/"+benchmark)
+        if errorMessage!=None:
+            print >>sys.stderr, "Error: Benchmark",benchmark,"-",errorMessage
+            sys.exit(1)
+
+# Explicit strategies that must be winning. Structured specifications are checked against their translation.
+for parameter in validatedStrategyParameters:
+    for benchmark in realizableBenchmarks:
+        print >>sys.stderr, "Processing (strategy check for '"+parameter+"'):",benchmark
+        specificationFile = exampleDir+"/"+benchmark
+        if benchmark.endswith(".structuredslugs"):
+            (specificationFile,errorMessage) = translateStructuredSpecification(translatorScriptDir,specificationFile)
+            if specificationFile==None:
+                print >>sys.stderr, "Error:",errorMessage
+                sys.exit(1)
+        with open(specificationFile) as inFile:
+            specificationLines = inFile.readlines()
+        if specificationFile!=exampleDir+"/"+benchmark:
+            os.unlink(specificationFile)
+        (errorCode,output,errors) = runProgram(slugsDir,parameter+" "+exampleDir+"/"+benchmark)
+        if errorCode!=0:
+            print >>sys.stderr, "Error: Benchmark",benchmark,"- Slugs terminated with a non-zero error code",errorCode,"for the parameters '"+parameter+"':\n"+"\n".join(errors[-100:])
+            sys.exit(1)
+        errorMessage = checkExplicitStrategy(specificationLines,output)
+        if errorMessage!=None:
+            print >>sys.stderr, "Error: Benchmark",benchmark,"- The strategy computed with the parameters '"+parameter+"' is not winning:",errorMessage
+            sys.exit(1)
+
+# Compiled specifications
+for benchmark in realizableBenchmarks:
+    print >>sys.stderr, "Processing (compiled specification):",benchmark
+    errorMessage = checkCompiledSpecification(slugsDir,exampleDir+"/"+benchmark)
+    if errorMessage!=None:
+        print >>sys.stderr, "Error: Benchmark",benchmark,"-",errorMessage
+        sys.exit(1)
+
+# Solver portfolios
+for (parameter,memberParameters) in portfolioParameters:
+    for benchmark in realizableBenchmarks:
+        print >>sys.stderr, "Processing ("+parameter+"):",benchmark
+        outputs = []
+        for runParameter in [parameter]+memberParameters:
+            (errorCode,output,errors) = runProgram(slugsDir,runParameter+" "+exampleDir+"/"+benchmark)
+            if errorCode!=0:
+                print >>sys.stderr, "Error: Benchmark",benchmark,"- Slugs terminated with a non-zero error code",errorCode,"for the parameters '"+runParameter+"':\n"+"\n".join(errors[-100:])
+                sys.exit(1)
+            outputs.append(output)
+        if not outputs[0] in outputs[1:]:
+            print >>sys.stderr, "Error: Benchmark",benchmark,"- The strategy computed with the parameters '"+parameter+"' differs from the strategies of the members of the portfolio."
+            sys.exit(1)
+
+# Binary strategies written by slugs and by the converter script
+for benchmark in realizableBenchmarks:
+    print >>sys.stderr, "Processing (binary strategies):",benchmark
+    errorMessage = checkBinaryStrategies(slugsDir,binaryStrategyReaderDir,binaryStrategyConverterDir,exampleDir+"/"+benchmark)
+    if errorMessage!=None:
+        print >>sys.stderr, "Error: Benchmark",benchmark,"-",errorMessage
+        sys.exit(1)
+
+# Minimized strategies
+for benchmark in realizableBenchmarks:
+    print >>sys.stderr, "Processing (strategy minimization):",benchmark
+    strategies = []
+    for parameter in ["--explicitStrategy","--explicitStrategy --minimizeStrategy"]:
+        (errorCode,output,errors) = runProgram(slugsDir,parameter+" "+exampleDir+"/"+benchmark)
+        if errorCode!=0:
+            print >>sys.stderr, "Error: Benchmark",benchmark,"- Slugs terminated with a non-zero error code",errorCode,"for the parameters '"+parameter+"':\n"+"\n".join(errors[-100:])
             sys.exit(1)
-                
+        strategies.append(parseTextStrategy(output))
+    if len(strategies[1][0])>len(strategies[0][0]):
+        print >>sys.stderr, "Error: Benchmark",benchmark,"- The minimized strategy has more states than the original one."
+        sys.exit(1)
+    if not areBisimilar(strategies[0],strategies[1]):
+        print >>sys.stderr, "Error: Benchmark",benchmark,"- The minimized strategy is not bisimilar to the original one."
+        sys.exit(1)
+
+# Structured specifications read natively and translated by the translator script
+for benchmark in structuredBenchmarks:
+    print >>sys.stderr, "Processing (native reading vs. translation):",benchmark
+    (tempfilename,errorMessage) = translateStructuredSpecification(translatorScriptDir,exampleDir+"/"+benchmark)
+    if tempfilename==None:
+        print >>sys.stderr, "Error:",errorMessage
+        sys.exit(1)
+    errorMessage = compareOutputs(slugsDir,"--explicitStrategy "+exampleDir+"/"+benchmark,"--explicitStrategy "+tempfilename)
+    os.unlink(tempfilename)
+    if errorMessage!=None:
+        print >>sys.stderr, "Error: Benchmark",benchmark,"-",errorMessage
+        sys.exit(1)
+
 print >>sys.stderr, "Done!"